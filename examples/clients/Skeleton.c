@@ -36,6 +36,7 @@
 
 #define NAME_BUFFER_SIZE 10000
 #define MAX_CALLBACKS_TO_REPORT 10
+#define MAX_SNAPSHOT_STATES 64
 
 static int numCallbacks = 0;
 
@@ -161,6 +162,20 @@ void mySkeletonCallback(void *userdata, const OSVR_TimeValue *timestamp,
                osvrQuatGetW(&boneState.pose.rotation));
     }
 
+    /* All joint and bone states of this report at once */
+    {
+        OSVR_SkeletonJointState joints[MAX_SNAPSHOT_STATES];
+        OSVR_SkeletonBoneState bones[MAX_SNAPSHOT_STATES];
+        OSVR_SkeletonJointCount numJointStates = 0;
+        OSVR_SkeletonBoneCount numBoneStates = 0;
+        rc = osvrClientGetSkeletonSnapshot(
+            skel, joints, MAX_SNAPSHOT_STATES, &numJointStates, bones,
+            MAX_SNAPSHOT_STATES, &numBoneStates);
+        printf("\tsnapshot: %s, %d joint states, %d bone states\n",
+               rc == OSVR_RETURN_SUCCESS ? "succeeded" : "failed",
+               numJointStates, numBoneStates);
+    }
+
     OSVR_SkeletonJointCount leftWristJointId = 0;
     rc = osvrClientGetSkeletonJointId(skel, "l_wrist", &leftWristJointId);
     printf("\tasking for 'l_wrist' joint id by name: %s, jointId = %d\n",
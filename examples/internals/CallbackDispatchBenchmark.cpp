@@ -0,0 +1,106 @@
+/** @file
+    @brief Implementation of a microbenchmark for client callback dispatch.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/InterfaceCallbacks.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+/// Callback that does a trivial amount of work, so the measurement is
+/// dominated by dispatch.
+static void analogCallback(void *userdata, const OSVR_TimeValue *,
+                           const OSVR_AnalogReport *report) {
+    *static_cast<double *>(userdata) += report->state;
+}
+
+/// The previous storage scheme: each C callback wrapped in a std::function.
+class StdFunctionCallbacks {
+  public:
+    void addCallback(OSVR_AnalogCallback cb, void *userdata) {
+        m_callbacks.push_back([cb, userdata](const OSVR_TimeValue *timestamp,
+                                             const OSVR_AnalogReport *report) {
+            cb(userdata, timestamp, report);
+        });
+    }
+    void triggerCallbacks(OSVR_TimeValue const &timestamp,
+                          OSVR_AnalogReport const &report) const {
+        for (auto const &f : m_callbacks) {
+            f(&timestamp, &report);
+        }
+    }
+
+  private:
+    std::vector<std::function<void(const OSVR_TimeValue *,
+                                    const OSVR_AnalogReport *)>>
+        m_callbacks;
+};
+
+template <typename Callbacks>
+static double timeDispatch(Callbacks const &callbacks, std::size_t reports) {
+    OSVR_TimeValue timestamp = {0, 0};
+    OSVR_AnalogReport report = {0, 1.0};
+    typedef std::chrono::high_resolution_clock clock;
+    auto begin = clock::now();
+    for (std::size_t i = 0; i < reports; ++i) {
+        callbacks.triggerCallbacks(timestamp, report);
+    }
+    auto end = clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() /
+           reports;
+}
+
+int main() {
+    static const std::size_t REPORTS = 1000000;
+    static const std::size_t CALLBACK_COUNTS[] = {1, 4, 16};
+
+    std::cout << "Nanoseconds per report dispatched to N analog callbacks, "
+              << "averaged over " << REPORTS << " reports\n";
+    std::cout << "N\tstd::function\tInterfaceCallbacks\n";
+    for (auto numCallbacks : CALLBACK_COUNTS) {
+        std::vector<double> sums(numCallbacks, 0.);
+        StdFunctionCallbacks baseline;
+        osvr::common::InterfaceCallbacks flat;
+        for (auto &sum : sums) {
+            baseline.addCallback(&analogCallback, &sum);
+            flat.addCallback(&analogCallback, &sum);
+        }
+        // Warm up both before timing.
+        timeDispatch(baseline, REPORTS / 10);
+        timeDispatch(flat, REPORTS / 10);
+        auto baselineTime = timeDispatch(baseline, REPORTS);
+        auto flatTime = timeDispatch(flat, REPORTS);
+        std::cout << numCallbacks << "\t" << baselineTime << "\t\t" << flatTime
+                  << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+/** @file
+    @brief Implementation of a benchmark of the latency each analysis filter
+    stage adds, with reports passed over VRPN versus the in-process report
+    bus.
+
+    Each stage receives a pose, converts it as the client-side tracker handler
+    would, and sends it on to the next stage, all synchronously, so the time
+    per report divided by the number of stages is the per-stage latency.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportBus.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using osvr::common::InProcessReportChannel;
+using osvr::util::time::TimeValue;
+
+typedef std::chrono::high_resolution_clock clock_type;
+
+/// @brief A chain of filter stages connected through VRPN, as analysis
+/// plugins are now: stage i listens to tracker i and re-sends on tracker
+/// i + 1.
+class VrpnChain {
+  public:
+    VrpnChain(vrpn_ConnectionPtr const &conn, std::size_t stages) {
+        for (std::size_t i = 0; i <= stages; ++i) {
+            auto name = "VrpnStage" + std::to_string(i);
+            m_servers.emplace_back(
+                new vrpn_Tracker_Server(name.c_str(), conn.get()));
+        }
+        for (std::size_t i = 0; i < stages; ++i) {
+            auto name = "VrpnStage" + std::to_string(i);
+            m_remotes.emplace_back(
+                new vrpn_Tracker_Remote(name.c_str(), conn.get()));
+            m_stages.emplace_back(new Stage{this, i + 1});
+            m_remotes.back()->register_change_handler(m_stages.back().get(),
+                                                      &VrpnChain::handle);
+        }
+    }
+
+    void send(OSVR_PoseState const &pose) {
+        q_vec_type pos;
+        q_type quat;
+        osvrVec3ToQuatlib(pos, &(pose.translation));
+        osvrQuatToQuatlib(quat, &(pose.rotation));
+        struct timeval now;
+        vrpn_gettimeofday(&now, nullptr);
+        m_servers.front()->report_pose(0, now, pos, quat);
+    }
+
+    std::size_t delivered() const { return m_delivered; }
+
+  private:
+    struct Stage {
+        VrpnChain *chain;
+        std::size_t next;
+    };
+
+    static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+        auto &stage = *static_cast<Stage *>(userdata);
+        // What the client-side tracker handler does on receipt...
+        OSVR_PoseState pose;
+        TimeValue timestamp;
+        osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+        osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+        osvrVec3FromQuatlib(&(pose.translation), info.pos);
+        // ...and the server-side tracker does on sending.
+        q_vec_type pos;
+        q_type quat;
+        osvrVec3ToQuatlib(pos, &(pose.translation));
+        osvrQuatToQuatlib(quat, &(pose.rotation));
+        stage.chain->m_servers[stage.next]->report_pose(
+            info.sensor, info.msg_time, pos, quat);
+        if (stage.next + 1 == stage.chain->m_servers.size()) {
+            stage.chain->m_delivered++;
+        }
+    }
+
+    std::vector<std::unique_ptr<vrpn_Tracker_Server> > m_servers;
+    std::vector<std::unique_ptr<vrpn_Tracker_Remote> > m_remotes;
+    std::vector<std::unique_ptr<Stage> > m_stages;
+    std::size_t m_delivered = 0;
+};
+
+/// @brief The same chain over in-process report channels.
+///
+/// Optionally also sends each stage's output over VRPN (to no local
+/// listener), as the server's tracker objects still do for out-of-process
+/// clients.
+class BusChain {
+  public:
+    BusChain(vrpn_ConnectionPtr const &conn, std::size_t stages,
+             bool alsoSendVrpn) {
+        for (std::size_t i = 0; i <= stages; ++i) {
+            m_channels.emplace_back(new InProcessReportChannel);
+            if (alsoSendVrpn) {
+                auto name = "BusStage" + std::to_string(i);
+                m_servers.emplace_back(
+                    new vrpn_Tracker_Server(name.c_str(), conn.get()));
+            }
+        }
+        for (std::size_t i = 0; i < stages; ++i) {
+            m_stages.emplace_back(new Stage{this, i + 1});
+            m_channels[i]->subscribe<OSVR_PoseState>(&BusChain::handle,
+                                                     m_stages.back().get());
+        }
+    }
+
+    void send(OSVR_PoseState const &pose) {
+        TimeValue now;
+        osvrTimeValueGetNow(&now);
+        m_publish(0, pose, 0, now);
+    }
+
+    std::size_t delivered() const { return m_delivered; }
+
+  private:
+    struct Stage {
+        BusChain *chain;
+        std::size_t next;
+    };
+
+    void m_publish(std::size_t i, OSVR_PoseState const &pose,
+                   OSVR_ChannelCount sensor, TimeValue const &timestamp) {
+        if (!m_servers.empty()) {
+            q_vec_type pos;
+            q_type quat;
+            osvrVec3ToQuatlib(pos, &(pose.translation));
+            osvrQuatToQuatlib(quat, &(pose.rotation));
+            struct timeval tv;
+            osvrTimeValueToStructTimeval(&tv, &timestamp);
+            m_servers[i]->report_pose(sensor, tv, pos, quat);
+        }
+        if (m_channels[i]->hasSubscribers<OSVR_PoseState>()) {
+            m_channels[i]->publish(pose, sensor, timestamp);
+        }
+    }
+
+    static void handle(void *userdata, OSVR_PoseState const &pose,
+                       OSVR_ChannelCount sensor, TimeValue const &timestamp) {
+        auto &stage = *static_cast<Stage *>(userdata);
+        stage.chain->m_publish(stage.next, pose, sensor, timestamp);
+        if (stage.next + 1 == stage.chain->m_channels.size()) {
+            stage.chain->m_delivered++;
+        }
+    }
+
+    std::vector<std::unique_ptr<InProcessReportChannel> > m_channels;
+    std::vector<std::unique_ptr<vrpn_Tracker_Server> > m_servers;
+    std::vector<std::unique_ptr<Stage> > m_stages;
+    std::size_t m_delivered = 0;
+};
+
+/// @returns nanoseconds per stage per report.
+template <typename Chain>
+static double timeChain(Chain &chain, std::size_t stages,
+                        std::size_t reports) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    auto before = chain.delivered();
+    auto begin = clock_type::now();
+    for (std::size_t i = 0; i < reports; ++i) {
+        pose.translation.data[0] = double(i);
+        chain.send(pose);
+    }
+    auto end = clock_type::now();
+    if (chain.delivered() - before != reports) {
+        std::cerr << "Warning: only " << (chain.delivered() - before)
+                  << " of " << reports
+                  << " reports made it through synchronously!\n";
+    }
+    return std::chrono::duration<double, std::nano>(end - begin).count() /
+           reports / stages;
+}
+
+int main() {
+    static const std::size_t REPORTS = 100000;
+    static const std::size_t STAGE_COUNTS[] = {1, 2, 4};
+
+    auto conn = vrpn_ConnectionPtr::create_server_connection("loopback:");
+
+    std::cout << "Nanoseconds of latency added per filter stage, averaged "
+                 "over "
+              << REPORTS << " reports\n";
+    std::cout << "Stages\tVRPN\t\tBus\t\tBus+VRPN send\n";
+    for (auto stages : STAGE_COUNTS) {
+        VrpnChain vrpnChain(conn, stages);
+        BusChain busChain(conn, stages, false);
+        BusChain deployedChain(conn, stages, true);
+        // Warm up before timing.
+        timeChain(vrpnChain, stages, REPORTS / 10);
+        timeChain(busChain, stages, REPORTS / 10);
+        timeChain(deployedChain, stages, REPORTS / 10);
+        auto vrpnTime = timeChain(vrpnChain, stages, REPORTS);
+        auto busTime = timeChain(busChain, stages, REPORTS);
+        auto deployedTime = timeChain(deployedChain, stages, REPORTS);
+        std::cout << stages << "\t" << vrpnTime << "\t\t" << busTime
+                  << "\t\t" << deployedTime << "\n";
+    }
+    return 0;
+}
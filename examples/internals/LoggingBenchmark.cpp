@@ -0,0 +1,100 @@
+/** @file
+    @brief Implementation of a benchmark of log calls per second from multiple
+    threads.
+
+    Log output goes to the console (stderr) as usual: redirect it (for
+    instance, `LoggingBenchmark 2>/dev/null`) so the terminal's speed isn't
+    what gets measured. Set OSVR_LOG_ASYNC=0 to compare against writing
+    synchronously from each logging thread.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/Log.h>
+#include <osvr/Util/LogRegistry.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using osvr::util::log::LogLevel;
+using osvr::util::log::LoggerPtr;
+
+/// @brief Runs the given number of threads, each making the given number of
+/// log calls at the given level, and returns total calls per second.
+static double timeLogging(LoggerPtr const &logger, LogLevel level,
+                          std::size_t numThreads, std::size_t callsPerThread) {
+    typedef std::chrono::high_resolution_clock clock;
+    std::vector<std::thread> threads;
+    auto begin = clock::now();
+    for (std::size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < callsPerThread; ++i) {
+                logger->log(level) << "Thread " << t << " message " << i
+                                   << ", value " << 1.5 * i;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto end = clock::now();
+    return numThreads * callsPerThread /
+           std::chrono::duration<double>(end - begin).count();
+}
+
+int main() {
+    static const std::size_t CALLS_PER_THREAD = 100000;
+    static const std::size_t THREAD_COUNTS[] = {1, 2, 4, 8};
+
+    auto logger = osvr::util::log::make_logger("LoggingBenchmark");
+    logger->setLogLevel(LogLevel::info);
+    auto &registry = osvr::util::log::LogRegistry::instance();
+
+    std::cout << "Log calls per second from N threads, " << CALLS_PER_THREAD
+              << " calls per thread ("
+              << (registry.isAsync() ? "asynchronous" : "synchronous")
+              << " logging)\n";
+    std::cout << "N\tfiltered out\twritten\t\tdropped\n";
+    for (auto numThreads : THREAD_COUNTS) {
+        auto filtered = timeLogging(logger, LogLevel::debug, numThreads,
+                                    CALLS_PER_THREAD);
+        auto droppedBefore = registry.getAsyncQueueStats().dropped;
+        auto written = timeLogging(logger, LogLevel::info, numThreads,
+                                   CALLS_PER_THREAD);
+        osvr::util::log::flush();
+        auto dropped = registry.getAsyncQueueStats().dropped - droppedBefore;
+        std::cout << numThreads << "\t" << filtered << "\t" << written
+                  << "\t" << dropped << "\n";
+    }
+    auto stats = registry.getAsyncQueueStats();
+    std::cout << "Queue high water mark: " << stats.highWaterMark << " of "
+              << stats.capacity << "\n";
+    return 0;
+}
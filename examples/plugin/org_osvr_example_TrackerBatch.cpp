@@ -0,0 +1,133 @@
+/** @date 2016
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginKit/TrackerInterfaceC.h>
+
+// Generated JSON header file
+#include "org_osvr_example_TrackerBatch_json.h"
+
+// Library/third-party includes
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+// Anonymous namespace to avoid symbol collision
+namespace {
+
+/// Must match the tracker count in the JSON descriptor.
+const OSVR_ChannelCount SENSOR_COUNT = 4;
+
+/// A tracker with several sensors sampled together, which reports all of
+/// their poses at once with osvrDeviceTrackerSendPoseBatch() instead of one
+/// osvrDeviceTrackerSendPoseTimestamped() call per sensor.
+///
+/// Note that clients older than the batch API don't receive batched poses:
+/// a plugin that must support them should keep sending per-sensor reports.
+class TrackerBatchDevice {
+  public:
+    TrackerBatchDevice(OSVR_PluginRegContext ctx) {
+        /// Create the initialization options
+        OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
+
+        // configure our tracker
+        osvrDeviceTrackerConfigure(opts, &m_tracker);
+
+        /// Create the device token with the options
+        m_dev.initAsync(ctx, "TrackerBatch", opts);
+
+        /// Send JSON descriptor
+        m_dev.sendJsonDescriptor(org_osvr_example_TrackerBatch_json);
+
+        /// Register update callback
+        m_dev.registerUpdateCallback(this);
+    }
+
+    OSVR_ReturnCode update() {
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+            5)); // Simulate waiting for data.
+
+        /// All sensors are sampled at the same time.
+        OSVR_TimeValue now;
+        osvrTimeValueGetNow(&now);
+        double t = 5.0 * ((double)now.seconds +
+                          ((double)now.microseconds / 1000000.0));
+
+        /// Sensors circle around the origin, each a quarter turn apart.
+        OSVR_TrackerPoseBatchEntry entries[SENSOR_COUNT];
+        for (OSVR_ChannelCount sensor = 0; sensor < SENSOR_COUNT; ++sensor) {
+            double phase = t + sensor * 1.5707963;
+            OSVR_TrackerPoseBatchEntry &entry = entries[sensor];
+            entry.sensor = sensor;
+            osvrPose3SetIdentity(&entry.pose);
+            entry.pose.translation.data[0] = std::cos(phase) * 0.25;
+            entry.pose.translation.data[1] = std::sin(phase) * 0.25;
+            entry.timestamp = now;
+        }
+
+        /// One call, and one message, for all the sensors.
+        osvrDeviceTrackerSendPoseBatch(m_dev, m_tracker, entries,
+                                       SENSOR_COUNT);
+
+        return OSVR_RETURN_SUCCESS;
+    }
+
+  private:
+    osvr::pluginkit::DeviceToken m_dev;
+    OSVR_TrackerDeviceInterface m_tracker;
+};
+
+class HardwareDetection {
+  public:
+    HardwareDetection() : m_found(false) {}
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
+
+        if (m_found) {
+            return OSVR_RETURN_SUCCESS;
+        }
+
+        /// we always detect device in sample plugin
+        m_found = true;
+
+        /// Create our device object
+        osvr::pluginkit::registerObjectForDeletion(ctx,
+                                                   new TrackerBatchDevice(ctx));
+
+        return OSVR_RETURN_SUCCESS;
+    }
+
+  private:
+    bool m_found;
+};
+} // namespace
+
+OSVR_PLUGIN(org_osvr_example_TrackerBatch) {
+
+    osvr::pluginkit::PluginContext context(ctx);
+
+    /// Register a detection callback function object.
+    context.registerHardwareDetectCallback(new HardwareDetection());
+
+    return OSVR_RETURN_SUCCESS;
+}
@@ -29,16 +29,18 @@
 #include <osvr/Client/Export.h>
 #include <osvr/Common/ClientInterfacePtr.h>
 #include <osvr/Common/PathTreeObserverPtr.h>
+#include <osvr/Common/ResolveTreeNode.h>
 #include <osvr/Util/Logger.h>
 #include <osvr/Common/PathTree_fwd.h>
 #include <osvr/Common/ClientContext_fwd.h>
 #include <osvr/Client/InterfaceTree.h>
 
 // Library/third-party includes
-// - none
+#include <json/value.h>
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
@@ -95,6 +97,11 @@ namespace client {
         /// or more interface objects but no remote handler.
         void m_connectNeededCallbacks();
 
+        /// @brief After the path tree was changed in place, re-resolve every
+        /// path with a handler, replacing only those handlers whose source
+        /// actually changed, then try to connect any still-unconnected paths.
+        void m_reconnectChangedCallbacks();
+
         /// @brief Access the client context's logger.
         util::log::LoggerPtr const &logger() const;
 
@@ -102,6 +109,14 @@ namespace client {
         /// remote handlers.
         InterfaceTree m_interfaces;
 
+        /// @brief For each path with a handler, a summary of the source it
+        /// was resolved to when the handler was created.
+        std::unordered_map<std::string, Json::Value> m_resolvedSources;
+
+        /// @brief Memoized path resolution, invalidated whenever the path
+        /// tree changes.
+        common::TreeResolutionCache m_resolutionCache;
+
         /// @brief Reference to the main path tree object, retrieved from the
         /// common::PathTreeOwner passed into constructor.
         common::PathTree &m_pathTree;
@@ -57,6 +57,12 @@ struct OSVR_SkeletonObject {
     getBoneState(OSVR_SkeletonBoneCount boneId) const;
     OSVR_CLIENT_EXPORT OSVR_SkeletonBoneCount getNumBones() const;
     OSVR_CLIENT_EXPORT OSVR_SkeletonJointCount getNumJoints() const;
+    OSVR_CLIENT_EXPORT bool getSnapshot(OSVR_SkeletonJointState *joints,
+                                        OSVR_SkeletonJointCount jointCapacity,
+                                        OSVR_SkeletonJointCount *numJoints,
+                                        OSVR_SkeletonBoneState *bones,
+                                        OSVR_SkeletonBoneCount boneCapacity,
+                                        OSVR_SkeletonBoneCount *numBones) const;
     OSVR_CLIENT_EXPORT std::string
     getBoneName(OSVR_SkeletonBoneCount boneId) const;
     OSVR_CLIENT_EXPORT std::string
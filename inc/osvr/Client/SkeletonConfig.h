@@ -45,6 +45,7 @@
 // - none
 
 // Standard includes
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -55,7 +56,98 @@ namespace client {
 
     typedef std::vector<std::pair<util::StringID, InternalInterfaceOwner>>
         InterfaceMap;
-    typedef std::vector<std::pair<util::StringID, OSVR_Pose3>> PoseMap;
+
+    inline void setStateId(OSVR_SkeletonJointState &state,
+                           OSVR_SkeletonJointCount id) {
+        state.jointId = id;
+    }
+    inline void setStateId(OSVR_SkeletonBoneState &state,
+                           OSVR_SkeletonBoneCount id) {
+        state.boneId = id;
+    }
+
+    /// @brief The poses of the joints (or bones) of a skeleton, as of the
+    /// latest skeleton report, stored contiguously in articulation tree
+    /// order.
+    ///
+    /// The table from id to position is built when the articulation tree is
+    /// parsed, so looking a pose up doesn't search, and copying them all out
+    /// is a single pass.
+    template <typename StateType, typename IdType> class SkeletonStateTable {
+      public:
+        /// @brief Sets up the table for the given interfaces, ids ranging
+        /// below numIds. Forgets all poses.
+        void reset(InterfaceMap const &ifaces, IdType numIds) {
+            m_states.clear();
+            m_hasPose.assign(ifaces.size(), false);
+            m_indices.assign(numIds, NO_INDEX);
+            m_numPoses = 0;
+            for (auto const &iface : ifaces) {
+                util::StringID stringId = iface.first;
+                auto id = static_cast<IdType>(stringId.value());
+                StateType state;
+                setStateId(state, id);
+                osvrPose3SetIdentity(&state.pose);
+                if (id >= m_indices.size()) {
+                    m_indices.resize(id + 1, NO_INDEX);
+                }
+                m_indices[id] = m_states.size();
+                m_states.push_back(state);
+            }
+        }
+
+        /// @brief Gets the current pose of each interface, all at once.
+        void update(InterfaceMap &ifaces) {
+            m_numPoses = 0;
+            for (std::size_t i = 0; i < m_states.size(); ++i) {
+                OSVR_TimeValue timestamp;
+                m_hasPose[i] = ifaces[i].second->getState<OSVR_PoseReport>(
+                    timestamp, m_states[i].pose);
+                if (m_hasPose[i]) {
+                    ++m_numPoses;
+                }
+            }
+        }
+
+        /// @returns nullptr if no pose for that id in the latest update.
+        StateType const *find(IdType id) const {
+            if (id >= m_indices.size() || m_indices[id] == NO_INDEX ||
+                !m_hasPose[m_indices[id]]) {
+                return nullptr;
+            }
+            return &m_states[m_indices[id]];
+        }
+
+        /// @brief Number of ids with a pose in the latest update.
+        IdType getNumPoses() const { return m_numPoses; }
+
+        /// @brief Copies the states with a pose in the latest update to
+        /// dest, which must have room for getNumPoses() of them.
+        void copyTo(StateType *dest) const {
+            for (std::size_t i = 0; i < m_states.size(); ++i) {
+                if (m_hasPose[i]) {
+                    *dest++ = m_states[i];
+                }
+            }
+        }
+
+      private:
+        static const std::size_t NO_INDEX = std::size_t(-1);
+        std::vector<StateType> m_states;
+        std::vector<bool> m_hasPose;
+        /// @brief Position in m_states by id.
+        std::vector<std::size_t> m_indices;
+        IdType m_numPoses = 0;
+    };
+
+    template <typename StateType, typename IdType>
+    const std::size_t SkeletonStateTable<StateType, IdType>::NO_INDEX;
+
+    typedef SkeletonStateTable<OSVR_SkeletonJointState,
+                               OSVR_SkeletonJointCount>
+        SkeletonJointTable;
+    typedef SkeletonStateTable<OSVR_SkeletonBoneState, OSVR_SkeletonBoneCount>
+        SkeletonBoneTable;
 
     struct NoCtxYet : std::runtime_error {
         NoCtxYet()
@@ -102,6 +194,20 @@ namespace client {
 
         OSVR_SkeletonBoneCount getNumBones() const;
         OSVR_SkeletonJointCount getNumJoints() const;
+
+        /// @brief Copies the states of all joints and bones with a pose in
+        /// the latest skeleton report to the given arrays.
+        ///
+        /// @param[out] numJoints number of joint states copied, or needed if
+        /// jointCapacity is too small.
+        /// @param[out] numBones likewise, for bones.
+        /// @returns false, copying nothing, if either array is too small.
+        bool getSnapshot(OSVR_SkeletonJointState *joints,
+                         OSVR_SkeletonJointCount jointCapacity,
+                         OSVR_SkeletonJointCount *numJoints,
+                         OSVR_SkeletonBoneState *bones,
+                         OSVR_SkeletonBoneCount boneCapacity,
+                         OSVR_SkeletonBoneCount *numBones) const;
         void
         updateArticulationTree(osvr::common::PathTree const &articulationTree);
         /* @brief Go thru the joint and bone interfaces and set the poses
@@ -114,14 +220,19 @@ namespace client {
         /// @brief check if the articulation tree has been updated, then we need
         /// to traverse the articulation tree again, and update values
         bool isSkeletonTreeUpdated() const;
+        /// @brief Walks the articulation tree, registering joints and bones,
+        /// then rebuilds the tables derived from them.
+        void m_parseArticulationTree();
         OSVR_ClientContext m_ctx;
         osvr::common::PathTree m_articulationTree;
         osvr::common::RegisteredStringMap m_jointMap;
         osvr::common::RegisteredStringMap m_boneMap;
         InterfaceMap m_jointInterfaces;
         InterfaceMap m_boneInterfaces;
-        PoseMap m_jointPoses;
-        PoseMap m_bonePoses;
+        SkeletonJointTable m_jointStates;
+        SkeletonBoneTable m_boneStates;
+        OSVR_SkeletonJointCount m_numJoints = 0;
+        OSVR_SkeletonBoneCount m_numBones = 0;
     };
 
     inline bool
@@ -169,11 +280,11 @@ namespace client {
             return false;
         }
         *boneId = 0;
-        if (boneIndex >= m_boneMap.getEntries().size()) {
+        if (boneIndex >= m_numBones) {
             return false;
         }
 
-        auto boneName = m_boneMap.getEntries().at(boneIndex);
+        auto boneName = m_boneMap.getStringFromId(util::StringID(boneIndex));
 
         auto ret = getBoneId(boneName.c_str(), boneId);
 
@@ -197,40 +308,52 @@ namespace client {
     inline OSVR_Pose3
     SkeletonConfig::getJointState(OSVR_SkeletonJointCount jointId) const {
 
-        // find an interface for given jointId
-        for (auto val : m_jointPoses) {
-            if (val.first.value() == jointId) {
-                // return the joint state
-                return val.second;
-            }
+        auto state = m_jointStates.find(jointId);
+        if (!state) {
+            // pose not available for this frame
+            throw NoPoseYet();
         }
-        // pose not available for this frame
-        throw NoPoseYet();
+        return state->pose;
     }
 
     inline OSVR_Pose3
     SkeletonConfig::getBoneState(OSVR_SkeletonBoneCount boneId) const {
         /// @todo should be returning derived pose
 
-        // find an interface for given boneId
-        for (auto val : m_bonePoses) {
-            if (val.first.value() == boneId) {
-                // return the bone state
-                return val.second;
-            }
+        auto state = m_boneStates.find(boneId);
+        if (!state) {
+            // pose not available for this frame
+            throw NoPoseYet();
+        }
+        return state->pose;
+    }
+
+    inline bool SkeletonConfig::getSnapshot(
+        OSVR_SkeletonJointState *joints, OSVR_SkeletonJointCount jointCapacity,
+        OSVR_SkeletonJointCount *numJoints, OSVR_SkeletonBoneState *bones,
+        OSVR_SkeletonBoneCount boneCapacity,
+        OSVR_SkeletonBoneCount *numBones) const {
+        if (numJoints == nullptr || numBones == nullptr) {
+            return false;
+        }
+        *numJoints = m_jointStates.getNumPoses();
+        *numBones = m_boneStates.getNumPoses();
+        if (*numJoints > jointCapacity || *numBones > boneCapacity ||
+            (*numJoints > 0 && joints == nullptr) ||
+            (*numBones > 0 && bones == nullptr)) {
+            return false;
         }
-        // pose not available for this frame
-        throw NoPoseYet();
+        m_jointStates.copyTo(joints);
+        m_boneStates.copyTo(bones);
+        return true;
     }
 
     inline OSVR_SkeletonBoneCount SkeletonConfig::getNumBones() const {
-        return static_cast<OSVR_SkeletonBoneCount>(
-            m_boneMap.getEntries().size());
+        return m_numBones;
     }
 
     inline OSVR_SkeletonJointCount SkeletonConfig::getNumJoints() const {
-        return static_cast<OSVR_SkeletonJointCount>(
-            m_jointMap.getEntries().size());
+        return m_numJoints;
     }
 
     inline std::string
@@ -32,6 +32,8 @@
 #include <osvr/Client/ViewerEye.h>
 #include <osvr/Client/InternalInterfaceOwner.h>
 #include <osvr/Util/ContainerWrapper.h>
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 // - none
@@ -60,6 +62,14 @@ namespace client {
         OSVR_CLIENT_EXPORT OSVR_Pose3 getPose() const;
         OSVR_CLIENT_EXPORT bool hasPose() const;
 
+        /// @brief Gets the pose of the viewer, predicted (from its most recent
+        /// pose and velocity) to the given time, such as when the frame
+        /// being rendered will be displayed.
+        /// @sa osvr::common::getPoseAtTime()
+        /// @throws NoPoseYet
+        OSVR_CLIENT_EXPORT Eigen::Isometry3d
+        getPoseIsometryAtTime(util::time::TimeValue const &when) const;
+
       private:
         friend class DisplayConfigFactory;
         Viewer(OSVR_ClientContext ctx, const char path[]);
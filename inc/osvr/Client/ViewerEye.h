@@ -69,7 +69,8 @@ namespace client {
               m_rot180(other.m_rot180), m_pitchTilt(other.m_pitchTilt),
               m_radDistortParams(std::move(other.m_radDistortParams)),
               m_displayInputIdx(other.m_displayInputIdx),
-              m_opticalAxisOffsetY(other.m_opticalAxisOffsetY) {}
+              m_opticalAxisOffsetY(other.m_opticalAxisOffsetY),
+              m_eyeRotation(other.m_eyeRotation) {}
 
         inline OSVR_SurfaceCount size() const { return 1; }
 #if 0
@@ -89,6 +90,16 @@ namespace client {
 
         OSVR_CLIENT_EXPORT Eigen::Matrix4d getView() const;
 
+        /// @brief Gets the room-space pose of this eye given a pose of its
+        /// viewer, rather than querying the viewer pose itself.
+        OSVR_CLIENT_EXPORT Eigen::Isometry3d
+        getPoseIsometry(Eigen::Isometry3d const &viewerPose) const;
+
+        /// @brief Gets the view matrix of this eye given a pose of its
+        /// viewer, rather than querying the viewer pose itself.
+        OSVR_CLIENT_EXPORT Eigen::Matrix4d
+        getView(Eigen::Isometry3d const &viewerPose) const;
+
         bool wantDistortion() const {
             return m_radDistortParams.is_initialized();
         }
@@ -145,6 +156,9 @@ namespace client {
         boost::optional<OSVR_RadialDistortionParameters> m_radDistortParams;
         OSVR_DisplayInputCount m_displayInputIdx;
         util::Angle m_opticalAxisOffsetY;
+        /// @brief Rotation of the eye relative to the viewer, from the
+        /// optical axis offset: computed once at construction.
+        Eigen::Matrix3d m_eyeRotation;
     };
 
 } // namespace client
@@ -518,6 +518,38 @@ namespace clientkit {
 
         /// @}
 
+        /// @brief Attempt to get the view and projection matrices of every
+        /// eye in one call, from viewer poses predicted to the given display
+        /// time (or the latest poses if displayTime is NULL).
+        ///
+        /// @return false if there was an error in the input parameters or if
+        /// no pose is yet available.
+        /// @sa osvrClientGetDisplayEyeMatricesAtTimed()
+        bool getEyeMatricesAtTime(const OSVR_TimeValue *displayTime,
+                                  double near, double far,
+                                  OSVR_MatrixConventions flags,
+                                  OSVR_EyeCount numEyes, double *viewMatrices,
+                                  double *projectionMatrices) const {
+            ensureValid();
+            OSVR_ReturnCode ret = osvrClientGetDisplayEyeMatricesAtTimed(
+                m_disp, displayTime, near, far, flags, numEyes, viewMatrices,
+                projectionMatrices);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
+        /// @overload
+        bool getEyeMatricesAtTime(const OSVR_TimeValue *displayTime,
+                                  float near, float far,
+                                  OSVR_MatrixConventions flags,
+                                  OSVR_EyeCount numEyes, float *viewMatrices,
+                                  float *projectionMatrices) const {
+            ensureValid();
+            OSVR_ReturnCode ret = osvrClientGetDisplayEyeMatricesAtTimef(
+                m_disp, displayTime, near, far, flags, numEyes, viewMatrices,
+                projectionMatrices);
+            return (ret == OSVR_RETURN_SUCCESS);
+        }
+
         /// @name Iteration methods
         /// @{
         template <typename F>
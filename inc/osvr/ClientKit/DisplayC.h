@@ -39,6 +39,7 @@
 #include <osvr/Util/Pose3C.h>
 #include <osvr/Util/BoolC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/TimeValueC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -266,6 +267,52 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
     OSVR_MatrixConventions flags, float *mat);
 
+/** @brief Get the view and projection matrices for every eye of every viewer
+    in a display config in a single call - matrices of **doubles**.
+
+    Each viewer's pose is read just once and predicted forward from its most
+    recent pose and velocity to the time the frame will be displayed (see
+    osvrGetPoseStateAtTime()), so all eyes see a consistent pose with less
+    motion-to-photon latency than separate per-eye queries.
+
+    Eyes are ordered by viewer, then by eye within the viewer. Projection
+    matrices are for surface 0 of each eye.
+
+    Will only succeed if osvrClientCheckDisplayStartup() succeeds.
+
+    @param disp Display config object
+    @param displayTime Time the frame is expected to be displayed, or NULL to
+    use the most recent poses without prediction.
+    @param near Distance to near clipping plane - must be positive.
+    @param far Distance to far clipping plane - must be positive and not
+    equal to near.
+    @param flags Bitwise OR of matrix convention flags (see @ref MatrixFlags)
+    @param numEyes Number of eyes the output arrays have room for: must be at
+    least the total number of eyes of all viewers.
+    @param[out] viewMatrices Pass a double[numEyes * ::OSVR_MATRIX_SIZE] to
+    get the transformation matrices from room space to eye space.
+    @param[out] projectionMatrices Pass a double[numEyes * ::OSVR_MATRIX_SIZE]
+    to get the projection matrices, or NULL if they are not needed.
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose
+    was yet available for some viewer, in which case the output arguments are
+    unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetDisplayEyeMatricesAtTimed(
+    OSVR_DisplayConfig disp, const OSVR_TimeValue *displayTime, double near,
+    double far, OSVR_MatrixConventions flags, OSVR_EyeCount numEyes,
+    double *viewMatrices, double *projectionMatrices);
+
+/** @brief Get the view and projection matrices for every eye of every viewer
+    in a display config in a single call - matrices of **floats**.
+
+    @sa osvrClientGetDisplayEyeMatricesAtTimed() for details.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetDisplayEyeMatricesAtTimef(
+    OSVR_DisplayConfig disp, const OSVR_TimeValue *displayTime, float near,
+    float far, OSVR_MatrixConventions flags, OSVR_EyeCount numEyes,
+    float *viewMatrices, float *projectionMatrices);
+
 /** @brief Each eye of each viewer in a display config has one or more surfaces
     (aka "screens") on which content should be rendered.
 
@@ -37,6 +37,7 @@
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -75,6 +76,36 @@ OSVR_CALLBACK_METHODS(Skeleton)
 
 #undef OSVR_CALLBACK_METHODS
 
+/** @brief Start keeping a history of the most recent pose reports received
+    on an interface, for use by osvrGetPoseStateAtTime().
+
+    Storage is allocated once, here, so later queries do not allocate.
+
+    @param iface The interface.
+    @param capacity Number of pose reports to keep: must be nonzero.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientEnablePoseHistory(OSVR_ClientInterface iface, uint32_t capacity);
+
+/** @brief Get an estimate of the pose of an interface at a given time, such
+    as the predicted display time of a frame.
+
+    Times within the span of the pose history (see
+    osvrClientEnablePoseHistory()) are interpolated, times before it return
+    the oldest pose kept, and times after the most recent pose are
+    extrapolated (by no more than 100ms) using the most recent velocity
+    state, if the interface reports velocity.
+
+    @param iface The interface.
+    @param when The time of interest.
+    @param[out] state The estimated pose.
+    @return OSVR_RETURN_FAILURE if no pose has been received yet.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                       const struct OSVR_TimeValue *when,
+                       OSVR_PoseState *state);
+
 OSVR_EXTERN_C_END
 
 #endif
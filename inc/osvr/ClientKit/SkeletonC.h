@@ -177,6 +177,33 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetSkeletonNumBones(
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetSkeletonNumJoints(
     OSVR_Skeleton skel, OSVR_SkeletonJointCount *numJoints);
 
+/** @brief Get the states of all joints and bones of a skeleton in a single
+call, all from the same skeleton report.
+
+Much cheaper than calling osvrClientGetSkeletonJointState() and
+osvrClientGetSkeletonBoneState() for each id, and never mixes poses of
+different reports. Only joints and bones with a pose in the report are
+copied, in articulation tree order, each with its id.
+
+@param skel skeleton object
+@param joints array of jointCapacity joint states to fill: the number of joints
+reported by osvrClientGetSkeletonNumJoints is always enough. May be null if
+jointCapacity is 0.
+@param jointCapacity number of entries in joints
+@param[out] numJoints number of joint states copied. If the call fails for
+lack of room, the number that would have been copied.
+@param bones array of boneCapacity bone states to fill, likewise.
+@param boneCapacity number of entries in bones
+@param[out] numBones number of bone states copied, likewise.
+
+Fails, leaving both arrays unchanged, if either is too small.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetSkeletonSnapshot(
+    OSVR_Skeleton skel, OSVR_SkeletonJointState *joints,
+    OSVR_SkeletonJointCount jointCapacity, OSVR_SkeletonJointCount *numJoints,
+    OSVR_SkeletonBoneState *bones, OSVR_SkeletonBoneCount boneCapacity,
+    OSVR_SkeletonBoneCount *numBones);
+
 /** @} */
 /** @} */
 
@@ -94,6 +94,20 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
             "type!");
         m_state.setStateFromReport(timestamp, report);
     }
+
+    /// @brief Keep a history of the given number of most recent states for a
+    /// report type.
+    template <typename ReportType>
+    void enableStateHistory(std::size_t capacity) {
+        m_state.enableHistory<ReportType>(capacity);
+    }
+
+    /// @brief Estimate the pose at the given time from the recent pose
+    /// history and velocity state.
+    /// @sa osvr::common::getPoseAtTime()
+    OSVR_COMMON_EXPORT bool
+    getPoseStateAtTime(osvr::util::time::TimeValue const &when,
+                       OSVR_PoseState &state) const;
     /// @}
 
     /// @name Callback-related wrapper methods
@@ -62,6 +62,13 @@ namespace common {
     /// segment name and signalling new data, and no guarantee that the data you
     /// were notified about won't be overwritten - just that if you're currently
     /// accessing data, we won't overwrite that.
+    ///
+    /// Alternately, a buffer may be created in "lock-free" mode (see
+    /// Options::setLockFree()), in which the producer never waits on readers:
+    /// each element carries a generation stamp, and readers copy the element
+    /// out and then verify that it wasn't overwritten while they were copying.
+    /// In that mode, a "get" may fail if the requested element was replaced
+    /// before or during the read.
     class IPCRingBuffer : public enable_shared_from_this<IPCRingBuffer> {
       public:
         typedef uint8_t BackendType;
@@ -100,12 +107,24 @@ namespace common {
             Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets whether the ring buffer should be created in
+            /// lock-free (generation-stamped) mode rather than using
+            /// interprocess mutexes. Only used when creating a buffer: when
+            /// finding one, the mode is read from the shared memory.
+            /// @return *this for chained method idiom.
+            Options &setLockFree(bool lockFree) {
+                m_lockFree = lockFree;
+                return *this;
+            }
+            bool getLockFree() const { return m_lockFree; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
+            bool m_lockFree = false;
         };
 
         /// @brief Gets an integer representing a unique arrangement of the
@@ -143,6 +162,10 @@ namespace common {
         /// this ring buffer.
         OSVR_COMMON_EXPORT uint16_t getEntries() const;
 
+        /// @brief Returns true if this ring buffer uses the lock-free
+        /// (generation-stamped) mode rather than interprocess mutexes.
+        OSVR_COMMON_EXPORT bool isLockFree() const;
+
         /// @brief The sequence number is automatically incremented with each
         /// "put" into the buffer. Note that, as an unsigned integer, it does
         /// have (and uses) well-defined overflow semantics.
@@ -166,12 +189,17 @@ namespace common {
             BufferWriteProxy &operator=(BufferWriteProxy const &) = delete;
 
             /// @brief move-constructible
-            BufferWriteProxy(BufferWriteProxy &&other) {
+            BufferWriteProxy(BufferWriteProxy &&other)
+                : m_buf(nullptr), m_seq(0) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
             }
 
             /// @brief move-assignable
             BufferWriteProxy &operator=(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
                 return *this;
             }
@@ -182,6 +210,12 @@ namespace common {
 
             sequence_type getSequenceNumber() const { return m_seq; }
 
+            /// @brief Releases the element without publishing it, for a
+            /// producer that won't finish filling it. Only possible in
+            /// lock-free mode: with mutexes, the element is already part of
+            /// the buffer, so it is simply released as-is.
+            OSVR_COMMON_EXPORT void abandon();
+
           private:
             BufferWriteProxy(detail::IPCPutResultPtr &&data,
                              IPCRingBufferPtr &&shm);
@@ -193,7 +227,8 @@ namespace common {
 
         /// @brief A class providing access to an entry in the ring buffer,
         /// holding a sharable mutex lock preventing it from being overwritten
-        /// while this object is in scope.
+        /// while this object is in scope. (In lock-free mode, it instead owns
+        /// a validated copy of the entry.)
         ///
         /// As such, you should only access the memory pointed to by this object
         /// while you keep this object alive, and you should let it go out of
@@ -31,6 +31,7 @@
 #include <osvr/Common/IPCRingBuffer.h>
 #include <osvr/Common/ImagingComponentConfig.h>
 #include <osvr/Common/SerializationTags.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
 
@@ -48,6 +49,17 @@ namespace common {
         OSVR_ImagingMetadata metadata;
         ImageBufferPtr buffer;
     };
+    /// @brief How image data sent over the network (rather than through
+    /// shared memory) is encoded.
+    enum class ImageWireCompression : uint8_t {
+        /// @brief Raw image bytes: frames that fit in a single message are
+        /// sent as-is, larger frames are split into chunks.
+        None = 0,
+        /// @brief Frames are always sent in chunks, each run-length encoded
+        /// if that makes it smaller.
+        RunLength = 1
+    };
+
     namespace messages {
         class ImageRegion : public MessageRegistration<ImageRegion> {
           public:
@@ -55,6 +67,12 @@ namespace common {
 
             static const char *identifier();
         };
+        class ImageRegionChunk : public MessageRegistration<ImageRegionChunk> {
+          public:
+            class MessageSerialization;
+
+            static const char *identifier();
+        };
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         class ImagePlacedInProcessMemory
             : public MessageRegistration<ImagePlacedInProcessMemory> {
@@ -71,6 +89,8 @@ namespace common {
         };
     } // namespace messages
 
+    class ImageChunkAssembler;
+
     /// @brief BaseDevice component
     class ImagingComponent : public DeviceComponent {
       public:
@@ -89,6 +109,10 @@ namespace common {
         /// @brief Message from server to client, containing some image data.
         messages::ImageRegion imageRegion;
 
+        /// @brief Message from server to client, containing a (possibly
+        /// compressed) piece of an image too large for a single message.
+        messages::ImageRegionChunk imageRegionChunk;
+
         /// @brief Message from server to client, notifying of image data in the
         /// shared memory ring buffer.
         messages::ImagePlacedInSharedMemory imagePlacedInSharedMemory;
@@ -103,11 +127,54 @@ namespace common {
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Zero-copy alternative to sendImageData(): returns a buffer
+        /// large enough for an image with the given metadata that the caller
+        /// may fill in place - an entry directly in the shared memory ring
+        /// buffer if it is lock-free, otherwise a private buffer copied in on
+        /// commit. Should be followed by commitImageBuffer() for the same
+        /// sensor: acquiring again first abandons the previous buffer, which
+        /// is then never published.
+        ///
+        /// @return nullptr if no buffer could be provided.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement *
+        acquireImageBuffer(OSVR_ImagingMetadata metadata,
+                           OSVR_ChannelCount sensor);
+
+        /// @brief Publishes the buffer previously returned by
+        /// acquireImageBuffer() for the given sensor.
+        ///
+        /// @return false if there was no buffer acquired for that sensor.
+        OSVR_COMMON_EXPORT bool
+        commitImageBuffer(OSVR_ChannelCount sensor,
+                          OSVR_TimeValue const &timestamp);
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)>
             ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
 
+        /// @brief Selects whether shared memory ring buffers created by this
+        /// component (server side) use the lock-free mode, so that sending
+        /// an image never blocks on slow readers. Takes effect the next time
+        /// a sensor's ring buffer is (re-)created.
+        OSVR_COMMON_EXPORT void setSharedMemoryLockFree(bool lockFree);
+
+        /// @brief Allows images that do not fit in a single message (or any
+        /// image, if compression is selected) to be sent over the network as
+        /// a series of chunks (server side). Off by default, since local
+        /// clients receive images through shared memory anyway.
+        OSVR_COMMON_EXPORT void setWireChunkingEnabled(bool enabled);
+
+        /// @brief Selects the encoding of images sent over the network in
+        /// chunks (server side).
+        OSVR_COMMON_EXPORT void
+        setWireCompression(ImageWireCompression compression);
+
+        /// @brief Limits the (pre-compression) image bytes per second sent
+        /// over the network by dropping frames that would exceed the budget.
+        /// 0 (the default) means unlimited. Does not affect shared memory.
+        OSVR_COMMON_EXPORT void setWireMaxBytesPerSecond(uint32_t bytes);
+
       private:
         ImagingComponent();
         virtual void m_parentSet();
@@ -118,6 +185,19 @@ namespace common {
                                             OSVR_ChannelCount sensor,
                                             OSVR_TimeValue const &timestamp);
 
+        /// @brief Creates or replaces the shared memory ring buffer for a
+        /// sensor if required to hold images of the given size.
+        /// @return true if there is a suitable ring buffer.
+        bool m_ensureShmBuf(OSVR_ImagingMetadata const &metadata,
+                            OSVR_ChannelCount sensor);
+
+        /// @brief Sends the message notifying of an image already placed in
+        /// the sensor's shared memory ring buffer.
+        void m_sendSharedMemoryNotification(OSVR_ImagingMetadata metadata,
+                                            IPCRingBuffer::sequence_type seq,
+                                            OSVR_ChannelCount sensor,
+                                            OSVR_TimeValue const &timestamp);
+
         /// @return true if we could send it.
         bool m_sendImageDataOnTheWire(OSVR_ImagingMetadata metadata,
                                       OSVR_ImageBufferElement *imageData,
@@ -129,11 +209,31 @@ namespace common {
         bool m_sendImageDataViaInProcessMemory(
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
+
+        /// @brief Hands ownership of an aligned buffer to the in-process
+        /// recipient.
+        void m_sendInProcessBuffer(OSVR_ImagingMetadata metadata,
+                                   util::AlignedImageBufferPtr &&buffer,
+                                   OSVR_ChannelCount sensor,
+                                   OSVR_TimeValue const &timestamp);
 #endif
 
+        /// @brief Sends an image as one or more ImageRegionChunk messages.
+        void m_sendImageChunks(OSVR_ImagingMetadata const &metadata,
+                               OSVR_ImageBufferElement const *imageData,
+                               OSVR_ChannelCount sensor,
+                               OSVR_TimeValue const &timestamp);
+
+        /// @brief Checks (and spends from) the network bandwidth budget.
+        bool m_wireBudgetAllows(uint32_t bytes,
+                                OSVR_TimeValue const &timestamp);
+
         static int VRPN_CALLBACK m_handleImageRegion(void *userdata,
                                                      vrpn_HANDLERPARAM p);
 
+        static int VRPN_CALLBACK m_handleImageRegionChunk(void *userdata,
+                                                          vrpn_HANDLERPARAM p);
+
         static int VRPN_CALLBACK
         m_handleImagePlacedInSharedMemory(void *userdata, vrpn_HANDLERPARAM p);
 
@@ -142,13 +242,39 @@ namespace common {
         m_handleImagePlacedInProcessMemory(void *userdata, vrpn_HANDLERPARAM p);
 #endif
 
+        /// @brief Client side: whether images for this sensor are arriving
+        /// through shared memory, in which case copies sent over the network
+        /// are redundant and ignored.
+        bool m_receivingViaSharedMemory(OSVR_ChannelCount sensor) const;
+
         void m_checkFirst(OSVR_ImagingMetadata const &metadata);
         void m_growShmVecIfRequired(OSVR_ChannelCount sensor);
 
+        /// @brief A buffer handed out by acquireImageBuffer() and not yet
+        /// committed: at most one of the two is set.
+        struct PendingImage {
+            OSVR_ImagingMetadata metadata;
+            /// @brief Zero-copy slot in a lock-free shared memory ring buffer
+            unique_ptr<IPCRingBuffer::BufferWriteProxy> shmSlot;
+            /// @brief Private buffer, used otherwise.
+            util::AlignedImageBufferPtr buffer;
+        };
+
         std::vector<ImageHandler> m_cb;
         bool m_gotOne;
+        bool m_wireChunking;
+        ImageWireCompression m_wireCompression;
+        uint32_t m_wireMaxBytesPerSecond;
+        double m_wireBudget;
+        OSVR_TimeValue m_wireBudgetTime;
+        uint32_t m_wireFrame;
+        /// @brief One for each sensor (client side)
+        std::vector<unique_ptr<ImageChunkAssembler>> m_chunkAssembly;
+        bool m_shmLockFree;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+        /// @brief One for each sensor
+        std::vector<PendingImage> m_pending;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,178 @@
+/** @file
+    @brief Header declaring a bus delivering tracker reports directly to
+    subscribers in the same process, bypassing VRPN message packing.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InProcessReportBus_h_GUID_B74148CB_B589_4FB8_AD69_E80E0F9EFCC5
+#define INCLUDED_InProcessReportBus_h_GUID_B74148CB_B589_4FB8_AD69_E80E0F9EFCC5
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <osvr/TypePack/List.h>
+#include <osvr/TypePack/TypeKeyedTuple.h>
+
+// Standard includes
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class vrpn_Connection;
+
+namespace osvr {
+namespace common {
+    /// @brief The tracker states carried by the in-process report bus.
+    using InProcessReportTypeList =
+        typepack::list<OSVR_PoseState, OSVR_VelocityState,
+                       OSVR_AccelerationState>;
+
+    /// @brief A subscriber to one state type on a channel: a function pointer
+    /// and its userdata, so delivery goes through no type-erased wrapper.
+    template <typename StateType> struct InProcessReportSubscriber {
+        typedef void (*FunctionPtr)(void *userdata, StateType const &state,
+                                    OSVR_ChannelCount sensor,
+                                    util::time::TimeValue const &timestamp);
+        FunctionPtr callback;
+        void *userdata;
+    };
+
+    /// @brief Trait computing the storage for subscribers to a state type.
+    struct InProcessSubscriberStorage {
+        template <typename StateType>
+        using apply = std::vector<InProcessReportSubscriber<StateType> >;
+    };
+
+    /// @brief The reports of one device, as published by the device's server
+    /// object and received by subscribers sharing its VRPN connection.
+    ///
+    /// Delivery is synchronous, from within publish(), just as VRPN delivers
+    /// messages to handlers on the sending connection from within
+    /// pack_message(). Likewise, a channel is not thread-safe: it is used
+    /// under the same exclusion as the connection it stands in for.
+    /// Subscribers may (un)subscribe from within their callbacks: those
+    /// added during a publish() may or may not get that report, those removed
+    /// don't.
+    class InProcessReportChannel : boost::noncopyable {
+      public:
+        template <typename StateType>
+        void subscribe(
+            typename InProcessReportSubscriber<StateType>::FunctionPtr cb,
+            void *userdata) {
+            typepack::get<StateType>(m_subscribers)
+                .push_back(InProcessReportSubscriber<StateType>{cb, userdata});
+        }
+
+        template <typename StateType>
+        void unsubscribe(
+            typename InProcessReportSubscriber<StateType>::FunctionPtr cb,
+            void *userdata) {
+            for (auto &sub : typepack::get<StateType>(m_subscribers)) {
+                if (sub.callback == cb && sub.userdata == userdata) {
+                    sub.callback = nullptr;
+                }
+            }
+            if (m_publishing == 0) {
+                m_removeCleared<StateType>();
+            }
+            // otherwise, removed once the outermost publish() is done.
+        }
+
+        /// @brief Lets publishers skip preparing a report nobody will get.
+        template <typename StateType> bool hasSubscribers() const {
+            auto const &subscribers =
+                typepack::cget<StateType>(m_subscribers);
+            return std::any_of(
+                begin(subscribers), end(subscribers),
+                [](InProcessReportSubscriber<StateType> const &sub) {
+                    return sub.callback != nullptr;
+                });
+        }
+
+        template <typename StateType>
+        void publish(StateType const &state, OSVR_ChannelCount sensor,
+                     util::time::TimeValue const &timestamp) {
+            auto &subscribers = typepack::get<StateType>(m_subscribers);
+            ++m_publishing;
+            // By index, and by value, as subscribers may be added under us.
+            for (std::size_t i = 0; i < subscribers.size(); ++i) {
+                auto sub = subscribers[i];
+                if (sub.callback) {
+                    sub.callback(sub.userdata, state, sensor, timestamp);
+                }
+            }
+            if (--m_publishing == 0) {
+                m_removeCleared<StateType>();
+            }
+        }
+
+      private:
+        template <typename StateType> void m_removeCleared() {
+            auto &subscribers = typepack::get<StateType>(m_subscribers);
+            subscribers.erase(
+                std::remove_if(
+                    begin(subscribers), end(subscribers),
+                    [](InProcessReportSubscriber<StateType> const &sub) {
+                        return sub.callback == nullptr;
+                    }),
+                end(subscribers));
+        }
+
+        typepack::TypeKeyedTuple<InProcessReportTypeList,
+                                 InProcessSubscriberStorage>
+            m_subscribers;
+        /// @brief Depth of nested publish() calls.
+        std::size_t m_publishing = 0;
+    };
+
+    typedef shared_ptr<InProcessReportChannel> InProcessReportChannelPtr;
+
+    /// @brief Called by a device's server object to make its reports
+    /// available in-process: creates and registers a channel for the device
+    /// name on that connection, replacing any previous one.
+    OSVR_COMMON_EXPORT InProcessReportChannelPtr
+    advertiseInProcessReports(vrpn_Connection *conn, std::string const &device);
+
+    /// @brief Called by a device's server object on destruction: unregisters
+    /// its channel, if still the registered one.
+    OSVR_COMMON_EXPORT void
+    withdrawInProcessReports(vrpn_Connection *conn, std::string const &device,
+                             InProcessReportChannelPtr const &channel);
+
+    /// @brief Finds the channel of the named device on the given connection.
+    ///
+    /// @returns nullptr if the device doesn't publish in-process reports on
+    /// that connection (including when it lives in another process), in which
+    /// case its reports must be received over VRPN.
+    OSVR_COMMON_EXPORT InProcessReportChannelPtr
+    findInProcessReports(vrpn_Connection *conn, std::string const &device);
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InProcessReportBus_h_GUID_B74148CB_B589_4FB8_AD69_E80E0F9EFCC5
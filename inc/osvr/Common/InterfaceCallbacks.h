@@ -37,41 +37,68 @@
 // Standard includes
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace osvr {
 namespace common {
+    /// @brief A C callback function pointer for a report type, along with its
+    /// userdata: all that is needed to invoke it, with no type erasure.
+    template <typename ReportType> struct RawCallback {
+        typedef void (*FunctionPtr)(void *userdata,
+                                    const OSVR_TimeValue *timestamp,
+                                    const ReportType *report);
+        FunctionPtr callback;
+        void *userdata;
+    };
+
     /// @brief Trait computing the storage for callbacks for a report
     /// type.
     /// @todo can't use quote because of bad interaction with MSVC 2013 that
     /// causes types to get mixed up - only the first quote works.
     struct CallbackStorage {
         template <typename ReportType>
-        using apply = std::vector<
-            std::function<void(const OSVR_TimeValue *, const ReportType *)>>;
+        using apply = std::vector<RawCallback<ReportType>>;
     };
 
     using CallbackTuple =
         typepack::TypeKeyedTuple<traits::ReportTypeList, CallbackStorage>;
     /// @brief Class to maintain callbacks for an interface for each report type
     /// explicitly enumerated.
+    ///
+    /// Callbacks are stored as flat arrays of function pointer and userdata
+    /// pairs, so dispatching a report doesn't go through any type-erased
+    /// wrapper.
     class InterfaceCallbacks {
       public:
+        template <typename ReportType>
+        using Callable = std::function<void(const OSVR_TimeValue *,
+                                            const ReportType *)>;
+
         template <typename CallbackType>
         void addCallback(CallbackType cb, void *userdata) {
             using ReportType = traits::ReportFromCallback_t<CallbackType>;
             typepack::get<ReportType>(m_callbacks)
-                .push_back(
-                    [cb, userdata](util::time::TimeValue const *timestamp,
-                                   ReportType const *report) {
-                        cb(userdata, timestamp, report);
-                    });
+                .push_back(RawCallback<ReportType>{cb, userdata});
+        }
+
+        /// @brief Fallback for C++ callables: the callable is kept alive by
+        /// this object, and dispatched to through a function pointer like any
+        /// other callback.
+        template <typename ReportType>
+        void addCallable(Callable<ReportType> f) {
+            auto owned = std::make_shared<Callable<ReportType>>(std::move(f));
+            typepack::get<ReportType>(m_callbacks)
+                .push_back(RawCallback<ReportType>{
+                    &InterfaceCallbacks::invokeCallable<ReportType>,
+                    owned.get()});
+            m_ownedCallables.push_back(owned);
         }
 
         template <typename ReportType>
         void triggerCallbacks(util::time::TimeValue const &timestamp,
                               ReportType const &report) const {
-            for (auto const &f : typepack::cget<ReportType>(m_callbacks)) {
-                f(&timestamp, &report);
+            for (auto const &cb : typepack::cget<ReportType>(m_callbacks)) {
+                cb.callback(cb.userdata, &timestamp, &report);
             }
         }
 
@@ -81,7 +108,16 @@ namespace common {
         }
 
       private:
+        template <typename ReportType>
+        static void invokeCallable(void *userdata,
+                                   const OSVR_TimeValue *timestamp,
+                                   const ReportType *report) {
+            (*static_cast<Callable<ReportType> *>(userdata))(timestamp,
+                                                             report);
+        }
         CallbackTuple m_callbacks;
+        /// @brief Ownership of the callables added with addCallable()
+        std::vector<std::shared_ptr<void>> m_ownedCallables;
     };
 
 } // namespace common
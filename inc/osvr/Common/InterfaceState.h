@@ -29,16 +29,18 @@
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportState.h>
+#include <osvr/Common/StateHistory.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/TypePack/TypeKeyedTuple.h>
 #include <osvr/TypePack/Quote.h>
+#include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
 #include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace osvr {
 namespace common {
@@ -61,8 +63,27 @@ namespace common {
         typepack::TypeKeyedTuple<traits::ReportTypeList,
                                  typepack::quote<StateMapValueType>>;
 
+    /// @brief Alias taking a report type and returning the history type for
+    /// its state.
+    template <typename ReportType>
+    using StateHistoryFor = StateHistory<traits::StateFromReport_t<ReportType>>;
+
+    /// @brief Alias taking a report type and returning a pointer to an
+    /// optional state history.
+    template <typename ReportType>
+    using StateHistoryPtr = unique_ptr<StateHistoryFor<ReportType>>;
+
+    /// @brief Data structure mapping from a report type to an optional state
+    /// history.
+    using StateHistoryMap =
+        typepack::TypeKeyedTuple<traits::ReportTypeList,
+                                 typepack::quote<StateHistoryPtr>>;
+
     /// @brief Class to maintain state for an interface for each report (and
     /// thus state) type explicitly enumerated.
+    ///
+    /// Optionally also keeps a bounded history of recent states of selected
+    /// report types.
     class InterfaceState {
       public:
         template <typename ReportType>
@@ -71,10 +92,29 @@ namespace common {
             StateMapContents<ReportType> c;
             c.state = reportState(report);
             c.timestamp = timestamp;
+            auto &history = typepack::get<ReportType>(m_histories);
+            if (history) {
+                history->push(timestamp, c.state);
+            }
             typepack::get<ReportType, StateMap>(m_states) = c;
             m_hasState = true;
         }
 
+        /// @brief Start (or restart, with a new capacity) keeping a history
+        /// of the given number of most recent states of a report type.
+        template <typename ReportType>
+        void enableHistory(std::size_t capacity) {
+            typepack::get<ReportType>(m_histories)
+                .reset(new StateHistoryFor<ReportType>(capacity));
+        }
+
+        /// @brief Get the history for a report type, or nullptr if history
+        /// is not enabled for it.
+        template <typename ReportType>
+        StateHistoryFor<ReportType> const *getHistory() const {
+            return typepack::cget<ReportType>(m_histories).get();
+        }
+
         template <typename ReportType> bool hasState() const {
             // using typepack::get;
             return m_hasState && bool(typepack::cget<ReportType>(m_states));
@@ -95,6 +135,7 @@ namespace common {
 
       private:
         StateMap m_states;
+        StateHistoryMap m_histories;
         bool m_hasState = false;
     };
 
@@ -51,6 +51,10 @@ namespace common {
     /// is VR" so when milliseconds count, it might be OK. Bruce Dawson even
     /// says so :)
     /// https://randomascii.wordpress.com/2016/03/08/power-wastage-on-an-idle-laptop/#comment-20184
+    ///
+    /// On Linux, if enabled with setLowLatencyMemoryLocking(), this locks the
+    /// process's memory (mlockall) so page faults don't add latency, unlocking
+    /// it again when destroyed.
     class LowLatency {
       public:
         OSVR_COMMON_EXPORT LowLatency();
@@ -63,6 +67,12 @@ namespace common {
         struct Impl;
         std::unique_ptr<Impl> m_impl;
     };
+
+    /// @brief Sets, process-wide, whether LowLatency objects created from
+    /// now on should also lock the process's memory. Off by default, since
+    /// it requires privileges (CAP_IPC_LOCK or a large enough
+    /// RLIMIT_MEMLOCK). Only supported on Linux.
+    OSVR_COMMON_EXPORT void setLowLatencyMemoryLocking(bool enable);
 } // namespace common
 } // namespace osvr
 #endif // INCLUDED_LowLatency_h_GUID_A7B15740_3824_499E_22C3_EE2B08AFC7AC
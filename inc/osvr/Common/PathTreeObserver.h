@@ -40,7 +40,14 @@
 namespace osvr {
 namespace common {
     class PathTreeOwner;
-    enum class PathTreeEvents : std::size_t { AboutToUpdate, AfterUpdate };
+    /// @brief Events on a PathTreeOwner: AboutToUpdate and AfterUpdate bracket
+    /// a full rebuild of the tree, while AfterIncrementalUpdate follows
+    /// changes made in place (so existing nodes remain valid).
+    enum class PathTreeEvents : std::size_t {
+        AboutToUpdate,
+        AfterUpdate,
+        AfterIncrementalUpdate
+    };
     class PathTreeObserver : public boost::noncopyable {
       public:
         using callback_argument = PathTree &;
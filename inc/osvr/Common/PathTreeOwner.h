@@ -27,11 +27,14 @@
 
 // Internal Includes
 #include <osvr/Common/PathTreeObserverPtr.h>
+#include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/Export.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 #include <json/value.h>
 
 // Standard includes
@@ -67,8 +70,27 @@ namespace common {
 
         /// @brief Replace the entirety of the path tree from the given
         /// serialized array of nodes.
+        ///
+        /// The first time, this builds the tree from scratch. After that, only
+        /// the nodes that differ are updated, in place, and observers are
+        /// notified with PathTreeEvents::AfterIncrementalUpdate.
         OSVR_COMMON_EXPORT void replaceTree(Json::Value const &nodes);
 
+        /// @brief Apply a delta message (see
+        /// messages::TreeDeltaFromServer) to the tree in place.
+        ///
+        /// A delta with no "baseVersion" marks the version of the tree most
+        /// recently received in full.
+        ///
+        /// @return false if the delta did not apply to our version of the
+        /// tree and was ignored - the next full replacement tree will bring
+        /// us back in sync.
+        OSVR_COMMON_EXPORT bool applyTreeDelta(Json::Value const &delta);
+
+        /// @brief The version of the tree as last marked by the server, if
+        /// known.
+        boost::optional<uint32_t> getVersion() const { return m_version; }
+
         /// @brief Access the path tree object itself
         PathTree &get() { return m_tree; }
 
@@ -76,9 +98,11 @@ namespace common {
         PathTree const &get() const { return m_tree; }
 
       private:
+        void m_notify(PathTreeEvents e);
         PathTree m_tree;
         std::vector<PathTreeObserverWeakPtr> m_observers;
         bool m_valid = false;
+        boost::optional<uint32_t> m_version;
     };
 } // namespace common
 } // namespace osvr
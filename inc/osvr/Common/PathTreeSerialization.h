@@ -49,6 +49,26 @@ namespace common {
 
     /// @brief Deserialize a path tree from a JSON array of objects
     OSVR_COMMON_EXPORT void jsonToPathTree(PathTree &tree, Json::Value nodes);
+
+    /// @brief Compute the changes between two path trees serialized by
+    /// pathTreeToJson().
+    ///
+    /// @return a JSON object with a "set" member, an array of node objects
+    /// that are new or changed in newNodes, and a "remove" member, an array of
+    /// paths that had a node in oldNodes but do not in newNodes.
+    OSVR_COMMON_EXPORT Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                                                 Json::Value const &newNodes);
+
+    /// @brief Returns true if a delta from pathTreeDelta() has no changes.
+    OSVR_COMMON_EXPORT bool isEmptyPathTreeDelta(Json::Value const &delta);
+
+    /// @brief Apply a delta from pathTreeDelta() to a path tree in place.
+    ///
+    /// Removed nodes that have no remaining children are dropped from the
+    /// tree, along with any ancestors that are left null and childless.
+    /// References to pruned nodes are invalidated.
+    OSVR_COMMON_EXPORT void applyPathTreeDelta(PathTree &tree,
+                                               Json::Value const &delta);
 } // namespace common
 } // namespace osvr
 
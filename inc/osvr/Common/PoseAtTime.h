@@ -0,0 +1,64 @@
+/** @file
+    @brief Header declaring a query for an interface's pose at an arbitrary
+    time, using its recent history and velocity.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseAtTime_h_GUID_655E1CF6_D8A5_4891_A460_7DF08761CFE8
+#define INCLUDED_PoseAtTime_h_GUID_655E1CF6_D8A5_4891_A460_7DF08761CFE8
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/InterfaceState.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Maximum time, in seconds, that getPoseAtTime() will extrapolate
+    /// past the newest pose: requests further in the future are clamped to
+    /// this.
+    static const double MAX_POSE_EXTRAPOLATION = 0.1;
+
+    /// @brief Estimate the pose of an interface at a given time.
+    ///
+    /// - Within the span of the pose history (if enabled with
+    /// InterfaceState::enableHistory<OSVR_PoseReport>()), the two surrounding
+    /// poses are interpolated.
+    /// - Before the oldest pose kept, the oldest pose is returned.
+    /// - After the newest pose, it is extrapolated using the most recent
+    /// velocity state, if any, or else returned unchanged.
+    ///
+    /// @return false if no pose state is available at all.
+    OSVR_COMMON_EXPORT bool getPoseAtTime(InterfaceState const &state,
+                                          util::time::TimeValue const &when,
+                                          OSVR_PoseState &pose);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PoseAtTime_h_GUID_655E1CF6_D8A5_4891_A460_7DF08761CFE8
@@ -29,12 +29,16 @@
 #include <osvr/Common/Export.h>
 #include <osvr/Common/PathTree_fwd.h>
 #include <osvr/Common/OriginalSource.h>
+#include <osvr/Common/ParseAlias.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
+#include <boost/noncopyable.hpp>
 #include <boost/optional.hpp>
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
@@ -42,6 +46,49 @@ namespace common {
     OSVR_COMMON_EXPORT boost::optional<OriginalSource>
     resolveTreeNode(PathTree &pathTree, std::string const &path);
 
+    class TreeResolutionCache;
+
+    /// @brief Like resolveTreeNode(PathTree &, std::string const &), but
+    /// consults and populates the given cache, which must only ever be used
+    /// with this tree.
+    OSVR_COMMON_EXPORT boost::optional<OriginalSource>
+    resolveTreeNode(PathTree &pathTree, std::string const &path,
+                    TreeResolutionCache &cache);
+
+    /// @brief Memoizes the results of resolveTreeNode() for a single path tree,
+    /// along with the parsed form of every alias source encountered along the
+    /// way, so resolving many paths that share alias chains doesn't re-parse
+    /// the same JSON over and over.
+    ///
+    /// Results hold pointers into the tree, so invalidate() must be called
+    /// whenever the tree changes: this starts a new generation.
+    class TreeResolutionCache : boost::noncopyable {
+      public:
+        OSVR_COMMON_EXPORT TreeResolutionCache();
+
+        /// @brief Discard all resolution results, because the tree has
+        /// changed.
+        OSVR_COMMON_EXPORT void invalidate();
+
+        /// @brief Number of times the cache has been invalidated.
+        uint64_t getGeneration() const { return m_generation; }
+
+        /// @brief Get the parsed form of an alias source string, parsing it
+        /// only the first time.
+        OSVR_COMMON_EXPORT ParsedAlias const &
+        getParsedAlias(std::string const &source);
+
+      private:
+        friend boost::optional<OriginalSource>
+        resolveTreeNode(PathTree &pathTree, std::string const &path,
+                        TreeResolutionCache &cache);
+        typedef std::unordered_map<std::string, boost::optional<OriginalSource>>
+            ResultMap;
+        ResultMap m_results;
+        std::unordered_map<std::string, ParsedAlias> m_aliases;
+        uint64_t m_generation = 0;
+    };
+
 } // namespace common
 } // namespace osvr
 
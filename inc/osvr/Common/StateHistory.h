@@ -0,0 +1,119 @@
+/** @file
+    @brief Header containing a fixed-capacity history of timestamped states.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StateHistory_h_GUID_BE689C7C_B781_4701_AB9C_E3B15DE87AF0
+#define INCLUDED_StateHistory_h_GUID_BE689C7C_B781_4701_AB9C_E3B15DE87AF0
+
+// Internal Includes
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A ring buffer holding the most recent timestamped values of a
+    /// state type, oldest overwritten first.
+    ///
+    /// All storage is allocated on construction, so recording and querying
+    /// never allocate.
+    template <typename StateType> class StateHistory {
+      public:
+        struct Entry {
+            util::time::TimeValue timestamp;
+            StateType state;
+        };
+
+        /// @throws std::invalid_argument if capacity is 0.
+        explicit StateHistory(std::size_t capacity)
+            : m_entries(capacity), m_next(0), m_size(0) {
+            if (capacity == 0) {
+                throw std::invalid_argument(
+                    "State history capacity must be nonzero!");
+            }
+        }
+
+        /// @brief Record a new state, discarding the oldest if full.
+        void push(util::time::TimeValue const &timestamp,
+                  StateType const &state) {
+            auto &entry = m_entries[m_next];
+            entry.timestamp = timestamp;
+            entry.state = state;
+            m_next = (m_next + 1) % capacity();
+            if (m_size < capacity()) {
+                ++m_size;
+            }
+        }
+
+        std::size_t size() const { return m_size; }
+        std::size_t capacity() const { return m_entries.size(); }
+        bool empty() const { return m_size == 0; }
+
+        /// @brief Access an entry by age: 0 is the newest, size() - 1 the
+        /// oldest.
+        Entry const &operator[](std::size_t age) const {
+            BOOST_ASSERT_MSG(age < m_size, "Index out of range!");
+            return m_entries[(m_next + capacity() - 1 - age) % capacity()];
+        }
+
+        Entry const &newest() const { return (*this)[0]; }
+        Entry const &oldest() const { return (*this)[m_size - 1]; }
+
+        /// @brief Find the pair of consecutive entries whose timestamps
+        /// surround the given time.
+        ///
+        /// @return false if the time is not within the span of the history,
+        /// in which case before and after are not modified.
+        bool findBracket(util::time::TimeValue const &when,
+                         Entry const *&before, Entry const *&after) const {
+            for (std::size_t age = 1; age < m_size; ++age) {
+                auto const &older = (*this)[age];
+                if (!osvrTimeValueGreater(older.timestamp, when)) {
+                    auto const &newer = (*this)[age - 1];
+                    if (osvrTimeValueGreater(when, newer.timestamp)) {
+                        // Newer than everything in the history.
+                        return false;
+                    }
+                    before = &older;
+                    after = &newer;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+      private:
+        std::vector<Entry> m_entries;
+        std::size_t m_next;
+        std::size_t m_size;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StateHistory_h_GUID_BE689C7C_B781_4701_AB9C_E3B15DE87AF0
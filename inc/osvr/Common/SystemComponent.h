@@ -31,6 +31,7 @@
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <json/value.h>
@@ -69,6 +70,36 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        /// @brief Message carrying incremental changes to the path tree: a JSON
+        /// object as produced by pathTreeDelta(), plus a "version" member
+        /// and, unless it just marks the version of the preceding full
+        /// replacement tree, a "baseVersion" member naming the version it
+        /// applies to.
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        /// @brief Message asking connected clients whether they can apply tree
+        /// deltas: a JSON object with a "query" member numbering the request.
+        class TreeDeltaSupportQueryFromServer
+            : public MessageRegistration<TreeDeltaSupportQueryFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        /// @brief Reply to TreeDeltaSupportQueryFromServer from a client that
+        /// can apply tree deltas, echoing the "query" member.
+        class TreeDeltaSupportToServer
+            : public MessageRegistration<TreeDeltaSupportToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -118,13 +149,51 @@ namespace common {
 
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @overload
+        ///
+        /// Takes a tree already serialized by pathTreeToJson()
+        OSVR_COMMON_EXPORT void
+        sendReplacementTree(Json::Value const &nodes);
+
+        /// @brief Message from server, carrying incremental changes to the
+        /// client's configuration.
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        /// @brief Registers a handler for tree deltas. Once one is
+        /// registered, this component also answers the server's delta support
+        /// queries, so the server knows it may send deltas.
+        OSVR_COMMON_EXPORT void registerTreeDeltaHandler(JsonHandler cb);
+
+        OSVR_COMMON_EXPORT void sendTreeDelta(Json::Value const &delta);
+
+        /// @brief Message from server, asking which clients can apply deltas.
+        messages::TreeDeltaSupportQueryFromServer treeDeltaSupportQueryOut;
+
+        /// @brief Message from client, saying it can apply deltas.
+        messages::TreeDeltaSupportToServer treeDeltaSupportIn;
+
+        OSVR_COMMON_EXPORT void sendTreeDeltaSupportQuery(uint32_t query);
+
+        typedef std::function<void(uint32_t query)>
+            TreeDeltaSupportHandler;
+        OSVR_COMMON_EXPORT void
+        registerTreeDeltaSupportHandler(TreeDeltaSupportHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDelta(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDeltaSupportQuery(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDeltaSupport(void *userdata, vrpn_HANDLERPARAM p);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_treeDeltaHandlers;
+        std::vector<TreeDeltaSupportHandler> m_treeDeltaSupportHandlers;
     };
 } // namespace common
 } // namespace osvr
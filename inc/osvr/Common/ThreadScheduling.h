@@ -0,0 +1,115 @@
+/** @file
+    @brief Header declaring real-time scheduling and CPU affinity
+    configuration for the server's latency-sensitive threads.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ThreadScheduling_h_GUID_7A297CF9_B22C_4E0F_97D0_5A52E45161B6
+#define INCLUDED_ThreadScheduling_h_GUID_7A297CF9_B22C_4E0F_97D0_5A52E45161B6
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    enum class SchedulingPolicy {
+        /// Leave the thread's scheduling policy and priority untouched.
+        Default,
+        /// SCHED_FIFO
+        Fifo,
+        /// SCHED_RR
+        RoundRobin
+    };
+
+    /// @brief Scheduling to apply to a thread: everything left at its
+    /// default is left unchanged.
+    struct ThreadSchedulingConfig {
+        SchedulingPolicy policy = SchedulingPolicy::Default;
+        /// @brief Real-time priority (1-99 on Linux), clamped to the range
+        /// the policy allows. Ignored for SchedulingPolicy::Default.
+        int priority = 1;
+        /// @brief Indices of the CPUs the thread may run on: empty means no
+        /// change in affinity.
+        std::vector<int> cpus;
+
+        bool isDefault() const {
+            return policy == SchedulingPolicy::Default && cpus.empty();
+        }
+    };
+
+    /// @brief The classes of thread that may be given their own scheduling.
+    enum class ThreadRole {
+        /// The server main loop.
+        ServerMainLoop,
+        /// Threads of async devices, running their update callbacks.
+        AsyncDevice,
+        /// Processing threads started by tracking plugins.
+        Tracker
+    };
+
+    /// @brief Parses a policy name ("default", "fifo", or "rr") into
+    /// policy.
+    /// @return false if the name was not recognized.
+    OSVR_COMMON_EXPORT bool parseSchedulingPolicy(std::string const &name,
+                                                  SchedulingPolicy &policy);
+
+    /// @brief Sets, process-wide, the scheduling that threads with the given
+    /// role will apply to themselves when they start. Call before the
+    /// server and its plugins start their threads.
+    OSVR_COMMON_EXPORT void
+    setThreadSchedulingConfig(ThreadRole role,
+                              ThreadSchedulingConfig const &config);
+
+    /// @brief Gets the scheduling configured for the given role.
+    OSVR_COMMON_EXPORT ThreadSchedulingConfig
+    getThreadSchedulingConfig(ThreadRole role);
+
+    /// @brief Applies the given scheduling to the calling thread.
+    ///
+    /// Real-time policies typically require elevated privileges (on Linux,
+    /// CAP_SYS_NICE or a non-zero RLIMIT_RTPRIO). Only Linux is supported:
+    /// on other platforms any non-default configuration fails, with an
+    /// "unsupported" error, and the thread is left unchanged.
+    ///
+    /// @param[out] error A description of what failed, if anything.
+    /// @return true if the configuration was fully applied (or was the
+    /// default).
+    OSVR_COMMON_EXPORT bool
+    applyThreadScheduling(ThreadSchedulingConfig const &config,
+                          std::string &error);
+
+    /// @brief Applies the scheduling configured for the role to the calling
+    /// thread, logging a warning on failure.
+    /// @return true if the configuration was fully applied (or was the
+    /// default).
+    OSVR_COMMON_EXPORT bool applyThreadScheduling(ThreadRole role);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ThreadScheduling_h_GUID_7A297CF9_B22C_4E0F_97D0_5A52E45161B6
@@ -78,6 +78,15 @@ namespace common {
                                       std::string const &string) {
             Policy::mark((fixedString + string).c_str());
         }
+
+        /// @brief If the tracing backend buffers events in-process (as on
+        /// non-Windows platforms), writes them to the named file as Chrome
+        /// trace-event JSON. Setting the environment variable
+        /// `OSVR_TRACE_FILE` does this automatically at process exit.
+        ///
+        /// @return false if not supported by this backend or the file could
+        /// not be written.
+        OSVR_COMMON_EXPORT bool dumpTrace(std::string const &filename);
 #else  // OSVR_COMMON_TRACING_ENABLED ^^ // vv !OSVR_COMMON_TRACING_ENABLED
         struct MainTracePolicy {
             static TraceBeginStamp begin(const char *) { return 0; }
@@ -101,6 +110,7 @@ namespace common {
         inline void driverUpdateEnd(TraceBeginStamp) {}
         template <typename Policy>
         inline void markConcatenation(const char *, std::string const &) {}
+        inline bool dumpTrace(std::string const &) { return false; }
 #endif // !OSVR_COMMON_TRACING_ENABLED
 
         // -- Common code between dummy implementation and real implementation
@@ -0,0 +1,98 @@
+/** @file
+    @brief Header declaring the message carrying a batch of tracker pose
+    reports.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerPoseBatch_h_GUID_567014C7_01BC_4CA6_99E7_54F4ECAA9802
+#define INCLUDED_TrackerPoseBatch_h_GUID_567014C7_01BC_4CA6_99E7_54F4ECAA9802
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/SerializationTraits.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/TrackerPoseBatchC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace serialization {
+        /// @brief Pose first, then timestamp and sensor: 72 bytes with no
+        /// alignment padding.
+        template <>
+        struct SimpleStructSerialization<OSVR_TrackerPoseBatchEntry>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.pose);
+                f(val.timestamp);
+                f(val.sensor);
+            }
+        };
+    } // namespace serialization
+
+    namespace messages {
+        /// @brief Message from a tracker server to its clients, carrying the
+        /// poses of several sensors at once, each with its own timestamp.
+        ///
+        /// Sent from the tracker device's own VRPN sender, alongside the
+        /// standard VRPN tracker messages.
+        class TrackerPoseBatch {
+          public:
+            /// @brief Entries per message: keeps a full message within a
+            /// single UDP datagram for the low-latency class of service.
+            /// Larger batches are split over several messages.
+            static const OSVR_ChannelCount MAX_ENTRIES_PER_MESSAGE = 16;
+
+            class MessageSerialization {
+              public:
+                MessageSerialization(OSVR_TrackerPoseBatchEntry const *entries,
+                                     OSVR_ChannelCount count)
+                    : m_entries(entries, entries + count) {}
+
+                MessageSerialization() {}
+
+                template <typename T> void processMessage(T &p) {
+                    p(m_entries);
+                }
+
+                std::vector<OSVR_TrackerPoseBatchEntry> const &
+                getEntries() const {
+                    return m_entries;
+                }
+
+              private:
+                std::vector<OSVR_TrackerPoseBatchEntry> m_entries;
+            };
+
+            OSVR_COMMON_EXPORT static const char *identifier();
+        };
+    } // namespace messages
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerPoseBatch_h_GUID_567014C7_01BC_4CA6_99E7_54F4ECAA9802
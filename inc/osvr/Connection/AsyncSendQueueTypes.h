@@ -0,0 +1,97 @@
+/** @file
+    @brief Header with the configuration and statistics types for the queued
+    send mode of asynchronous device tokens.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncSendQueueTypes_h_GUID_3B87BD65_2F70_461F_8DE0_2927E230A2C7
+#define INCLUDED_AsyncSendQueueTypes_h_GUID_3B87BD65_2F70_461F_8DE0_2927E230A2C7
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue_fwd.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief What to do when a device thread sends a message but its send
+    /// queue is already full.
+    enum class AsyncSendOverflowPolicy {
+        /// @brief Discard the oldest queued message to make room for the new
+        /// one.
+        DropOldest,
+        /// @brief Discard the new message, keeping what is already queued.
+        DropNewest,
+        /// @brief Like DropOldest on overflow, but additionally, when the
+        /// queue is drained, only the newest of the queued interface reports
+        /// (tracker, analog, etc.) of the same type and sensor is sent.
+        /// Suitable for state-style reports where only the latest value
+        /// matters. Raw messages are always sent.
+        Coalesce
+    };
+
+    /// @brief Function that sends a report on the server thread, given the
+    /// bytes captured when the device thread sent it (see
+    /// OSVR_DeviceTokenObject::sendReport()).
+    typedef void (*QueuedReportSender)(void *target,
+                                       util::time::TimeValue const &timestamp,
+                                       const char *report, std::size_t len);
+
+    /// @brief Coalescing key for reports that must never be collapsed into
+    /// a newer one.
+    static const uint32_t NO_COALESCE_KEY = 0xffffffff;
+
+    /// @brief Configuration for the queued send mode of an async device.
+    struct AsyncSendQueueConfig {
+        /// @brief Maximum number of messages held between server loop
+        /// iterations: rounded up to a power of two.
+        std::size_t capacity = 64;
+        AsyncSendOverflowPolicy policy = AsyncSendOverflowPolicy::DropOldest;
+    };
+
+    /// @brief Snapshot of the metrics of a device's send queue.
+    struct AsyncSendQueueStats {
+        /// @brief Number of messages queued at the time of the snapshot.
+        std::size_t depth = 0;
+        /// @brief Largest depth seen so far.
+        std::size_t highWaterMark = 0;
+        /// @brief Queue capacity.
+        std::size_t capacity = 0;
+        /// @brief Total messages accepted into the queue.
+        uint64_t enqueued = 0;
+        /// @brief Total messages forwarded to the connection.
+        uint64_t sent = 0;
+        /// @brief Total messages discarded due to overflow.
+        uint64_t dropped = 0;
+        /// @brief Total messages superseded by a newer message of the same
+        /// type while draining.
+        uint64_t coalesced = 0;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncSendQueueTypes_h_GUID_3B87BD65_2F70_461F_8DE0_2927E230A2C7
@@ -125,6 +125,19 @@ namespace connection {
         /// handlers.
         OSVR_CONNECTION_EXPORT void triggerDescriptorHandlers();
 
+        /// @brief Set a function that wakes whoever is calling process(), for
+        /// use by an event-driven main loop.
+        ///
+        /// Must be set before any devices start producing data: it is called
+        /// without synchronization from their threads.
+        OSVR_CONNECTION_EXPORT void
+        setWakeupHandler(std::function<void()> const &handler);
+
+        /// @brief Called (from any thread) when there is new work for
+        /// process() to do, such as queued data or a request to send from an
+        /// async device. Does nothing if no wakeup handler is set.
+        OSVR_CONNECTION_EXPORT void signalWakeup();
+
         /// @brief Destructor
         OSVR_CONNECTION_EXPORT virtual ~Connection();
 
@@ -203,6 +216,7 @@ namespace connection {
       private:
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
+        std::function<void()> m_wakeupHandler;
         util::log::LoggerPtr m_log;
     };
 } // namespace connection
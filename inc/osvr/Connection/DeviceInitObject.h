@@ -37,6 +37,7 @@
 #include <osvr/Connection/ServerInterfaceList.h>
 #include <osvr/Common/DeviceComponentPtr.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
+#include <osvr/Connection/AsyncSendQueueTypes.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -96,6 +97,12 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT void
     addComponent(osvr::common::DeviceComponentPtr const &comp);
 
+    /// @brief Requests that an async device created with these options
+    /// queue the data it sends, rather than blocking its thread until the
+    /// server main loop is ready for it.
+    OSVR_CONNECTION_EXPORT void setAsyncSendQueue(
+        osvr::connection::AsyncSendQueueConfig const &config);
+
     /// @brief A helper method to make a "device interface object" of
     /// user-designated type and apppropriate lifetime.
     template <typename T> T *makeInterfaceObject() {
@@ -148,6 +155,10 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     boost::optional<OSVR_ChannelCount> getAnalogs() const { return m_analogs; }
     boost::optional<OSVR_ChannelCount> getButtons() const { return m_buttons; }
     bool getTracker() const { return m_tracker; }
+    boost::optional<osvr::connection::AsyncSendQueueConfig> const &
+    getAsyncSendQueue() const {
+        return m_asyncSendQueue;
+    }
     osvr::connection::ServerInterfaceList const &getServerInterfaces() const {
         return m_serverInterfaces;
     }
@@ -169,6 +180,7 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     osvr::connection::TrackerServerInterface **m_trackerIface;
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     osvr::common::DeviceComponentList m_components;
+    boost::optional<osvr::connection::AsyncSendQueueConfig> m_asyncSendQueue;
     std::vector<OSVR_DeviceTokenObject **> m_tokenInterest;
 
     std::vector<osvr::connection::DeviceInterfaceBase *> m_deviceInterfaces;
@@ -50,6 +50,22 @@ namespace connection {
             return m_token->getSendGuard();
         }
 
+        /// @copydoc OSVR_DeviceTokenObject::sendReport()
+        bool sendReport(QueuedReportSender sender, void *target, uint32_t key,
+                        util::time::TimeValue const &timestamp,
+                        const char *report, size_t len) {
+            BOOST_ASSERT_MSG(m_token != nullptr, "Can't send a report "
+                                                 "before we've been supplied "
+                                                 "with a device token!");
+            return m_token->sendReport(sender, target, key, timestamp, report,
+                                       len);
+        }
+
+        /// @copydoc OSVR_DeviceTokenObject::hasSendQueue()
+        bool hasSendQueue() const {
+            return m_token != nullptr && m_token->hasSendQueue();
+        }
+
       private:
         DeviceToken *m_token = nullptr;
     };
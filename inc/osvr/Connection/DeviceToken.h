@@ -36,10 +36,12 @@
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/GuardPtr.h>
 #include <osvr/Connection/ServerInterfaceList.h>
+#include <osvr/Connection/AsyncSendQueueTypes.h>
 #include <osvr/Util/KeyedOwnershipContainer.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <string>
@@ -60,6 +62,9 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     /// @brief Creates a device token (and underlying ConnectionDevice) that
     /// has a wait callback that can block, that is called repeatedly in a
     /// thread of its own (managed by OSVR)
+    ///
+    /// If the init object requests a send queue, sendData calls from the
+    /// device thread are queued rather than blocking for the main thread.
     OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
     createAsyncDevice(osvr::connection::DeviceInitObject &init);
     /// @brief Creates a device token (and underlying ConnectionDevice) that
@@ -114,6 +119,31 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
 
     OSVR_CONNECTION_EXPORT osvr::util::GuardPtr getSendGuard();
 
+    /// @brief Send a report through an interface-specific path (such as a
+    /// VRPN server object) that writes straight into the connection.
+    ///
+    /// The report's bytes are passed to @p sender along with @p target:
+    /// immediately under the send guard, or, for an async device in queued
+    /// mode, from a copy in the send queue during the next
+    /// connectionInteract. With the coalesce policy, only the newest queued
+    /// report with the same sender, target, and @p key (usually the sensor,
+    /// or NO_COALESCE_KEY) is sent.
+    ///
+    /// @returns false if the report was neither sent nor queued.
+    OSVR_CONNECTION_EXPORT bool
+    sendReport(osvr::connection::QueuedReportSender sender, void *target,
+               uint32_t key, osvr::util::time::TimeValue const &timestamp,
+               const char *report, size_t len);
+
+    /// @brief Whether reports are queued rather than sent immediately.
+    OSVR_CONNECTION_EXPORT bool hasSendQueue() const;
+
+    /// @brief Get a snapshot of the send queue metrics, if this device token
+    /// has a send queue (only async devices in queued mode do).
+    OSVR_CONNECTION_EXPORT
+        boost::optional<osvr::connection::AsyncSendQueueStats>
+        getSendQueueStats() const;
+
     /// @brief Interact with connection. Only legal to end up in
     /// ConnectionDevice::sendData from within here somehow.
     void connectionInteract();
@@ -141,14 +171,25 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     OSVR_DeviceTokenObject(std::string const &name);
     osvr::connection::ConnectionPtr m_getConnection();
     osvr::connection::ConnectionDevicePtr m_getConnectionDevice();
+    /// @brief Let an event-driven main loop know this device has something
+    /// for connectionInteract to do.
+    void m_signalWakeup();
     virtual void
     m_setUpdateCallback(osvr::connection::DeviceUpdateCallback const &cb) = 0;
     virtual void m_sendData(osvr::util::time::TimeValue const &timestamp,
                             osvr::connection::MessageType *type,
                             const char *bytestream, size_t len) = 0;
     virtual osvr::util::GuardPtr m_getSendGuard() = 0;
+    /// @brief Default implementation sends immediately under the send
+    /// guard.
+    virtual bool m_sendReport(osvr::connection::QueuedReportSender sender,
+                              void *target, uint32_t key,
+                              osvr::util::time::TimeValue const &timestamp,
+                              const char *report, size_t len);
     virtual void m_connectionInteract() = 0;
     virtual void m_stopThreads();
+    virtual boost::optional<osvr::connection::AsyncSendQueueStats>
+    m_getSendQueueStats() const;
 
   private:
     void m_sharedInit(osvr::connection::DeviceInitObject &init);
@@ -29,6 +29,7 @@
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TrackerPoseBatchC.h>
 
 // Library/third-party includes
 // - none
@@ -79,6 +80,11 @@ namespace connection {
         sendAccelReport(OSVR_AngularAccelerationState const &val,
                         OSVR_ChannelCount sensor,
                         util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Sends the poses of several sensors, each with its own
+        /// timestamp, in as few messages as possible.
+        virtual void sendPoseBatch(OSVR_TrackerPoseBatchEntry const *entries,
+                                   OSVR_ChannelCount count) = 0;
     };
 
 } // namespace connection
@@ -189,6 +189,10 @@ osvrJointClientOptionsTriggerHardwareDetect(OSVR_JointClientOpts opts);
     operations will not be performed). Any exceptions thrown will cause the
    initialization to fail, returning a null context.
 
+    Hardware detection runs in the background, but initialization waits for
+    any requested at startup to finish. Detection triggered later does not
+    block osvrClientUpdate(): devices it finds show up in later updates.
+
     @returns Client context - will be needed for subsequent calls
 */
 OSVR_JOINTCLIENTKIT_EXPORT OSVR_ClientContext osvrJointClientInit(
@@ -0,0 +1,57 @@
+/** @file
+    @brief Header declaring an RAII guard for work that must be serialized
+    with the host's main loop.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HostThreadSection_h_GUID_FF828EF9_B138_480C_A29B_154F5BB55B75
+#define INCLUDED_HostThreadSection_h_GUID_FF828EF9_B138_480C_A29B_154F5BB55B75
+
+// Internal Includes
+#include <osvr/PluginHost/Export.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace pluginhost {
+    /// @brief RAII guard marking code that creates devices or otherwise
+    /// touches state owned by the host's main loop (the connection, the path
+    /// tree, plugin registration data).
+    ///
+    /// On a hardware detection worker thread, this holds the host lock (see
+    /// RegistrationContext::setHostLock()) for its lifetime, so the code runs
+    /// effectively in the host thread. On any other thread it does nothing.
+    /// Sections may nest.
+    class HostThreadSection : boost::noncopyable {
+      public:
+        OSVR_PLUGINHOST_EXPORT HostThreadSection();
+        OSVR_PLUGINHOST_EXPORT ~HostThreadSection();
+    };
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_HostThreadSection_h_GUID_FF828EF9_B138_480C_A29B_154F5BB55B75
@@ -0,0 +1,104 @@
+/** @file
+    @brief Header declaring a persistent cache of the plugins found in the
+    plugin search path.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PluginManifest_h_GUID_D1E1F97A_64C0_46F0_9341_4B2BE34D3DA6
+#define INCLUDED_PluginManifest_h_GUID_D1E1F97A_64C0_46F0_9341_4B2BE34D3DA6
+
+// Internal Includes
+#include <osvr/PluginHost/Export.h>
+#include <osvr/PluginHost/SearchPath.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+
+namespace osvr {
+namespace pluginhost {
+    /// @brief A cache, persisted as a JSON file, of the plugin files in each
+    /// search path directory.
+    ///
+    /// A directory whose modification time hasn't changed since it was last
+    /// listed (and wasn't modified around the time it was listed, when a
+    /// further change might not show in a coarse timestamp) is not scanned
+    /// again.
+    ///
+    /// Not thread-safe.
+    class PluginManifest : boost::noncopyable {
+      public:
+        /// @brief Constructor: loads the given manifest file if it exists and
+        /// is valid, otherwise starts empty.
+        ///
+        /// @param file Manifest file name: empty to keep the cache in memory
+        /// only.
+        /// @param ext Plugin file extension (including the leading period).
+        OSVR_PLUGINHOST_EXPORT PluginManifest(std::string const &file,
+                                              std::string const &ext);
+        OSVR_PLUGINHOST_EXPORT ~PluginManifest();
+
+        /// @brief Like getAllFilesWithExt() on the search path, with the
+        /// manifest's extension, but using cached directory listings where
+        /// still valid.
+        OSVR_PLUGINHOST_EXPORT FileList
+        getPluginFiles(SearchPath const &searchPaths);
+
+        /// @brief Like findPlugin(), but using cached directory listings where
+        /// still valid.
+        OSVR_PLUGINHOST_EXPORT std::string
+        findPlugin(SearchPath const &searchPaths,
+                   std::string const &pluginName);
+
+        /// @brief Writes the manifest file, if anything changed since it was
+        /// loaded or last saved.
+        ///
+        /// @returns false if writing failed.
+        OSVR_PLUGINHOST_EXPORT bool save();
+
+        /// @name Statistics
+        /// @{
+        /// @brief Number of directory listings served from the cache.
+        OSVR_PLUGINHOST_EXPORT std::size_t getDirectoriesCached() const;
+        /// @brief Number of directories actually scanned.
+        OSVR_PLUGINHOST_EXPORT std::size_t getDirectoriesScanned() const;
+        /// @}
+
+      private:
+        struct Impl;
+        unique_ptr<Impl> m_impl;
+    };
+
+    /// @brief Gets the file name to use for the plugin manifest: the value of
+    /// OSVR_PLUGIN_MANIFEST if set, otherwise a file in the per-user cache
+    /// directory. Returns an empty string if OSVR_PLUGIN_MANIFEST is set to
+    /// "0", disabling the persistent manifest.
+    OSVR_PLUGINHOST_EXPORT std::string getPluginManifestPath();
+
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_PluginManifest_h_GUID_D1E1F97A_64C0_46F0_9341_4B2BE34D3DA6
@@ -39,6 +39,7 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <functional>
 #include <string>
 #include <map>
 
@@ -66,6 +67,11 @@ namespace pluginhost {
 
         /// @brief Load all detected plugins except those with a .manualload
         /// suffix
+        ///
+        /// Plugins are found using the plugin manifest (see PluginManifest)
+        /// and loaded on up to a few threads at once (OSVR_PLUGIN_LOAD_THREADS
+        /// overrides the number), then registered in search path order. Must
+        /// not be called with the host lock held.
         OSVR_PLUGINHOST_EXPORT void loadPlugins();
 
         /// @brief Assume ownership of a plugin-specific registration context
@@ -73,9 +79,40 @@ namespace pluginhost {
         OSVR_PLUGINHOST_EXPORT void
         adoptPluginRegistrationContext(PluginRegPtr ctx);
 
-        /// @brief Trigger any registered hardware detect callbacks.
+        /// @brief Trigger any registered hardware detect callbacks, running
+        /// them in the calling thread.
         OSVR_PLUGINHOST_EXPORT void triggerHardwareDetect();
 
+        /// @name Background hardware detection
+        /// @{
+        /// @brief Ask for a pass of the registered hardware detect callbacks
+        /// to be run on worker threads, returning immediately.
+        ///
+        /// The plugins' callbacks run concurrently with each other and with
+        /// the caller. Requests made while a pass is pending or running are
+        /// coalesced, and passes are rate-limited. Device creation in the
+        /// callbacks is serialized with the host via the host lock.
+        OSVR_PLUGINHOST_EXPORT void requestHardwareDetect();
+
+        /// @brief Set the functions locking and unlocking the host's main
+        /// loop, held by hardware detection and plugin loading workers while
+        /// they create devices (see HostThreadSection). Must be called before
+        /// the first requestHardwareDetect() if the host runs concurrently
+        /// with it.
+        OSVR_PLUGINHOST_EXPORT void
+        setHostLock(std::function<void()> const &lock,
+                    std::function<void()> const &unlock);
+
+        /// @brief Block until no requested hardware detection pass is
+        /// pending or running. Must not be called with the host lock held.
+        OSVR_PLUGINHOST_EXPORT void waitForHardwareDetect();
+
+        /// @brief Stop background hardware detection, letting callbacks
+        /// already running finish: later requests are ignored. Must not be
+        /// called with the host lock held. Called by the destructor.
+        OSVR_PLUGINHOST_EXPORT void shutdownHardwareDetect();
+        /// @}
+
         /// @brief Call a driver instantiation callback for the given plugin
         /// name and driver name.
         /// @throws std::runtime_error if the plugin named hasn't been loaded,
@@ -245,6 +245,44 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                                OSVR_OUT_PTR OSVR_DeviceToken *device)
     OSVR_FUNC_NONNULL((1, 2, 3, 4));
 
+/** @brief Policies for handling a full send queue in an asynchronous device
+    using osvrDeviceAsyncSetSendQueue().
+*/
+typedef enum OSVR_AsyncSendOverflowPolicy {
+    /** @brief Discard the oldest queued message to make room. */
+    OSVR_ASYNC_SEND_DROP_OLDEST = 0,
+    /** @brief Discard the message being sent. */
+    OSVR_ASYNC_SEND_DROP_NEWEST = 1,
+    /** @brief Discard the oldest on overflow, and also only forward the
+        newest of the queued interface reports of the same type and sensor.
+        Data sent with osvrDeviceSendData() is never coalesced. */
+    OSVR_ASYNC_SEND_COALESCE = 2
+} OSVR_AsyncSendOverflowPolicy;
+
+/** @brief Request that an asynchronous device created with these options
+    queue its sent data instead of blocking.
+
+    By default, a send from an asynchronous device's thread blocks until the
+    server main loop gets around to servicing that device. With a send queue,
+    data sent with osvrDeviceSendData() and osvrDeviceSendTimestampedData(),
+    as well as tracker, button, analog, and imaging reports (except
+    acquire/commit frames), is instead copied into a bounded queue that the
+    server drains each time through its main loop, so the device thread
+    returns immediately.
+
+    Only meaningful with osvrDeviceAsyncInitWithOptions().
+
+    @param options The DeviceInitOptions for your device.
+    @param capacity Maximum number of messages held (rounded up to a power of
+    two).
+    @param policy What to do when a message is sent with the queue full.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceAsyncSetSendQueue(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                            OSVR_IN size_t capacity,
+                            OSVR_IN OSVR_AsyncSendOverflowPolicy policy)
+    OSVR_FUNC_NONNULL((1));
+
 /** @} */
 
 /** @brief Request a thread sleep for at least the given number of microseconds.
@@ -111,6 +111,41 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Configures how frames are sent to clients over the
+        /// network: see osvrDeviceImagingSetWireOptions(). Call before
+        /// sending any frames.
+        void setWireOptions(bool chunking,
+                            OSVR_ImagingWireCompression compression =
+                                OSVR_IMAGING_WIRE_COMPRESSION_NONE,
+                            uint32_t maxBytesPerSecond = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingSetWireOptions(
+                m_iface, chunking ? OSVR_TRUE : OSVR_FALSE, compression,
+                maxBytesPerSecond);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not set imaging wire options!");
+            }
+        }
+
+        /// @brief Selects lock-free shared memory for frames: see
+        /// osvrDeviceImagingSetSharedMemoryLockFree(). Call before sending
+        /// any frames.
+        void setSharedMemoryLockFree(bool lockFree) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingSetSharedMemoryLockFree(
+                m_iface, lockFree ? OSVR_TRUE : OSVR_FALSE);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error(
+                    "Could not set imaging shared memory mode!");
+            }
+        }
+
         /// @brief Send method - usually called by
         /// osvr::pluginkit::DeviceToken::send()
         void send(DeviceToken &dev, ImagingMessage const &message,
@@ -120,17 +155,8 @@ namespace pluginkit {
                     "Must initialize the imaging interface before using it!");
             }
             cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
-            OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
-            metadata.depth = static_cast<OSVR_ImageDepth>(typedata.getSize());
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
-            metadata.type = typedata.isFloatingPoint()
-                                ? OSVR_IVT_FLOATING_POINT
-                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
-                                                       : OSVR_IVT_UNSIGNED_INT);
+            OSVR_ImagingMetadata metadata =
+                m_computeMetadata(frame.size(), frame.type());
 
             OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
                 dev, m_iface, metadata, message.getBuf(), message.getSensor(),
@@ -140,7 +166,58 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Zero-copy alternative to send(): gets a cv::Mat header of
+        /// the given size and type wrapping a buffer owned by the imaging
+        /// interface (directly in shared memory, if lock-free). Fill it in
+        /// place (e.g. as the destination of your decode or color
+        /// conversion), then call commitFrame(). The returned cv::Mat must not
+        /// be used after that, nor should it be reallocated by the operations
+        /// filling it.
+        cv::Mat acquireFrame(DeviceToken &dev, cv::Size size, int type,
+                             OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ImageBufferElement *buf = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingAcquireFrame(
+                dev, m_iface, m_computeMetadata(size, type), sensor, &buf);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not acquire imaging buffer!");
+            }
+            return cv::Mat(size, type, buf);
+        }
+
+        /// @brief Publishes the frame most recently returned by
+        /// acquireFrame() for the given sensor.
+        void commitFrame(DeviceToken &dev, OSVR_TimeValue const &timestamp,
+                         OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingCommitFrame(dev, m_iface, sensor, &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not commit imaging buffer!");
+            }
+        }
+
       private:
+        static OSVR_ImagingMetadata m_computeMetadata(cv::Size size,
+                                                      int type) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(type);
+            OSVR_ImagingMetadata metadata;
+            metadata.channels = CV_MAT_CN(type);
+            metadata.depth = static_cast<OSVR_ImageDepth>(typedata.getSize());
+            metadata.width = size.width;
+            metadata.height = size.height;
+            metadata.type = typedata.isFloatingPoint()
+                                ? OSVR_IVT_FLOATING_POINT
+                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
+                                                       : OSVR_IVT_UNSIGNED_INT);
+            return metadata;
+        }
         OSVR_ImagingDeviceInterface m_iface;
     };
     /// @}
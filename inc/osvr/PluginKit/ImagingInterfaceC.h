@@ -31,6 +31,7 @@
 
 /* Internal Includes */
 #include <osvr/PluginKit/DeviceInterfaceC.h>
+#include <osvr/Util/BoolC.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
 
@@ -74,6 +75,55 @@ OSVR_ReturnCode osvrDeviceImagingConfigure(
     OSVR_IN OSVR_ChannelCount numSensors OSVR_CPP_ONLY(= 1))
     OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Encodings for frames sent over the network (rather than through
+    shared memory) in chunks: see osvrDeviceImagingSetWireOptions().
+*/
+typedef enum OSVR_ImagingWireCompression {
+    /** @brief Raw image bytes. */
+    OSVR_IMAGING_WIRE_COMPRESSION_NONE = 0,
+    /** @brief Run-length encoding of each chunk that it makes smaller: well
+        suited to mostly-dark frames such as those of IR tracking cameras. */
+    OSVR_IMAGING_WIRE_COMPRESSION_RUN_LENGTH = 1
+} OSVR_ImagingWireCompression;
+
+/** @brief Configure how frames are sent to clients over the network, which
+    otherwise only receive frames small enough for a single message. Local
+    clients read frames from shared memory and are not affected.
+
+    Call right after osvrDeviceImagingConfigure(), before any frames are
+    reported.
+
+    @param iface Imaging interface
+    @param chunking Whether frames too large for a single message (or all
+    frames, with compression) may be split into a series of chunks.
+    @param compression Encoding of chunked frames.
+    @param maxBytesPerSecond Frames that would exceed this many (uncompressed)
+    bytes per second over the network are not sent there: 0 for no limit.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingSetWireOptions(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_CBool chunking,
+    OSVR_IN OSVR_ImagingWireCompression compression,
+    OSVR_IN uint32_t maxBytesPerSecond) OSVR_FUNC_NONNULL((1));
+
+/** @brief Select whether the shared memory that local clients read frames
+    from is lock-free. By default, reporting a frame may wait for clients that
+    are still reading an older frame from the slot being reused. In lock-free
+    mode it never waits, and a client that gets overtaken simply misses that
+    frame.
+
+    Call right after osvrDeviceImagingConfigure(), before any frames are
+    reported.
+
+    @param iface Imaging interface
+    @param lockFree Whether to use lock-free shared memory.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingSetSharedMemoryLockFree(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_CBool lockFree) OSVR_FUNC_NONNULL((1));
+
 /** @brief Report a frame for a sensor. Takes ownership of the buffer and
     **frees it with the `osvrAlignedFree` function** when done, so for stability
     only pass in memory allocated by `osvrAlignedAlloc`. The C++ wrapper for
@@ -96,6 +146,51 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Acquire a buffer to fill in place with a frame for a sensor,
+    avoiding the copy made by osvrDeviceImagingReportFrame(). With lock-free
+    shared memory (see osvrDeviceImagingSetSharedMemoryLockFree()), this buffer
+    is the actual shared-memory slot that clients will read from.
+
+    The buffer remains owned by the imaging interface: fill it, then call
+    osvrDeviceImagingCommitFrame() for the same sensor before acquiring another
+    buffer for that sensor. Do not access the buffer after committing it.
+    Acquiring again without committing abandons the previous buffer: none of
+    its contents are published.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Metadata of the image that will be placed in the buffer:
+    determines the buffer size.
+    @param sensor Sensor number, usually 0
+    @param [out] buffer Receives a pointer to a buffer of at least
+    height * width * channels * depth bytes, aligned to at least
+    OSVR_DEFAULT_ALIGN_SIZE.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingAcquireFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                              OSVR_IN OSVR_ImagingMetadata metadata,
+                              OSVR_IN OSVR_ChannelCount sensor,
+                              OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
+/** @brief Publish the frame most recently acquired for a sensor with
+    osvrDeviceImagingAcquireFrame().
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 4));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
@@ -156,6 +156,23 @@ osvrPluginLog(OSVR_INOUT_PTR OSVR_PluginRegContext ctx,
               OSVR_IN OSVR_LogLevel severity, OSVR_IN const char *message)
     OSVR_FUNC_NONNULL((1, 3));
 
+/**
+ * @brief Apply the real-time scheduling and CPU affinity the server was
+ * configured with for tracker threads (if any) to the calling thread.
+ *
+ * Call at the start of latency-sensitive processing threads your plugin
+ * creates. On Linux, threads they go on to create inherit the settings.
+ *
+ * Only supported on Linux: on other platforms, if the server was configured
+ * with tracker thread settings, this logs that they are unsupported and
+ * returns OSVR_RETURN_FAILURE without changing the thread.
+ *
+ * @return OSVR_RETURN_FAILURE if a configuration was given but could not be
+ * fully applied (details are logged).
+ */
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrPluginApplyTrackerThreadScheduling(void);
+
 OSVR_EXTERN_C_END
 
 /** @} */
@@ -33,6 +33,7 @@
 #include <osvr/PluginKit/DeviceInterfaceC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/TrackerPoseBatchC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -89,6 +90,23 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the full rigid body poses of several sensors at once, each
+   with its own timestamp.
+
+   Equivalent to calling osvrDeviceTrackerSendPoseTimestamped() for each entry,
+   but much cheaper for devices with many sensors: the poses are sent together
+   (in as few messages as possible) in a single call to the host.
+
+   @param entries Array of @p count sensor, pose, and timestamp entries.
+   @param count Number of entries.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendPoseBatch(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_TrackerPoseBatchEntry const *entries,
+    OSVR_IN OSVR_ChannelCount count) OSVR_FUNC_NONNULL((1, 2, 3));
+
 /** @brief Report the position of a sensor that doesn't report orientation,
    automatically generating a timestamp.
 */
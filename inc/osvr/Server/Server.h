@@ -116,8 +116,18 @@ namespace server {
 
         /// @brief If you aren't using a separate thread for the server, this
         /// method will run a single update of the server.
+        ///
+        /// Triggered hardware detection runs in the background, without
+        /// blocking this call: devices it finds show up during later updates.
         OSVR_SERVER_EXPORT void update();
 
+        /// @overload
+        ///
+        /// Also calls @p andThen after the update, still holding off
+        /// hardware detection workers, for in-process code that services the
+        /// server's connection (such as a joint client).
+        OSVR_SERVER_EXPORT void update(MainloopMethod const &andThen);
+
         /// @brief Launch a thread running the server.
         ///
         /// @throws std::logic_error if called after the server has stopped.
@@ -176,9 +186,20 @@ namespace server {
 
         /// @brief Run all hardware detect callbacks.
         ///
+        /// The callbacks run on worker threads, starting on the next server
+        /// loop iteration, without stalling the loop; repeated triggers are
+        /// coalesced and rate-limited.
+        ///
         /// Safe to call from any thread, even when server is running.
         OSVR_SERVER_EXPORT void triggerHardwareDetect();
 
+        /// @brief Block until any hardware detection triggered so far has
+        /// finished, so the devices it creates are seen by the next update().
+        ///
+        /// Meant for the startup of hosts that call update() themselves: not
+        /// to be called from within the server's main loop.
+        OSVR_SERVER_EXPORT void waitForHardwareDetect();
+
         /// @brief Register a method to run during every time through the main
         /// loop.
         ///
@@ -242,6 +263,25 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Switches the server loop between sleeping a fixed time each
+        /// iteration (the default) and an event-driven mode where it waits for
+        /// a wakeup signal instead.
+        ///
+        /// In event-driven mode, data from async devices, requests made from
+        /// other threads, and signalWakeup() calls are serviced immediately.
+        /// The sleep time then only bounds how long network traffic and sync
+        /// devices wait while a client is connected; with no clients, the
+        /// server waits much longer between iterations. Only available on
+        /// Linux: elsewhere, this logs a warning and has no effect.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setEventDriven(bool eventDriven);
+
+        /// @brief Wakes the server loop early in event-driven mode (a no-op
+        /// otherwise). Safe to call from any thread, including mainloop
+        /// methods that have more work pending.
+        OSVR_SERVER_EXPORT void signalWakeup();
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
@@ -35,6 +35,8 @@
 // - none
 
 // Standard includes
+#include <cstddef>
+#include <cstdint>
 #include <memory> // for std::shared_ptr
 #include <string> // for std::string
 #include <vector> // for std::vector
@@ -55,6 +57,22 @@ namespace osvr {
 namespace util {
     namespace log {
         class filter_sink;
+        class async_sink;
+
+        /// @brief Statistics of the queue between logging threads and the
+        /// thread writing to the log sinks.
+        struct LogQueueStats {
+            /// Messages currently queued.
+            std::size_t depth = 0;
+            /// Most messages ever queued at once.
+            std::size_t highWaterMark = 0;
+            std::size_t capacity = 0;
+            /// Messages queued in total.
+            std::uint64_t enqueued = 0;
+            /// Messages discarded because the queue was full (warnings and
+            /// above are written synchronously instead, so never counted).
+            std::uint64_t dropped = 0;
+        };
 
         class LogRegistry {
           public:
@@ -121,6 +139,19 @@ namespace util {
 
             bool couldOpenLogFile() const { return sinks_.size() > 1; }
 
+            /**
+             * @brief Whether log messages are written by a background thread
+             * (only if the environment variable OSVR_LOG_ASYNC is set, to
+             * anything other than 0).
+             */
+            bool isAsync() const { return static_cast<bool>(async_sink_); }
+
+            /**
+             * @brief Gets the statistics of the asynchronous logging queue
+             * (all zero if not asynchronous).
+             */
+            OSVR_UTIL_EXPORT LogQueueStats getAsyncQueueStats() const;
+
           protected:
             OSVR_UTIL_EXPORT LogRegistry(std::string const &logFileBaseName);
             OSVR_UTIL_EXPORT ~LogRegistry();
@@ -129,11 +160,16 @@ namespace util {
             void setLevelImpl(LogLevel severity);
             void setConsoleLevelImpl(LogLevel severity);
             void createFileSink();
+            LogLevel getEffectiveLevel() const;
             LogLevel minLevel_;
             LogLevel consoleLevel_;
 
             std::vector<spdlog::sink_ptr> sinks_;
             std::shared_ptr<filter_sink> console_filter_;
+            std::shared_ptr<async_sink> async_sink_;
+            /// The sinks loggers are created with: either sinks_, or just
+            /// async_sink_ wrapping them.
+            std::vector<spdlog::sink_ptr> logger_sinks_;
             LoggerPtr consoleOnlyLog_;
             LoggerPtr generalLog_;
             Logger *generalPurposeLog_ = nullptr;
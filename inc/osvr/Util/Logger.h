@@ -38,6 +38,7 @@
 
 // Standard includes
 #include <initializer_list>
+#include <ios>     // for std::ios_base
 #include <memory>  // for std::shared_ptr
 #include <sstream> // for std::ostringstream
 #include <string>  // for std::string
@@ -120,21 +121,37 @@ namespace util {
             /// Set the log level at which this logger will trigger a flush.
             OSVR_UTIL_EXPORT void flushOn(LogLevel level);
 
+            /// Whether a message at the given level would currently be passed
+            /// on to the sinks. Cheap: check this before doing any expensive
+            /// work just to produce a log message.
+            OSVR_UTIL_EXPORT bool shouldLog(LogLevel level) const;
+
             /// An object returned the logging functions (including operator<<),
             /// serves to accumulate streamed output in a single ostringstream
             /// then write it to the logger at the end of the expression's
             /// lifetime.
+            ///
+            /// If the logger would discard a message of this level anyway, no
+            /// stream is created and anything streamed in is ignored without
+            /// being formatted.
             class StreamProxy {
               public:
                 StreamProxy(Logger &logger, LogLevel level)
                     : logger_(logger), level_(level),
-                      os_(new std::ostringstream) {}
+                      active_(logger.shouldLog(level)) {
+                    if (active_) {
+                        os_.reset(new std::ostringstream);
+                    }
+                }
 
                 StreamProxy(Logger &logger, LogLevel level,
                             const std::string &msg)
                     : logger_(logger), level_(level),
-                      os_(new std::ostringstream) {
-                    (*os_) << msg;
+                      active_(logger.shouldLog(level)) {
+                    if (active_) {
+                        os_.reset(new std::ostringstream);
+                        (*os_) << msg;
+                    }
                 }
 
                 /// destructor appends the finished stringstream at the end
@@ -155,18 +172,46 @@ namespace util {
                 StreamProxy(StreamProxy const &) = delete;
                 StreamProxy &operator=(StreamProxy const &) = delete;
 
-                operator std::ostream &() { return (*os_); }
-
-                template <typename T> std::ostream &operator<<(T &&what) {
-                    (*os_) << std::forward<T>(what);
+                /// Only when actually needed as a stream do we create one for
+                /// a filtered-out message: its contents will be discarded.
+                operator std::ostream &() {
+                    if (!os_) {
+                        os_.reset(new std::ostringstream);
+                    }
                     return (*os_);
                 }
 
+                template <typename T> StreamProxy &operator<<(T &&what) {
+                    if (active_) {
+                        (*os_) << std::forward<T>(what);
+                    }
+                    return *this;
+                }
+
+                /// @name Overloads for manipulators (like std::endl and
+                /// std::hex), which can't be deduced by the template above.
+                /// @{
+                StreamProxy &
+                operator<<(std::ostream &(*manip)(std::ostream &)) {
+                    if (active_) {
+                        manip(*os_);
+                    }
+                    return *this;
+                }
+                StreamProxy &
+                operator<<(std::ios_base &(*manip)(std::ios_base &)) {
+                    if (active_) {
+                        manip(*os_);
+                    }
+                    return *this;
+                }
+                /// @}
+
               private:
                 Logger &logger_;
                 LogLevel level_;
                 std::unique_ptr<std::ostringstream> os_;
-                bool active_ = true;
+                bool active_;
             };
 
             /// @name logger->info(msg) (with optional << "more message") call
@@ -0,0 +1,64 @@
+/** @file
+    @brief Header declaring the entries of a batch of tracker pose reports.
+
+    Must be c-safe!
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_TrackerPoseBatchC_h_GUID_15AEA50E_6304_453F_A8BA_B9604B2306A1
+#define INCLUDED_TrackerPoseBatchC_h_GUID_15AEA50E_6304_453F_A8BA_B9604B2306A1
+
+/* Internal Includes */
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+/* none */
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup PluginKit
+@{
+*/
+
+/** @brief One sensor's pose in a batch of tracker reports. */
+typedef struct OSVR_TrackerPoseBatchEntry {
+    /** @brief The sensor reporting the pose */
+    OSVR_ChannelCount sensor;
+    /** @brief The pose */
+    OSVR_PoseState pose;
+    /** @brief The time the pose was sampled */
+    OSVR_TimeValue timestamp;
+} OSVR_TrackerPoseBatchEntry;
+
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
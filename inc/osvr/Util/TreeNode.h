@@ -38,6 +38,7 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace osvr {
 namespace util {
@@ -49,6 +50,14 @@ namespace util {
             NoSuchChild(std::string const &name)
                 : std::runtime_error("No child found with the name " + name) {}
         };
+
+        /// @brief Number of children above which a node maintains a hash
+        /// index of its children by name, rather than searching linearly.
+        ///
+        /// Most nodes in a path tree have only a few children, where a linear
+        /// scan is as fast as hashing, but some (the device, interface, or
+        /// sensor levels of a busy server) may have very many.
+        static const std::size_t CHILD_INDEX_THRESHOLD = 8;
         /// @brief A node in a generic tree, which can contain an object by
         /// value.
         /// @tparam ValueType The contained value type: must be
@@ -66,8 +75,9 @@ namespace util {
         /// - A "get or create" method is provided that guarantees the return a
         /// child of the given name (default-constructing one if it doesn't
         /// exist)
+        /// - Children may be removed by name, destroying their subtree.
         ///
-        /// @todo methods to remove a child (by pointer and by name)
+        /// @todo method to remove a child by pointer
         template <typename ValueType>
         class TreeNode : boost::noncopyable,
                          boost::operators<TreeNode<ValueType> > {
@@ -110,6 +120,12 @@ namespace util {
             /// exist.
             type const &getChildByName(std::string const &name) const;
 
+            /// @brief Remove (and destroy) the named child and its
+            /// descendants, if it exists. References to the removed nodes are
+            /// invalidated.
+            /// @returns true if a child was removed.
+            bool removeChildByName(std::string const &name);
+
             /// @brief Gets the name of the current node. This will be empty if
             /// and
             /// only if this is the root.
@@ -197,6 +213,11 @@ namespace util {
             /// @brief Ownership of children
             ChildList m_children;
 
+            typedef std::unordered_map<std::string, weak_ptr_type> ChildIndex;
+            /// @brief Index of children by name: empty until there are more
+            /// than CHILD_INDEX_THRESHOLD children.
+            ChildIndex m_childIndex;
+
             /// @brief Name
             std::string const m_name;
 
@@ -267,6 +288,20 @@ namespace util {
             throw NoSuchChild(name);
         }
 
+        template <typename ValueType>
+        inline bool
+        TreeNode<ValueType>::removeChildByName(std::string const &name) {
+            auto it = std::find_if(
+                begin(m_children), end(m_children),
+                [&](ptr_type const &n) { return n->getName() == name; });
+            if (it == end(m_children)) {
+                return false;
+            }
+            m_childIndex.erase(name);
+            m_children.erase(it);
+            return true;
+        }
+
         template <typename ValueType>
         inline std::string const &TreeNode<ValueType>::getName() const {
             return m_name;
@@ -302,8 +337,11 @@ namespace util {
         template <typename ValueType>
         inline typename TreeNode<ValueType>::weak_ptr_type
         TreeNode<ValueType>::m_getChildByName(std::string const &name) const {
-            /// @todo Don't use a linear search here - use an unordered map or
-            /// something.
+            if (!m_childIndex.empty()) {
+                auto indexed = m_childIndex.find(name);
+                return indexed == end(m_childIndex) ? nullptr
+                                                    : indexed->second;
+            }
             auto it = std::find_if(
                 begin(m_children), end(m_children),
                 [&](ptr_type const &n) { return n->getName() == name; });
@@ -318,12 +356,21 @@ namespace util {
         inline void TreeNode<ValueType>::m_addChild(
             typename TreeNode<ValueType>::ptr_type const &child) {
             m_children.push_back(child);
+            if (!m_childIndex.empty()) {
+                m_childIndex.emplace(child->getName(), child.get());
+            } else if (m_children.size() > CHILD_INDEX_THRESHOLD) {
+                m_childIndex.reserve(m_children.size() * 2);
+                for (auto const &existing : m_children) {
+                    m_childIndex.emplace(existing->getName(), existing.get());
+                }
+            }
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name)
-            : m_value(), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(), m_children(), m_childIndex(), m_name(name),
+              m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -334,7 +381,8 @@ namespace util {
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name,
                                              ValueType const &val)
-            : m_value(val), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(val), m_children(), m_childIndex(), m_name(name),
+              m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -343,13 +391,15 @@ namespace util {
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode()
-            : m_value(), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(), m_children(), m_childIndex(), m_name(),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(ValueType const &val)
-            : m_value(val), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(val), m_children(), m_childIndex(), m_name(),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
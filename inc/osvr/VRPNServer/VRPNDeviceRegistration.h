@@ -89,6 +89,11 @@ namespace vrpnserver {
 
         /// @brief Get the vrpn_Connection object to use in constructing your
         /// object.
+        ///
+        /// If called from a hardware detect callback, the server loop is held
+        /// off from this call until the device is registered (see
+        /// pluginhost::HostThreadSection), since constructing a VRPN device
+        /// modifies the connection - so do any slow work beforehand.
         OSVR_VRPNSERVER_EXPORT vrpn_Connection *getVRPNConnection();
 
         /// @brief Registers your custom device with the server and takes
@@ -36,7 +36,9 @@
 
 // Standard includes
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
@@ -112,19 +114,10 @@ namespace vbtracker {
                 measRefs_.push_back(&meas);
             }
 
-            /// Do the O(n * m) distance computation to populate the vector that
-            /// will become our min-heap.
-            auto nMeas = measRefs_.size();
-            auto nLed = ledRefs_.size();
-            for (size_type measIdx = 0; measIdx < nMeas; ++measIdx) {
-                auto distThreshSquared =
-                    getDistanceThresholdSquared(*measRefs_[measIdx]);
-                for (size_type ledIdx = 0; ledIdx < nLed; ++ledIdx) {
-                    /// WARNING: watch the order of arguments to this function,
-                    /// since the type of the indices is identical...
-                    possiblyPushLedMeasurement(ledIdx, measIdx,
-                                               distThreshSquared);
-                }
+            /// Find the LED/measurement pairs within the distance threshold,
+            /// populating the vector that will become our min-heap.
+            if (!populateCandidatesFromGrid()) {
+                populateCandidatesExhaustively();
             }
             /// Turn that vector into our min-heap.
 
@@ -305,7 +298,7 @@ namespace vbtracker {
         }
 
         /// This is the size it could have potentially been, had all LEDs
-        /// been within the distance threshold. (O(n m))
+        /// been within the distance threshold.
         size_type theoreticalMaxSize() const {
             return leds_.size() * measurements_.size();
         }
@@ -399,6 +392,121 @@ namespace vbtracker {
         }
         /// @}
 
+        /// Below this many LED/measurement pairs, just checking them all is
+        /// cheaper than building the grid.
+        static const size_type MIN_PAIRS_FOR_GRID = 64;
+
+        /// The O(n * m) distance computation.
+        void populateCandidatesExhaustively() {
+            auto nMeas = measRefs_.size();
+            auto nLed = ledRefs_.size();
+            for (size_type measIdx = 0; measIdx < nMeas; ++measIdx) {
+                auto distThreshSquared =
+                    getDistanceThresholdSquared(*measRefs_[measIdx]);
+                for (size_type ledIdx = 0; ledIdx < nLed; ++ledIdx) {
+                    /// WARNING: watch the order of arguments to this function,
+                    /// since the type of the indices is identical...
+                    possiblyPushLedMeasurement(ledIdx, measIdx,
+                                               distThreshSquared);
+                }
+            }
+        }
+
+        using GridCell = std::pair<std::int32_t, std::int32_t>;
+        using GridEntry = std::pair<GridCell, size_type>;
+
+        /// Bins the LEDs into a uniform grid with cells as large as the
+        /// largest distance threshold, so each measurement need only be
+        /// compared against the LEDs in the 3x3 block of cells around it.
+        /// Produces exactly the same candidates, in the same order, as the
+        /// exhaustive search.
+        ///
+        /// @return false (having done nothing) if the grid wasn't worth
+        /// building or couldn't represent the input.
+        bool populateCandidatesFromGrid() {
+            auto nMeas = measRefs_.size();
+            auto nLed = ledRefs_.size();
+            if (nMeas * nLed < MIN_PAIRS_FOR_GRID) {
+                return false;
+            }
+            float cellSize = 0;
+            for (auto &meas : measRefs_) {
+                cellSize = std::max(cellSize, blobMoveThreshFactor_ *
+                                                  meas->diameter);
+            }
+            if (!(cellSize > 0)) {
+                /// Nothing can be strictly closer than a zero threshold.
+                return true;
+            }
+            if (!std::isfinite(cellSize)) {
+                return false;
+            }
+            /// A little slack so rounding can't push a pair just within the
+            /// threshold two cells apart.
+            cellSize *= 1.01f;
+            /// Grid cell coordinates must fit comfortably in our integers.
+            static const float MAX_CELL_COORD = 1 << 20;
+            const auto invCellSize = 1.f / cellSize;
+            auto toCell = [&](cv::Point2f const &pt, GridCell &cell) {
+                auto x = std::floor(pt.x * invCellSize);
+                auto y = std::floor(pt.y * invCellSize);
+                if (!(std::abs(x) < MAX_CELL_COORD &&
+                      std::abs(y) < MAX_CELL_COORD)) {
+                    return false;
+                }
+                cell = GridCell(static_cast<std::int32_t>(x),
+                                static_cast<std::int32_t>(y));
+                return true;
+            };
+
+            gridEntries_.clear();
+            gridEntries_.reserve(nLed);
+            for (size_type ledIdx = 0; ledIdx < nLed; ++ledIdx) {
+                GridCell cell;
+                if (!toCell(ledRefs_[ledIdx]->getLocation(), cell)) {
+                    return false;
+                }
+                gridEntries_.emplace_back(cell, ledIdx);
+            }
+            /// Sorted by cell, then LED index, so each cell is a contiguous
+            /// run we can find by binary search.
+            std::sort(begin(gridEntries_), end(gridEntries_));
+
+            auto cellLess = [](GridEntry const &entry, GridCell const &cell) {
+                return entry.first < cell;
+            };
+            for (size_type measIdx = 0; measIdx < nMeas; ++measIdx) {
+                auto meas = measRefs_[measIdx];
+                GridCell center;
+                if (!toCell(meas->loc, center)) {
+                    /// Too far out to be near any of the LEDs.
+                    continue;
+                }
+                auto distThreshSquared = getDistanceThresholdSquared(*meas);
+                candidateLeds_.clear();
+                for (std::int32_t dx = -1; dx <= 1; ++dx) {
+                    for (std::int32_t dy = -1; dy <= 1; ++dy) {
+                        GridCell cell(center.first + dx, center.second + dy);
+                        auto it =
+                            std::lower_bound(begin(gridEntries_),
+                                             end(gridEntries_), cell, cellLess);
+                        for (; it != end(gridEntries_) && it->first == cell;
+                             ++it) {
+                            candidateLeds_.push_back(it->second);
+                        }
+                    }
+                }
+                /// Keep the exhaustive search's order, so that ties in the
+                /// heap are broken the same way.
+                std::sort(begin(candidateLeds_), end(candidateLeds_));
+                for (auto ledIdx : candidateLeds_) {
+                    possiblyPushLedMeasurement(ledIdx, measIdx,
+                                               distThreshSquared);
+                }
+            }
+            return true;
+        }
+
         void possiblyPushLedMeasurement(std::size_t ledIdx, std::size_t measIdx,
                                         float distThreshSquared) {
             auto meas = measRefs_[measIdx];
@@ -469,7 +577,7 @@ namespace vbtracker {
         };
 
         void makeHeap() {
-            /// cost of 3 * len, which is O(n m)
+            /// cost of 3 * len, linear in the number of candidate pairs
             /// Paid once, at the end of populateStructures()
             std::make_heap(begin(distanceHeap_), end(distanceHeap_),
                            Comparator());
@@ -491,6 +599,11 @@ namespace vbtracker {
         std::vector<LedIter> ledRefs_;
         std::vector<MeasPtr> measRefs_;
         HeapType distanceHeap_;
+        /// @name Spatial index scratch storage
+        /// @{
+        std::vector<GridEntry> gridEntries_;
+        std::vector<size_type> candidateLeds_;
+        /// @}
         size_type numMatches_ = 0;
         LedGroup &leds_;
         LedMeasurementVec const &measurements_;
@@ -140,6 +140,34 @@ namespace vbtracker {
         /// decide (that is, not set an explicit preference)
         int numThreads = 1;
 
+        /// Whether to run the pose estimation of the bodies that got beacon
+        /// measurements in a frame concurrently, on a pool of worker threads
+        /// sized to the hardware, rather than one after another. Results are
+        /// merged in the same order as the serial path, so the reported
+        /// bodies don't change. Only worthwhile with several bodies in view.
+        bool parallelBodyUpdate = false;
+
+        /// How many video frames may be in flight between capture and pose
+        /// estimation. 1 keeps capture, blob extraction, and pose estimation
+        /// in lock step. Larger values let the image processing thread grab
+        /// and extract blobs from the next frames while the tracker thread is
+        /// still estimating poses, queuing up to this many less one finished
+        /// frames, delivered in timestamp order.
+        int imagePipelineDepth = 1;
+
+        /// Whether, once targets are being tracked, to only search for blobs
+        /// in windows around where the tracked beacons are predicted to
+        /// appear, rather than across the whole frame.
+        bool roiBlobExtraction = false;
+
+        /// Half the width/height, in pixels, of the window searched around
+        /// each predicted beacon location when roiBlobExtraction is enabled.
+        int roiHalfSize = 32;
+
+        /// When roiBlobExtraction is enabled, scan the full frame at least
+        /// this often (in frames), so new or re-appearing targets are found.
+        int roiFullFrameInterval = 15;
+
         /// This is the autocorrelation kernel of the process noise. The first
         /// three elements correspond to position, the second three to
         /// incremental rotation.
@@ -207,6 +235,12 @@ namespace vbtracker {
         /// measurements with a "bad" residual
         double highResidualVariancePenalty = 7.513691210865344;
 
+        /// When true, the Kalman estimator gates all the beacons seen in a
+        /// frame against the same predicted state and applies them in a
+        /// single stacked correction, rather than one (shuffled) beacon at a
+        /// time. Cheaper per frame and independent of beacon order.
+        bool batchedBeaconCorrection = false;
+
         /// When true, will stream debug info (variance, pixel measurement,
         /// pixel residual) on up to the first 34 beacons of your first sensor
         /// as analogs.
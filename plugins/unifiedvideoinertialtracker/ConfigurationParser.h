@@ -158,6 +158,15 @@ namespace vbtracker {
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
         getOptionalParameter(config.numThreads, root, "numThreads");
+        getOptionalParameter(config.parallelBodyUpdate, root,
+                             "parallelBodyUpdate");
+        getOptionalParameter(config.imagePipelineDepth, root,
+                             "imagePipelineDepth");
+        getOptionalParameter(config.roiBlobExtraction, root,
+                             "roiBlobExtraction");
+        getOptionalParameter(config.roiHalfSize, root, "roiHalfSize");
+        getOptionalParameter(config.roiFullFrameInterval, root,
+                             "roiFullFrameInterval");
         getOptionalParameter(config.cameraMicrosecondsOffset, root,
                              "cameraMicrosecondsOffset");
         getOptionalParameter(config.streamBeaconDebugInfo, root,
@@ -193,6 +202,8 @@ namespace vbtracker {
                              "measurementVarianceScaleFactor");
         getOptionalParameter(config.highResidualVariancePenalty, root,
                              "highResidualVariancePenalty");
+        getOptionalParameter(config.batchedBeaconCorrection, root,
+                             "batchedBeaconCorrection");
 #if 0
         getOptionalParameter(config.boundingBoxFilterRatio, root,
                              "boundingBoxFilterRatio");
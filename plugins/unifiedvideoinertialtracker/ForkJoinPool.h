@@ -0,0 +1,172 @@
+/** @file
+    @brief Header for a small persistent pool of worker threads running
+   fork-join loops.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ForkJoinPool_h_GUID_3F0D7C2A_8E4B_4C55_9A61_2B7E5D9C10F4
+#define INCLUDED_ForkJoinPool_h_GUID_3F0D7C2A_8E4B_4C55_9A61_2B7E5D9C10F4
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Threads that stay alive between calls to run(), so that
+    /// splitting a few small jobs across cores every frame doesn't pay for
+    /// thread creation each time.
+    class ForkJoinPool : boost::noncopyable {
+      public:
+        using Job = std::function<void(std::size_t)>;
+
+        /// @brief One worker per hardware thread beyond the caller's own.
+        static std::size_t defaultWorkerCount() {
+            auto hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 1;
+        }
+
+        explicit ForkJoinPool(std::size_t numWorkers = defaultWorkerCount()) {
+            m_threads.reserve(numWorkers);
+            for (std::size_t i = 0; i < numWorkers; ++i) {
+                m_threads.emplace_back([&] { m_workerLoop(); });
+            }
+        }
+
+        ~ForkJoinPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_start.notify_all();
+            for (auto &thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        /// @brief Calls job(i) for each i in [0, n), spread over as many
+        /// workers as useful plus the calling thread, returning once all are
+        /// done. Rethrows the first exception thrown by a call.
+        void run(std::size_t n, Job const &job) {
+            if (n == 0) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = &job;
+                m_count = n;
+                m_next = 0;
+                m_error = nullptr;
+                m_openSlots = std::min(n - 1, m_threads.size());
+                m_busy = m_openSlots;
+                ++m_generation;
+            }
+            m_start.notify_all();
+            m_work();
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [&] { return m_busy == 0; });
+                m_job = nullptr;
+                error = m_error;
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+      private:
+        void m_workerLoop() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            std::size_t seen = 0;
+            for (;;) {
+                m_start.wait(lock, [&] {
+                    return m_stopping ||
+                           (m_generation != seen && m_openSlots > 0);
+                });
+                if (m_stopping) {
+                    return;
+                }
+                seen = m_generation;
+                --m_openSlots;
+                lock.unlock();
+                m_work();
+                lock.lock();
+                if (--m_busy == 0) {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+        /// @brief Claims and runs indices until there are none left.
+        void m_work() {
+            for (;;) {
+                auto i = m_next.fetch_add(1);
+                if (i >= m_count) {
+                    return;
+                }
+                try {
+                    (*m_job)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        std::vector<std::thread> m_threads;
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        std::atomic<std::size_t> m_next{0};
+        /// @name Protected by m_mutex
+        /// @{
+        Job const *m_job = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_generation = 0;
+        /// @brief Workers that may still join the current run.
+        std::size_t m_openSlots = 0;
+        /// @brief Workers that joined, or may join, and haven't finished.
+        std::size_t m_busy = 0;
+        std::exception_ptr m_error;
+        bool m_stopping = false;
+        /// @}
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_ForkJoinPool_h_GUID_3F0D7C2A_8E4B_4C55_9A61_2B7E5D9C10F4
@@ -33,10 +33,16 @@
 #include <osvr/Util/Finally.h>
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 
 namespace osvr {
 namespace vbtracker {
+    static inline std::size_t getPipelineDepth(TrackingSystem const &sys) {
+        return static_cast<std::size_t>(
+            std::max(sys.getParams().imagePipelineDepth, 1));
+    }
+
     ImageProcessingThread::ImageProcessingThread(
         TrackingSystem &trackingSystem, ImageSource &cam,
         TrackerThread &trackerThread, CameraParameters const &camParams,
@@ -44,7 +50,12 @@ namespace vbtracker {
         : trackingSystem_(trackingSystem), cam_(cam),
           trackerThreadObj_(trackerThread), camParams_(camParams),
           cameraUsecOffset_(cameraUsecOffset),
-          logBlobs_(trackingSystem_.getParams().logRawBlobs) {
+          logBlobs_(trackingSystem_.getParams().logRawBlobs),
+          pipelineDepth_(getPipelineDepth(trackingSystem)),
+          /// the folly queue holds one less than its size, and needs a size
+          /// of at least 2.
+          frameQueue_(static_cast<std::uint32_t>(
+              std::max(pipelineDepth_, std::size_t(2)))) {
         if (logBlobs_) {
             blobFile_.open("blobs.csv");
             if (blobFile_) {
@@ -54,6 +65,20 @@ namespace vbtracker {
                 logBlobs_ = false;
             }
         }
+        if (pipelined()) {
+            msg() << "Image processing pipelined with a depth of "
+                  << pipelineDepth_ << std::endl;
+            /// Frames in flight, plus the one the tracker thread is working
+            /// on, plus the one the tracking system still caches.
+            auto numSlots = pipelineDepth_ + 2;
+            auto res = cam_.resolution();
+            framePool_.resize(numSlots);
+            grayPool_.resize(numSlots);
+            for (std::size_t i = 0; i < numSlots; ++i) {
+                framePool_[i].create(res, CV_8UC3);
+                grayPool_[i].create(res, CV_8UC1);
+            }
+        }
     }
 
     void ImageProcessingThread::signalDoFrame() {
@@ -72,7 +97,21 @@ namespace vbtracker {
         stateCondVar_.notify_all();
     }
 
+    ImageOutputDataPtr ImageProcessingThread::popFrame() {
+        ImageOutputDataPtr ret;
+        if (frameQueue_.read(ret)) {
+            /// Might have been waiting for room in the queue.
+            std::lock_guard<std::mutex> lock{stateMutex_};
+            stateCondVar_.notify_all();
+        }
+        return ret;
+    }
+
     void ImageProcessingThread::threadAction() {
+        if (pipelined()) {
+            pipelinedThreadAction();
+            return;
+        }
         while (1) {
             {
                 std::unique_lock<std::mutex> lock(stateMutex_);
@@ -106,13 +145,74 @@ namespace vbtracker {
                                                             frame_, gray_);
         });
 
-        // Pull the image into an OpenCV matrix named m_frame.
+        // let the tracker thread warn if retrieval fails, we'll just get out.
+        data = retrieveAndProcess(frame_, gray_);
+
+        // On return, we'll automatically notify the tracker thread that its
+        // results are ready for pickup at the second window.
+    }
+
+    void ImageProcessingThread::pipelinedThreadAction() {
+        while (1) {
+            {
+                std::unique_lock<std::mutex> lock(stateMutex_);
+                /// Wait for room in the queue before grabbing another frame,
+                /// so the pipeline stays bounded.
+                stateCondVar_.wait(lock, [&] {
+                    return next_ == NextOp::Exit || !frameQueue_.isFull();
+                });
+                if (NextOp::Exit == next_) {
+                    exiting_ = true;
+                    return;
+                }
+            }
+            auto data = capturePipelinedFrame();
+            if (data) {
+                frameQueue_.write(std::move(data));
+                trackerThreadObj_.signalFrameQueued();
+            }
+        }
+    }
+
+    ImageOutputDataPtr ImageProcessingThread::capturePipelinedFrame() {
+        ImageOutputDataPtr ret;
+        if (!cam_.ok()) {
+            warn() << "Camera is reporting it is not OK." << std::endl;
+            return ret;
+        }
+        if (!cam_.grab()) {
+            warn() << "Camera grab failed." << std::endl;
+            return ret;
+        }
+        auto slot = nextSlot_;
+        nextSlot_ = (nextSlot_ + 1) % framePool_.size();
+        ret = retrieveAndProcess(framePool_[slot], grayPool_[slot]);
+        if (!ret) {
+            warn() << "Camera retrieve appeared to fail: frames had null "
+                      "pointers!"
+                   << std::endl;
+            return ret;
+        }
+        /// The filter must see frames in timestamp order.
+        if (haveDeliveredFrame_ && !(lastDeliveredTime_ < ret->tv)) {
+            warn() << "Dropping a frame with an out-of-order timestamp."
+                   << std::endl;
+            ret.reset();
+            return ret;
+        }
+        haveDeliveredFrame_ = true;
+        lastDeliveredTime_ = ret->tv;
+        return ret;
+    }
+
+    ImageOutputDataPtr
+    ImageProcessingThread::retrieveAndProcess(cv::Mat &frame, cv::Mat &gray) {
+        ImageOutputDataPtr data;
+        // Pull the image into the OpenCV matrices.
         util::time::TimeValue frameTime;
-        cam_.retrieve(frame_, gray_, frameTime);
-        if (!frame_.data || !gray_.data) {
-            // let the tracker thread warn if it wants to, we'll just get
-            // out.
-            return;
+        cam_.retrieve(frame, gray, frameTime);
+        if (!frame.data || !gray.data) {
+            return data;
         }
 
         /// We retrieved a timestamp with that frame...
@@ -128,14 +228,14 @@ namespace vbtracker {
 
         // Do the slow, but intentionally async-able part of the image
         // processing.
-        data = trackingSystem_.performInitialImageProcessing(frameTime, frame_,
-                                                             gray_, camParams_);
+        data = trackingSystem_.performInitialImageProcessing(frameTime, frame,
+                                                             gray, camParams_);
         // Log blobs, if applicable
         if (logBlobs_) {
             if (!blobFile_) {
                 // Oh dear, the file went bad.
                 logBlobs_ = false;
-                return;
+                return data;
             }
             blobFile_ << data->tv.seconds << "," << data->tv.microseconds;
             for (auto &measurement : data->ledMeasurements) {
@@ -144,9 +244,7 @@ namespace vbtracker {
             }
             blobFile_ << "\n";
         }
-
-        // On return, we'll automatically notify the tracker thread that its
-        // results are ready for pickup at the second window.
+        return data;
     }
 
     std::ostream &ImageProcessingThread::msg() const {
@@ -26,17 +26,22 @@
 #define INCLUDED_ImageProcessingThread_h_GUID_307E6652_D346_43B4_291A_5BAAEF4BA909
 
 // Internal Includes
+#include "ImageProcessing.h"
 #include <CameraParameters.h>
 
 // Library/third-party includes
+#include <folly/ProducerConsumerQueue.h>
 #include <opencv2/core/core.hpp>
+#include <osvr/Util/TimeValue.h>
 
 // Standard includes
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <iosfwd>
 #include <mutex>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -55,7 +60,7 @@ namespace vbtracker {
         /// non-assignable.
         ImageProcessingThread &operator=(ImageProcessingThread &) = delete;
 
-        /// called by TrackerThread
+        /// called by TrackerThread - only in lock-step (non-pipelined) mode.
         void signalDoFrame();
         /// called by TrackerThread
         void signalExit();
@@ -66,13 +71,39 @@ namespace vbtracker {
         /// Did we get the exit message?
         bool exiting() const { return exiting_; }
 
+        /// @name Pipelined mode
+        /// @brief If the configured pipeline depth is greater than 1, this
+        /// thread grabs and processes frames on its own, without waiting for
+        /// signalDoFrame(), and the tracker thread takes the results from a
+        /// bounded queue.
+        /// @{
+        bool pipelined() const { return pipelineDepth_ > 1; }
+
+        /// called by TrackerThread: is there a processed frame to pick up?
+        bool frameAvailable() const { return !frameQueue_.isEmpty(); }
+
+        /// called by TrackerThread: takes the oldest processed frame, if any,
+        /// making room for the next one.
+        ImageOutputDataPtr popFrame();
+        /// @}
+
       private:
         /// Helper providing a prefixed output stream for normal messages.
         std::ostream &msg() const;
         /// Helper providing a prefixed output stream for warning messages.
         std::ostream &warn() const;
-        /// Performs the retrieval and processing of a single frame.
+        /// Performs the retrieval and processing of a single frame, in
+        /// lock-step mode.
         void doFrame();
+        /// Main loop used in pipelined mode.
+        void pipelinedThreadAction();
+        /// Grabs and processes a single frame into one of the pooled
+        /// matrices, in pipelined mode. Returns a null pointer if no frame
+        /// should be delivered.
+        ImageOutputDataPtr capturePipelinedFrame();
+        /// Retrieves the grabbed frame into the given matrices and performs
+        /// the initial image processing on it.
+        ImageOutputDataPtr retrieveAndProcess(cv::Mat &frame, cv::Mat &gray);
 
         TrackingSystem &trackingSystem_;
         ImageSource &cam_;
@@ -93,6 +124,22 @@ namespace vbtracker {
         cv::Mat frame_;
         cv::Mat gray_;
 
+        /// @name Pipelined mode data
+        /// @{
+        const std::size_t pipelineDepth_;
+        /// Finished frames waiting for the tracker thread.
+        folly::ProducerConsumerQueue<ImageOutputDataPtr> frameQueue_;
+        /// Matrices that frames are retrieved into, used round-robin. There
+        /// is one for every frame that can be in flight, plus one for the
+        /// frame the tracking system still holds onto, so a buffer is never
+        /// overwritten while still in use.
+        std::vector<cv::Mat> framePool_;
+        std::vector<cv::Mat> grayPool_;
+        std::size_t nextSlot_ = 0;
+        bool haveDeliveredFrame_ = false;
+        util::time::TimeValue lastDeliveredTime_ = {};
+        /// @}
+
         bool exiting_ = false;
     };
 
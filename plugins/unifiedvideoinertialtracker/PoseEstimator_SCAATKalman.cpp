@@ -99,6 +99,7 @@ namespace vbtracker {
           m_distanceMeasVarianceIntercept(
               params.tuning.distanceMeasVarianceIntercept),
           m_extraVerbose(params.extraVerbose),
+          m_batchedCorrection(params.batchedBeaconCorrection),
           m_randEngine(std::random_device()()) {
         std::tie(m_minBoxRatio, m_maxBoxRatio) =
             std::minmax({params.boundingBoxFilterRatio,
@@ -197,8 +198,13 @@ namespace vbtracker {
             p.state.velocity() *= atten;
         }
 
-        /// Shuffle the order of the good LEDS
-        std::shuffle(begin(goodLeds), end(goodLeds), m_randEngine);
+        if (m_batchedCorrection) {
+            /// Order doesn't matter when all are applied at once.
+            m_batch.clear();
+        } else {
+            /// Shuffle the order of the good LEDS
+            std::shuffle(begin(goodLeds), end(goodLeds), m_randEngine);
+        }
 
 #if 0
         static ::util::Stride varianceStride{ 809 };
@@ -325,6 +331,21 @@ namespace vbtracker {
             debug.variance = effectiveVariance;
             meas.setVariance(effectiveVariance);
 
+            if (m_batchedCorrection) {
+                /// Defer the correction: just record what it needs.
+                auto jacobian = meas.getJacobian(state);
+                BatchedBeaconTerm term;
+                term.led = &led;
+                term.index = index;
+                term.residual = residual;
+                term.bodyJacobian =
+                    jacobian.leftCols<BatchedBeaconTerm::BODY_DIM>();
+                term.beaconJacobian = jacobian.rightCols<3>();
+                term.variance = effectiveVariance;
+                m_batch.push_back(term);
+                continue;
+            }
+
             /// Now, do the correction.
             auto model = kalman::makeAugmentedProcessModel(p.processModel,
                                                            beaconProcess);
@@ -361,6 +382,10 @@ namespace vbtracker {
             gotMeasurement = true;
         }
 
+        if (m_batchedCorrection && !m_batch.empty()) {
+            gotMeasurement = applyBatchedCorrection(p);
+        }
+
         handlePossiblyMisidentifiedLeds();
 
         if (gotMeasurement) {
@@ -453,6 +478,86 @@ namespace vbtracker {
         return true;
     }
 
+    bool SCAATKalmanPoseEstimator::applyBatchedCorrection(
+        EstimatorInOutParams const &p) {
+        static const auto BODY_DIM = BatchedBeaconTerm::BODY_DIM;
+        using BodyMatrix = kalman::types::SquareMatrix<BODY_DIM>;
+        using BodyVector = kalman::types::Vector<BODY_DIM>;
+        const auto numBeacons = m_batch.size();
+        const auto m = static_cast<Eigen::DenseIndex>(2 * numBeacons);
+
+        /// The stacked state is the body followed by each beacon in the
+        /// batch, each measurement depending only on the body and its own
+        /// beacon, and (as with the augmented state used one beacon at a
+        /// time) no cross-covariance between the parts. So rather than
+        /// forming the full Jacobian and covariance, we build the innovation
+        /// covariance S = H P H^T + R from its blocks: the body contributes
+        /// to all of it, each beacon only to its own 2x2 diagonal block.
+        const BodyMatrix bodyP = p.state.errorCovariance();
+        Eigen::MatrixXd bodyH(m, BODY_DIM);
+        Eigen::VectorXd deltaz(m);
+        for (std::size_t i = 0; i < numBeacons; ++i) {
+            auto &term = m_batch[i];
+            bodyH.middleRows<2>(2 * i) = term.bodyJacobian;
+            deltaz.segment<2>(2 * i) = term.residual;
+        }
+        /// P12 in TAG terms, for the body part of the state.
+        Eigen::MatrixXd bodyPHt = bodyP * bodyH.transpose();
+        Eigen::MatrixXd S = bodyH * bodyPHt;
+        for (std::size_t i = 0; i < numBeacons; ++i) {
+            auto &term = m_batch[i];
+            Eigen::Matrix3d const &beaconP =
+                p.beacons[term.index]->errorCovariance();
+            S.block<2, 2>(2 * i, 2 * i) +=
+                term.beaconJacobian * beaconP *
+                    term.beaconJacobian.transpose() +
+                Eigen::Matrix2d::Identity() * term.variance;
+        }
+
+        Eigen::LDLT<Eigen::MatrixXd> denom(S);
+        Eigen::VectorXd innovationWeights = denom.solve(deltaz);
+        BodyVector bodyCorrection = bodyPHt * innovationWeights;
+        BodyMatrix newBodyP =
+            bodyP - bodyPHt * denom.solve(bodyPHt.transpose());
+        if (!bodyCorrection.array().allFinite() ||
+            !newBodyP.array().allFinite()) {
+            std::cout << "Non-finite state correction processing batch of "
+                      << numBeacons << " beacons" << std::endl;
+            return false;
+        }
+
+        /// The beacon parts of the gain only involve the diagonal blocks of
+        /// S^-1.
+        Eigen::MatrixXd Sinv = denom.solve(Eigen::MatrixXd::Identity(m, m));
+        for (std::size_t i = 0; i < numBeacons; ++i) {
+            auto &term = m_batch[i];
+            auto &beacon = *(p.beacons[term.index]);
+            Eigen::Matrix3d beaconP = beacon.errorCovariance();
+            Eigen::Matrix<double, 3, 2> beaconPHt =
+                beaconP * term.beaconJacobian.transpose();
+            Eigen::Vector3d beaconCorrection =
+                beaconPHt * innovationWeights.segment<2>(2 * i);
+            Eigen::Matrix3d newBeaconP =
+                beaconP - beaconPHt * Sinv.block<2, 2>(2 * i, 2 * i) *
+                              beaconPHt.transpose();
+            if (!beaconCorrection.array().allFinite() ||
+                !newBeaconP.array().allFinite()) {
+                /// Leave this beacon as it was, but the body's still fine.
+                std::cout << "Non-finite state correction processing beacon "
+                          << term.led->getOneBasedID().value() << std::endl;
+                continue;
+            }
+            beacon.setStateVector(beacon.stateVector() + beaconCorrection);
+            beacon.setErrorCovariance(newBeaconP);
+            beacon.postCorrect();
+        }
+
+        p.state.setStateVector(p.state.stateVector() + bodyCorrection);
+        p.state.setErrorCovariance(newBodyP);
+        p.state.postCorrect();
+        return true;
+    }
+
     LedPtrList SCAATKalmanPoseEstimator::filterLeds(
         LedPtrList const &leds, const bool skipBright, const bool skipAll,
         std::size_t &numBad, EstimatorInOutParams const &p) {
@@ -32,10 +32,11 @@
 #include "TrackedBodyTarget.h"
 
 // Library/third-party includes
-// - none
+#include <Eigen/StdVector>
 
 // Standard includes
 #include <random>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -85,6 +86,24 @@ namespace vbtracker {
         void handlePossiblyMisidentifiedLeds();
         double getVarianceFromBeaconDepth(double depth);
 
+        /// @brief A gated beacon measurement awaiting the batched correction,
+        /// with its Jacobian split into the body and beacon parts.
+        struct BatchedBeaconTerm {
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            static const kalman::types::DimensionType BODY_DIM =
+                kalman::types::Dimension<BodyState>::value;
+            Led *led;
+            std::size_t index;
+            Eigen::Vector2d residual;
+            Eigen::Matrix<double, 2, BODY_DIM> bodyJacobian;
+            Eigen::Matrix<double, 2, 3> beaconJacobian;
+            double variance;
+        };
+
+        /// @brief Corrects the body and all beacons in m_batch at once.
+        /// @return true if the correction was applied.
+        bool applyBatchedCorrection(EstimatorInOutParams const &p);
+
         float m_maxBoxRatio;
         float m_minBoxRatio;
         const bool m_shouldSkipBright;
@@ -100,7 +119,11 @@ namespace vbtracker {
         const double m_distanceMeasVarianceBase;
         const double m_distanceMeasVarianceIntercept;
         const bool m_extraVerbose;
+        const bool m_batchedCorrection;
         std::mt19937 m_randEngine;
+        std::vector<BatchedBeaconTerm,
+                    Eigen::aligned_allocator<BatchedBeaconTerm>>
+            m_batch;
         static const int SIGNAL_HAVE_NOT_SEEN_BEACONS_YET = -1;
         int m_lastUsableBeaconsSeen = SIGNAL_HAVE_NOT_SEEN_BEACONS_YET;
         std::size_t m_framesInProbation = 0;
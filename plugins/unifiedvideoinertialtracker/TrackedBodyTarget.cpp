@@ -181,6 +181,10 @@ namespace vbtracker {
         std::size_t trackingResets = 0;
         std::ostringstream outputSink;
 
+        /// Throttles the extra-verbose assignment heap stats. Per target,
+        /// since targets may be updated concurrently.
+        ::util::Stride assignStride{157};
+
 #ifdef OSVR_UVBI_DUMP_BLOB_CSV
         std::ofstream blobFile;
         util::StreamCSV csv;
@@ -342,7 +346,7 @@ namespace vbtracker {
         bool verbose = false;
         if (getParams().extraVerbose) {
             // if (getParams().debug) {
-            static ::util::Stride assignStride(157);
+            auto &assignStride = m_impl->assignStride;
             assignStride++;
             if (assignStride) {
                 verbose = true;
@@ -641,6 +645,31 @@ namespace vbtracker {
         return m_hasPoseEstimate;
     }
 
+    bool TrackedBodyTarget::getPredictedBeacons(
+        std::vector<cv::Point3f> &out) const {
+        if (!m_hasPoseEstimate) {
+            return false;
+        }
+        auto const &state = getBody().getState();
+        Eigen::Quaterniond quat = state.getQuaternion();
+        /// Same correction the estimators see applied to the body state.
+        Eigen::Vector3d xlate =
+            state.position() - computeTranslationCorrectionToBody(quat);
+        auto n = getNumBeacons();
+        for (UnderlyingBeaconIdType i = 0; i < n; ++i) {
+            Eigen::Vector3d beacon = xlate + quat * m_beacons[i]->stateVector();
+            /// An LED pointed at the camera has an emission direction of -Z
+            /// in camera space.
+            double emissionZ =
+                (quat * cvToVector(m_beaconEmissionDirection[i])).z();
+            if (beacon.z() <= 0 || emissionZ >= 0) {
+                continue;
+            }
+            out.push_back(vec3dToCVPoint3f(beacon));
+        }
+        return true;
+    }
+
     bool TrackedBodyTarget::uncalibratedRANSACPoseEstimateFromLeds(
         CameraParameters const &camParams, Eigen::Vector3d &xlate,
         Eigen::Quaterniond &quat, int skipBrightsCutoff,
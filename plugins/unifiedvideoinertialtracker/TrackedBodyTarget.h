@@ -160,6 +160,12 @@ namespace vbtracker {
         /// pose estimate?
         bool hasPoseEstimate() const { return m_hasPoseEstimate; }
 
+        /// Appends the camera-space positions of the beacons facing the
+        /// camera, as predicted from the body's current state, for use in
+        /// restricting the blob search in the next frame.
+        /// @return false (appending nothing) if there is no pose estimate.
+        bool getPredictedBeacons(std::vector<cv::Point3f> &out) const;
+
         osvr::util::time::TimeValue const &getLastUpdate() const;
 
         /// Get the offset that was subtracted from all beacon positions upon
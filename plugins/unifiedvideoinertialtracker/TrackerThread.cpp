@@ -189,6 +189,15 @@ namespace vbtracker {
         m_messageCondVar.notify_one();
     }
 
+    void TrackerThread::signalFrameQueued() {
+        {
+            /// The frame itself is in the image processing thread's queue, we
+            /// just take the mutex so the notification can't be missed.
+            std::lock_guard<std::mutex> lock{m_messageMutex};
+        }
+        m_messageCondVar.notify_one();
+    }
+
     std::ostream &TrackerThread::msg() const {
         return std::cout << "[UnifiedTracker] ";
     }
@@ -196,26 +205,35 @@ namespace vbtracker {
     std::ostream &TrackerThread::warn() const { return msg() << "Warning: "; }
 
     void TrackerThread::doFrame() {
-        // Check camera status.
-        if (!m_cam.ok()) {
-            // Hmm, camera seems bad. Might regain it? Skip for now...
-            warn() << "Camera is reporting it is not OK." << std::endl;
-            return;
-        }
-        // Trigger a grab.
-        if (!m_cam.grab()) {
-            // Again failing without quitting, in hopes we get better luck
-            // next time...
-            warn() << "Camera grab failed." << std::endl;
-            return;
-        }
-        // When we triggered the grab was a good guess of the time
-        // for the image before that got moved upstream into the ImageSource
-        // library.
+        /// In pipelined mode, the image processing thread grabs and processes
+        /// frames on its own: we just pick up the next one when it's ready.
+        const bool pipelined = imageProcThreadObj_->pipelined();
+        if (!pipelined) {
+            // Check camera status.
+            if (!m_cam.ok()) {
+                // Hmm, camera seems bad. Might regain it? Skip for now...
+                warn() << "Camera is reporting it is not OK." << std::endl;
+                return;
+            }
+            // Trigger a grab.
+            if (!m_cam.grab()) {
+                // Again failing without quitting, in hopes we get better luck
+                // next time...
+                warn() << "Camera grab failed." << std::endl;
+                return;
+            }
+            // When we triggered the grab was a good guess of the time
+            // for the image before that got moved upstream into the
+            // ImageSource library.
 
-        /// Launch an asynchronous task to perform the image retrieval and
-        /// initial image processing.
-        launchTimeConsumingImageStep();
+            /// Launch an asynchronous task to perform the image retrieval and
+            /// initial image processing.
+            launchTimeConsumingImageStep();
+        }
+        auto imageReady = [&] {
+            return pipelined ? imageProcThreadObj_->frameAvailable()
+                             : m_timeConsumingImageStepComplete;
+        };
         if (m_bufferImu) {
             setImuOverrideClock();
         }
@@ -229,10 +247,9 @@ namespace vbtracker {
                 /// Wait for something to do (Completion of image, IMU reports)
                 std::unique_lock<std::mutex> lock(m_messageMutex);
                 m_messageCondVar.wait(lock, [&] {
-                    return m_timeConsumingImageStepComplete ||
-                           !m_imuMessages.isEmpty();
+                    return imageReady() || !m_imuMessages.isEmpty();
                 });
-                if (m_timeConsumingImageStepComplete) {
+                if (imageReady()) {
                     /// Set a flag to get us out of this innermost loop - we'll
                     /// finish up processing this frame and trigger another grab
                     /// before we look at more IMU data.
@@ -280,6 +297,14 @@ namespace vbtracker {
         } while (!finishedImage);
 
         // OK, once we get here, we know the timeConsumingImageStep is complete.
+        if (pipelined) {
+            /// Frames come out of the queue in the order they were captured.
+            m_imageData = imageProcThreadObj_->popFrame();
+            if (m_imageData) {
+                m_frame = m_imageData->frame;
+                m_frameGray = m_imageData->frameGray;
+            }
+        }
         if (!m_frame.data || !m_frameGray.data) {
             // but it ended early due to error.
             warn() << "Camera retrieve appeared to fail: frames had null "
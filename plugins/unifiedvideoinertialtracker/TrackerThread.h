@@ -117,6 +117,10 @@ namespace vbtracker {
                                            cv::Mat const &frame,
                                            cv::Mat const &frameGray);
 
+        /// Call from image processing thread, in pipelined mode, to signal
+        /// that a processed frame has been added to its queue.
+        void signalFrameQueued();
+
       private:
         /// Helper providing a prefixed output stream for normal messages.
         std::ostream &msg() const;
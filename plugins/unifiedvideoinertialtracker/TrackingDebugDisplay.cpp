@@ -57,7 +57,8 @@ namespace vbtracker {
     TrackingDebugDisplay::TrackingDebugDisplay(ConfigParams const &params)
         : m_enabled(params.debug), m_windowName(DEBUG_WINDOW_NAME),
           m_debugStride(DEBUG_FRAME_STRIDE),
-          m_performingOptimization(params.performingOptimization) {
+          m_performingOptimization(params.performingOptimization),
+          m_extractorImagesAvailable(params.imagePipelineDepth <= 1) {
         if (!m_enabled) {
             return;
         }
@@ -79,6 +80,12 @@ namespace vbtracker {
                 << "  - press 'q' to quit the debug windows (tracker will "
                    "continue operation)\n"
                 << std::endl;
+            if (!m_extractorImagesAvailable) {
+                std::cout << "Image processing is pipelined, so the blobs and "
+                             "threshold images ('b' and 't') are not "
+                             "available.\n"
+                          << std::endl;
+            }
         }
     }
 
@@ -511,6 +518,12 @@ namespace vbtracker {
 
         case 'b':
         case 'B':
+            if (!m_extractorImagesAvailable) {
+                msg() << "'b' pressed - but the blobs image isn't available "
+                         "with pipelined image processing."
+                      << std::endl;
+                break;
+            }
             // Show the blob/keypoints image
             msg() << "'b' pressed - Switching to the blobs image in the "
                      "debug window."
@@ -529,6 +542,12 @@ namespace vbtracker {
 
         case 't':
         case 'T':
+            if (!m_extractorImagesAvailable) {
+                msg() << "'t' pressed - but the thresholded image isn't "
+                         "available with pipelined image processing."
+                      << std::endl;
+                break;
+            }
             // Show the thresholded image
             msg() << "'t' pressed - Switching to the thresholded image in "
                      "the debug window."
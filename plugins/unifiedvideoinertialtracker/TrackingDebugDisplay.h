@@ -81,6 +81,10 @@ namespace vbtracker {
         cv::Mat m_displayedFrame;
         ::util::Stride m_debugStride;
         const bool m_performingOptimization;
+        /// Whether the blob extractor's debug images may be shown: not when
+        /// image processing is pipelined, since the extractor is then busy
+        /// with a later frame on another thread.
+        const bool m_extractorImagesAvailable;
     };
 } // namespace vbtracker
 } // namespace osvr
@@ -34,6 +34,7 @@
 
 // Library/third-party includes
 #include <boost/assert.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
 
 #include <util/Stride.h>
 
@@ -43,6 +44,7 @@
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 static const auto ROOM_CALIBRATION_SKIP_BRIGHTS_CUTOFF = 4;
 static const auto CALIBRATION_RANSAC_ITERATIONS = 8;
@@ -80,8 +82,11 @@ namespace vbtracker {
         ret->frame = frame;
         ret->frameGray = frameGray;
         ret->camParams = camParams.createUndistortedVariant();
+        std::vector<cv::Rect> regions;
         auto rawMeasurements =
-            m_impl->blobExtractor->extractBlobs(ret->frameGray);
+            getBlobSearchRegions(camParams, regions)
+                ? m_impl->blobExtractor->extractBlobs(ret->frameGray, regions)
+                : m_impl->blobExtractor->extractBlobs(ret->frameGray);
         ret->ledMeasurements = undistortLeds(rawMeasurements, camParams);
         return ret;
     }
@@ -137,6 +142,19 @@ namespace vbtracker {
                                    "LEDs from data this frame.");
         }
     }
+    namespace {
+        /// @brief Input and output of the pose estimation of a single target
+        /// with new measurements, kept apart so they can be run concurrently.
+        struct PoseUpdateTask {
+            explicit PoseUpdateTask(TrackedBodyTarget &t) : target(&t) {}
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            TrackedBodyTarget *target;
+            BodyState state;
+            util::time::TimeValue initialTime = {};
+            bool gotPose = false;
+        };
+    } // namespace
+
     void TrackingSystem::updatePoseEstimates() {
         if (!isRoomCalibrationComplete()) {
             /// If we need calibration, we need calibration. Go get it done.
@@ -144,34 +162,59 @@ namespace vbtracker {
             return;
         }
 
-        auto const &updateCount = m_impl->updateCount;
-        for (auto &bodyTargetWithMeasurements : updateCount) {
+        /// Gather the work first, in update-list order, so that any bad
+        /// target pointer is caught here rather than on a worker thread.
+        std::vector<PoseUpdateTask, Eigen::aligned_allocator<PoseUpdateTask> >
+            tasks;
+        for (auto &bodyTargetWithMeasurements : m_impl->updateCount) {
             auto targetPtr = getTarget(bodyTargetWithMeasurements.first);
             validateTargetPointerFromUpdateList(targetPtr);
-            auto &target = *targetPtr;
+            BOOST_ASSERT_MSG(
+                std::none_of(tasks.begin(), tasks.end(),
+                             [&](PoseUpdateTask const &task) {
+                                 return &task.target->getBody() ==
+                                        &targetPtr->getBody();
+                             }),
+                "Concurrent pose updates assume one target per body!");
+            tasks.emplace_back(*targetPtr);
+        }
 
-            /// @todo right now assumes one target per body here!
-            auto &body = target.getBody();
+        auto newTime = m_impl->lastFrame;
+        auto &camParams = m_impl->camParams;
+        /// Each task only touches its own target and body, so they may run
+        /// concurrently.
+        auto runTask = [&](PoseUpdateTask &task) {
+            auto &body = task.target->getBody();
             util::time::TimeValue stateTime = {};
-            BodyState state;
-            auto newTime = m_impl->lastFrame;
             auto validState =
-                body.getStateAtOrBefore(newTime, stateTime, state);
-            auto initialTime = stateTime;
+                body.getStateAtOrBefore(newTime, stateTime, task.state);
+            task.initialTime = stateTime;
+            task.gotPose = task.target->updatePoseEstimateFromLeds(
+                camParams, newTime, task.state, stateTime, validState);
+        };
+        if (m_params.parallelBodyUpdate && tasks.size() > 1) {
+            if (!m_impl->bodyUpdatePool) {
+                m_impl->bodyUpdatePool.reset(new ForkJoinPool);
+            }
+            /// rethrows anything thrown on a worker.
+            m_impl->bodyUpdatePool->run(
+                tasks.size(), [&](std::size_t i) { runTask(tasks[i]); });
+        } else {
+            for (auto &task : tasks) {
+                runTask(task);
+            }
+        }
 
-            auto gotPose = target.updatePoseEstimateFromLeds(
-                m_impl->camParams, newTime, state, stateTime, validState);
-            if (gotPose) {
-                body.replaceStateSnapshot(initialTime, newTime, state);
-#if 0
-                static auto s = ::util::Stride{101};
-                if (++s) {
-                    std::cout << body.getState().position().transpose() << "\n";
-                }
-#endif
-                /// @todo deduplicate in making this list.
-                m_updated.push_back(body.getId());
+        /// Merge serially, in the original order, so the state history and
+        /// the updated-body list come out the same as a serial update.
+        for (auto &task : tasks) {
+            if (!task.gotPose) {
+                continue;
             }
+            auto &body = task.target->getBody();
+            body.replaceStateSnapshot(task.initialTime, newTime, task.state);
+            /// @todo deduplicate in making this list.
+            m_updated.push_back(body.getId());
         }
         /// Prune history after video update.
         for (auto &body : m_bodies) {
@@ -180,6 +223,76 @@ namespace vbtracker {
             /// seen for a given body.
             body->pruneHistory(m_impl->lastFrame);
         }
+
+        if (m_params.roiBlobExtraction) {
+            updateBeaconPredictions();
+        }
+    }
+
+    void TrackingSystem::updateBeaconPredictions() {
+        std::vector<cv::Point3f> beacons;
+        std::size_t numTracked = 0;
+        /// Targets not tracked yet don't contribute: they're picked up by
+        /// the periodic full-frame scan.
+        forEachTarget(*this, [&](TrackedBodyTarget &target) {
+            if (target.getPredictedBeacons(beacons)) {
+                ++numTracked;
+            }
+        });
+
+        std::lock_guard<std::mutex> lock(m_impl->roiMutex);
+        if (numTracked < m_impl->numTrackedTargets) {
+            /// Lost a target: look everywhere for it next frame.
+            m_impl->forceFullFrameScan = true;
+        }
+        m_impl->numTrackedTargets = numTracked;
+        m_impl->predictedBeacons.swap(beacons);
+    }
+
+    bool
+    TrackingSystem::getBlobSearchRegions(CameraParameters const &camParams,
+                                         std::vector<cv::Rect> &regions) {
+        if (!m_params.roiBlobExtraction) {
+            return false;
+        }
+        std::vector<cv::Point3f> beacons;
+        {
+            std::lock_guard<std::mutex> lock(m_impl->roiMutex);
+            auto &impl = *m_impl;
+            auto fullFrameDue = ++impl.framesSinceFullFrameScan >=
+                                m_params.roiFullFrameInterval;
+            if (impl.forceFullFrameScan || fullFrameDue ||
+                impl.predictedBeacons.empty()) {
+                impl.forceFullFrameScan = false;
+                impl.framesSinceFullFrameScan = 0;
+                return false;
+            }
+            beacons = impl.predictedBeacons;
+        }
+
+        /// Project through the real (distorted) camera model, since blob
+        /// extraction runs on the raw image.
+        std::vector<cv::Point2f> projected;
+        cv::projectPoints(beacons, cv::Vec3d(0, 0, 0), cv::Vec3d(0, 0, 0),
+                          camParams.cameraMatrix,
+                          camParams.distortionParameters, projected);
+        auto halfSize = m_params.roiHalfSize;
+        auto imageRect = cv::Rect(cv::Point(0, 0), camParams.imageSize);
+        regions.clear();
+        for (auto &pt : projected) {
+            auto center = cv::Point(static_cast<int>(pt.x),
+                                    static_cast<int>(pt.y));
+            auto region =
+                cv::Rect(center.x - halfSize, center.y - halfSize,
+                         2 * halfSize + 1, 2 * halfSize + 1) &
+                imageRect;
+            if (region.area() > 0) {
+                regions.push_back(region);
+            }
+        }
+        /// If nothing we expect to see lands in the image, we'd better look
+        /// at all of it.
+        return !regions.empty();
     }
 
     void TrackingSystem::calibrationVideoPhaseThree() {
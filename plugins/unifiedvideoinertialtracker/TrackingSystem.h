@@ -163,6 +163,17 @@ namespace vbtracker {
         /// calibration is incomplete.
         void calibrationVideoPhaseThree();
 
+        /// Called at the end of updatePoseEstimates() to record where the
+        /// tracked beacons should be seen in the next frame.
+        void updateBeaconPredictions();
+
+        /// Called by performInitialImageProcessing(): fills in the regions to
+        /// search for blobs, if region-of-interest blob extraction is enabled
+        /// and a full-frame scan isn't due.
+        /// @return true if the blob search should be restricted to regions.
+        bool getBlobSearchRegions(CameraParameters const &camParams,
+                                  std::vector<cv::Rect> &regions);
+
         using BodyPtr = std::unique_ptr<TrackedBody>;
         ConfigParams m_params;
 
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "ConfigParams.h"
+#include "ForkJoinPool.h"
 #include "RoomCalibration.h"
 #include "TrackingSystem.h"
 #include <CameraParameters.h>
@@ -39,7 +40,10 @@
 #include <osvr/Util/TimeValue.h>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -72,7 +76,23 @@ namespace vbtracker {
 
         LedUpdateCount updateCount;
         BlobExtractorPtr blobExtractor;
+
+        /// @name Region-of-interest blob extraction
+        /// @brief Predictions are written by the tracker thread after pose
+        /// estimation, and read by the image processing thread.
+        /// @{
+        std::mutex roiMutex;
+        /// Camera-space beacon positions predicted for the next frame.
+        std::vector<cv::Point3f> predictedBeacons;
+        /// Set when a target loses tracking, to trigger a full-frame scan.
+        bool forceFullFrameScan = true;
+        /// Number of targets tracked as of the last prediction.
+        std::size_t numTrackedTargets = 0;
+        int framesSinceFullFrameScan = 0;
+        /// @}
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
+        /// Workers for parallelBodyUpdate, created on first use.
+        std::unique_ptr<ForkJoinPool> bodyUpdatePool;
     };
 
 } // namespace vbtracker
@@ -322,9 +322,12 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
             !m_continuousReporting, m_debugData));
 
         /// This will start the thread, but it won't enter its full main loop
-        /// until we call permitStart()
-        m_trackerThread =
-            std::thread([&] { m_trackerThreadManager->threadAction(); });
+        /// until we call permitStart(). Scheduling is applied first so the
+        /// image processing thread it starts inherits it too.
+        m_trackerThread = std::thread([&] {
+            osvrPluginApplyTrackerThreadScheduling();
+            m_trackerThreadManager->threadAction();
+        });
     }
     void stopTrackerThread() {
         if (m_trackerThreadManager) {
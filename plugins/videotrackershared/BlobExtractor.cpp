@@ -140,7 +140,21 @@ namespace vbtracker {
     }
 
     void BasicThresholdBlobDetector::makeFloodFillMask(cv::Mat const &gray) {
-        floodFillMask_.create(gray.rows + 2, gray.cols + 2, CV_8UC1);
+        /// Keep storage big enough for the whole image gray may be a region
+        /// of, and use the corner of it that fits gray.
+        cv::Size wholeSize;
+        cv::Point offset;
+        gray.locateROI(wholeSize, offset);
+        if (floodFillMaskStorage_.cols < wholeSize.width + 2 ||
+            floodFillMaskStorage_.rows < wholeSize.height + 2) {
+            floodFillMaskStorage_.create(
+                std::max(wholeSize.height + 2, floodFillMaskStorage_.rows),
+                std::max(wholeSize.width + 2, floodFillMaskStorage_.cols),
+                CV_8UC1);
+        }
+        floodFillMask_ = floodFillMaskStorage_(
+            cv::Rect(0, 0, gray.cols + 2, gray.rows + 2));
+        floodFillMask_.setTo(0);
         origBoundsInFloodFill_ =
             cv::Rect(1, 1, floodFillMask_.cols - 2, floodFillMask_.rows - 2);
     }
@@ -67,11 +67,12 @@ namespace vbtracker {
     double getConvexity(ContourType const &contour, const double area);
 
     struct ImageRangeInfo {
+        ImageRangeInfo() = default;
         explicit ImageRangeInfo(cv::InputArray img) {
             cv::minMaxIdx(img, &minVal, &maxVal);
         }
-        double minVal;
-        double maxVal;
+        double minVal = 0;
+        double maxVal = 0;
         double lerp(double alpha) const {
             return minVal + (maxVal - minVal) * alpha;
         }
@@ -108,6 +109,7 @@ namespace vbtracker {
         void augmentPoint(cv::Point peakCenter, const int loDiff = 2,
                           const int upDiff = 2);
         cv::Mat grayImage_;
+        cv::Mat floodFillMaskStorage_;
         cv::Mat floodFillMask_;
         cv::Rect origBoundsInFloodFill_;
     };
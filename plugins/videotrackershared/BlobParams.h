@@ -123,6 +123,14 @@ namespace vbtracker {
         /// If postEdgeDetectionBlur is true, the value used as a threshold to
         /// binarize the image after the blur.
         int postEdgeDetectionBlurThreshold;
+
+        /// Whether to compute the edge detection, post-edge-detection blur,
+        /// and threshold with a single-pass SIMD kernel instead of separate
+        /// OpenCV calls. Only possible with a laplacianKSize of 3, an
+        /// integer laplacianScale no greater than 16, no erosion, and a
+        /// postEdgeDetectionBlurSize of 3 (if blurring): otherwise the
+        /// OpenCV path is used.
+        bool fusedEdgeDetection;
     };
 
 } // namespace vbtracker
@@ -0,0 +1,119 @@
+/** @file
+    @brief Implementation of a tool timing the fused edge detection kernel
+    against the equivalent sequence of OpenCV operations. Their results are
+    checked for equality by FusedEdgeKernelTest.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <BlobParams.h>
+#include <FusedEdgeKernel.h>
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    static const int ITERATIONS = 200;
+    using clock = std::chrono::high_resolution_clock;
+
+    /// @brief Mean microseconds per call of f over ITERATIONS calls.
+    template <typename F> static double timeIt(F &&f) {
+        auto start = clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            f();
+        }
+        auto elapsed = clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() /
+               ITERATIONS;
+    }
+
+    /// @returns false if the image could not be loaded.
+    static bool benchmarkImage(std::string const &fn,
+                               EdgeHoleParams const &params) {
+        cv::Mat gray = cv::imread(fn, cv::IMREAD_GRAYSCALE);
+        if (!gray.data) {
+            std::cerr << "Could not load image " << fn << std::endl;
+            return false;
+        }
+        cv::Mat blurred;
+        cv::GaussianBlur(gray, blurred,
+                         cv::Size(params.preEdgeDetectionBlurSize,
+                                  params.preEdgeDetectionBlurSize),
+                         0, 0);
+
+        /// The reference path, as in EdgeHoleBasedLedExtractor::detectEdges:
+        /// Laplacian, then Gaussian blur, then threshold.
+        cv::Mat edge, edgeBlurred, cvBinary;
+        auto cvTime = timeIt([&] {
+            cv::Laplacian(blurred, edge, CV_8U, 3, params.laplacianScale);
+            cv::GaussianBlur(edge, edgeBlurred, cv::Size(3, 3), 0, 0);
+            cv::threshold(edgeBlurred, cvBinary,
+                          params.postEdgeDetectionBlurThreshold, 255,
+                          cv::THRESH_BINARY);
+        });
+
+        FusedEdgeKernelParams fusedParams;
+        fusedParams.laplacianScale = static_cast<int>(params.laplacianScale);
+        fusedParams.postBlur = true;
+        fusedParams.threshold = params.postEdgeDetectionBlurThreshold;
+        cv::Mat fusedEdge(blurred.size(), CV_8UC1);
+        cv::Mat fusedBinary(blurred.size(), CV_8UC1);
+        std::vector<std::uint16_t> scratch;
+        auto fusedTime = timeIt([&] {
+            fusedEdgeDetect(blurred.data, blurred.step, blurred.rows,
+                            blurred.cols, fusedParams, fusedEdge.data,
+                            fusedEdge.step, fusedBinary.data,
+                            fusedBinary.step, scratch);
+        });
+
+        std::cout << fn << ": OpenCV " << cvTime << "us, fused " << fusedTime
+                  << "us (" << cvTime / fusedTime << "x)" << std::endl;
+        return true;
+    }
+} // namespace vbtracker
+} // namespace osvr
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " image [image...]" << std::endl;
+        return -1;
+    }
+    using namespace osvr::vbtracker;
+    std::cout << "Fused kernel instruction set: "
+              << getFusedEdgeKernelInstructionSet() << std::endl;
+    EdgeHoleParams params;
+    bool ok = true;
+    for (int arg = 1; arg < argc; ++arg) {
+        ok = benchmarkImage(argv[arg], params) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -38,6 +38,8 @@
 #endif
 
 // Standard includes
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <utility>
 
@@ -50,10 +52,20 @@ namespace vbtracker {
           edgeDetectErosion(false),
           erosionKernelValue(MAX_JPG_EDGEDETECT_NOISE),
           postEdgeDetectionBlur(true), postEdgeDetectionBlurSize(3),
-          postEdgeDetectionBlurThreshold(80) {}
+          postEdgeDetectionBlurThreshold(80), fusedEdgeDetection(false) {}
 
     static const int EDGE_DETECT_DEST_DEPTH = CV_8U;
 
+    /// Can the fused kernel compute exactly what the OpenCV path would with
+    /// these parameters?
+    static inline bool canUseFusedEdgeDetection(EdgeHoleParams const &p) {
+        auto scale = p.laplacianScale;
+        return p.laplacianKSize == 3 && scale >= 0 &&
+               scale <= FUSED_EDGE_MAX_SCALE && std::floor(scale) == scale &&
+               !p.edgeDetectErosion &&
+               (!p.postEdgeDetectionBlur || p.postEdgeDetectionBlurSize == 3);
+    }
+
     EdgeHoleBasedLedExtractor::EdgeHoleBasedLedExtractor(
         EdgeHoleParams const &extractorParams)
         : extParams_(extractorParams)
@@ -72,6 +84,27 @@ namespace vbtracker {
         compressionArtifactRemoval_ = cv::createMorphologyFilter(
             cv::MORPH_ERODE, CV_8U, compressionArtifactRemovalKernel_);
 #endif
+        if (extParams_.fusedEdgeDetection) {
+#if OSVR_EDGEHOLE_UMAT
+            std::cout << PREFIX << "Fused edge detection not available when "
+                                   "using UMat, ignoring."
+                      << std::endl;
+#else
+            useFusedEdgeDetection_ = canUseFusedEdgeDetection(extParams_);
+            if (useFusedEdgeDetection_) {
+                fusedParams_.laplacianScale =
+                    static_cast<int>(extParams_.laplacianScale);
+                fusedParams_.postBlur = extParams_.postEdgeDetectionBlur;
+                fusedParams_.threshold =
+                    extParams_.postEdgeDetectionBlurThreshold;
+            } else {
+                std::cout << PREFIX << "Fused edge detection requested, but "
+                                       "not possible with the other edge "
+                                       "detection parameters, ignoring."
+                          << std::endl;
+            }
+#endif
+        }
     }
 #ifdef OSVR_UVBI_CORE
     namespace tracing = ::osvr::common::tracing;
@@ -87,6 +120,55 @@ namespace vbtracker {
     LedMeasurementVec const &EdgeHoleBasedLedExtractor::
     operator()(cv::Mat const &gray, BlobParams const &p,
                bool verboseBlobOutput) {
+        return (*this)(gray, p, ImageRangeInfo(gray), verboseBlobOutput);
+    }
+
+#if !OSVR_EDGEHOLE_UMAT
+    /// Makes frame a header for the top-left corner of storage. It's a
+    /// standalone header rather than an ROI, so OpenCV filters extrapolate at
+    /// its borders instead of reading whatever is left in the rest of storage.
+    static inline void useStorage(cv::Mat &frame, cv::Mat &storage,
+                                  cv::Size const &size) {
+        frame = cv::Mat(size, CV_8UC1, storage.data, storage.step);
+    }
+#endif
+
+    void EdgeHoleBasedLedExtractor::prepareFrames(cv::Mat const &gray) {
+#if OSVR_EDGEHOLE_UMAT
+        /// UMat can't wrap existing storage: the frames just get reallocated
+        /// when the input size changes.
+        (void)gray;
+#else
+        cv::Size wholeSize;
+        cv::Point offset;
+        gray.locateROI(wholeSize, offset);
+        if (wholeSize.width > storageSize_.width ||
+            wholeSize.height > storageSize_.height) {
+            storageSize_ =
+                cv::Size(std::max(wholeSize.width, storageSize_.width),
+                         std::max(wholeSize.height, storageSize_.height));
+            for (auto storage :
+                 {&grayStorage_, &edgeStorage_, &edgeBinaryStorage_,
+                  &blurredStorage_, &edgeTempStorage_, &binTempStorage_}) {
+                storage->create(storageSize_, CV_8UC1);
+            }
+#ifdef OSVR_USE_REALTIME_LAPLACIAN
+            laplacianImpl_->reserve(storageSize_);
+#endif
+        }
+        auto size = gray.size();
+        useStorage(gray_, grayStorage_, size);
+        useStorage(edge_, edgeStorage_, size);
+        useStorage(edgeBinary_, edgeBinaryStorage_, size);
+        useStorage(blurred_, blurredStorage_, size);
+        useStorage(edgeTemp_, edgeTempStorage_, size);
+        useStorage(binTemp_, binTempStorage_, size);
+#endif
+    }
+
+    LedMeasurementVec const &EdgeHoleBasedLedExtractor::
+    operator()(cv::Mat const &gray, BlobParams const &p,
+               ImageRangeInfo const &rangeInfo, bool verboseBlobOutput) {
         reset();
 
 #ifdef OSVR_UVBI_CORE
@@ -95,10 +177,10 @@ namespace vbtracker {
 
         verbose_ = verboseBlobOutput;
 
+        prepareFrames(gray);
         gray.copyTo(gray_);
 
         /// Set up the threshold parameters
-        auto rangeInfo = ImageRangeInfo(gray_);
         if (rangeInfo.maxVal < p.absoluteMinThreshold) {
             /// Early out - empty image!
             return measurements_;
@@ -118,6 +200,37 @@ namespace vbtracker {
                                   extParams_.preEdgeDetectionBlurSize),
                          0, 0);
 
+#if !OSVR_EDGEHOLE_UMAT
+        if (useFusedEdgeDetection_ && blurred_.rows >= 2 &&
+            blurred_.cols >= 2) {
+            /// Edge detection, optional blur, and binarization in one pass.
+            edge_.create(blurred_.size(), CV_8UC1);
+            edgeBinary_.create(blurred_.size(), CV_8UC1);
+            fusedEdgeDetect(blurred_.data, blurred_.step, blurred_.rows,
+                            blurred_.cols, fusedParams_, edge_.data,
+                            edge_.step, edgeBinary_.data, edgeBinary_.step,
+                            fusedScratch_);
+        } else
+#endif
+        {
+            detectEdges();
+        }
+
+        /// Extract beacons from the edge detection image
+
+        // The lambda ("continuation") is called with each "hole" in the edge
+        // detection image, it's up to us what to do with the contour we're
+        // given. We examine it for suitability as an LED, and if it passes our
+        // checks, add a derived measurement to our measurement vector and the
+        // contour itself to our list of contours for debugging display.
+        edgeBinary_.copyTo(binTemp_);
+        consumeHolesOfConnectedComponents(
+            binTemp_, contoursTempStorage_, hierarchyTempStorage_,
+            [&](ContourType &&contour) { checkBlob(std::move(contour), p); });
+        return measurements_;
+    }
+
+    void EdgeHoleBasedLedExtractor::detectEdges() {
 #ifdef OSVR_USE_REALTIME_LAPLACIAN
         /// Edge detection: re-apply our partially prepared laplacian to this
         /// frame now.
@@ -151,19 +264,6 @@ namespace vbtracker {
                           extParams_.postEdgeDetectionBlurThreshold, 255,
                           cv::THRESH_BINARY);
         }
-
-        /// Extract beacons from the edge detection image
-
-        // The lambda ("continuation") is called with each "hole" in the edge
-        // detection image, it's up to us what to do with the contour we're
-        // given. We examine it for suitability as an LED, and if it passes our
-        // checks, add a derived measurement to our measurement vector and the
-        // contour itself to our list of contours for debugging display.
-        edgeBinary_.copyTo(binTemp_);
-        consumeHolesOfConnectedComponents(
-            binTemp_, contoursTempStorage_, hierarchyTempStorage_,
-            [&](ContourType &&contour) { checkBlob(std::move(contour), p); });
-        return measurements_;
     }
     /// out of line for unique_ptr-based pimpl.
     EdgeHoleBasedLedExtractor::~EdgeHoleBasedLedExtractor() = default;
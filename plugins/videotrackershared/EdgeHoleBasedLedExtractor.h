@@ -32,6 +32,7 @@
 // Internal Includes
 #include <BlobExtractor.h>
 #include <BlobParams.h>
+#include <FusedEdgeKernel.h>
 #include <LedMeasurement.h>
 #include <osvr/Util/OpenCVVersion.h>
 
@@ -82,6 +83,13 @@ namespace vbtracker {
         LedMeasurementVec const &operator()(cv::Mat const &gray,
                                             BlobParams const &p,
                                             bool verboseBlobOutput = false);
+        /// @brief Like the above, but with thresholds based on the given
+        /// intensity range rather than that of gray: for when gray is one
+        /// region of a larger image.
+        LedMeasurementVec const &operator()(cv::Mat const &gray,
+                                            BlobParams const &p,
+                                            ImageRangeInfo const &rangeInfo,
+                                            bool verboseBlobOutput = false);
         ~EdgeHoleBasedLedExtractor();
 
         using ContourId = std::size_t;
@@ -116,6 +124,13 @@ namespace vbtracker {
             return input;
         }
 #endif
+        /// @brief Points the working frames at views of our full-size
+        /// storage, growing it to fit the image gray is a part of if needed,
+        /// so extracting from regions of varying size doesn't reallocate.
+        void prepareFrames(cv::Mat const &gray);
+        /// @brief Edge detection and binarization of blurred_ into edge_ and
+        /// edgeBinary_ using separate OpenCV operations.
+        void detectEdges();
         void checkBlob(ContourType &&contour, BlobParams const &p);
         void addToRejectList(ContourId id, RejectReason reason,
                              BlobData const &data) {
@@ -125,6 +140,12 @@ namespace vbtracker {
         /// parameters
         const EdgeHoleParams extParams_;
 
+        /// Whether the fused edge detection kernel was requested and can
+        /// reproduce these parameters.
+        bool useFusedEdgeDetection_ = false;
+        FusedEdgeKernelParams fusedParams_;
+        std::vector<std::uint16_t> fusedScratch_;
+
         std::uint8_t minBeaconCenterVal_ = 127;
 
         /// @name Frames/intermediates someone might care about
@@ -145,6 +166,21 @@ namespace vbtracker {
         MatType binTemp_;
         /// @}
 
+#if !OSVR_EDGEHOLE_UMAT
+        /// @name Full-size storage for the frames above
+        /// @brief The frames wrap the top-left corner of these, the size of
+        /// the current input.
+        /// @{
+        cv::Size storageSize_;
+        cv::Mat grayStorage_;
+        cv::Mat edgeStorage_;
+        cv::Mat edgeBinaryStorage_;
+        cv::Mat blurredStorage_;
+        cv::Mat edgeTempStorage_;
+        cv::Mat binTempStorage_;
+        /// @}
+#endif
+
         /// @name Temporaries for consumeHolesOfConnectedComponents
         /// @{
         std::vector<ContourType> contoursTempStorage_;
@@ -49,7 +49,8 @@ namespace vbtracker {
     }
 
     LedMeasurementVec EdgeHoleBlobExtractor::extractBlobs_() {
-        return m_extractor(getLatestGrayImage(), m_params);
+        return m_extractor(getLatestGrayImage(), m_params,
+                           getLatestImageRange());
     }
 
     BlobExtractorPtr
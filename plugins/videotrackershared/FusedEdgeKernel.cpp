@@ -0,0 +1,392 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FusedEdgeKernel.h"
+
+// Library/third-party includes
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OSVR_FUSED_EDGE_SSE2
+#include <emmintrin.h>
+#endif
+
+/// The AVX2 path is compiled in whenever the compiler can generate AVX2 code
+/// for individual functions (without raising the target of the whole file),
+/// and only used if the CPU turns out to support it.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||             \
+    defined(_M_IX86)
+#if defined(__clang__)
+#if __has_builtin(__builtin_cpu_supports)
+#define OSVR_FUSED_EDGE_AVX2
+#define OSVR_FUSED_EDGE_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__GNUC__) &&                                                     \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define OSVR_FUSED_EDGE_AVX2
+#define OSVR_FUSED_EDGE_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1800
+#define OSVR_FUSED_EDGE_AVX2
+#define OSVR_FUSED_EDGE_AVX2_TARGET
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef OSVR_FUSED_EDGE_AVX2
+#include <immintrin.h>
+#endif
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+namespace osvr {
+namespace vbtracker {
+    namespace {
+        /// Border handling matching OpenCV's BORDER_REFLECT_101 (the
+        /// default), valid for n >= 2.
+        inline int reflect101(int i, int n) {
+            return i < 0 ? -i : (i >= n ? 2 * n - i - 2 : i);
+        }
+
+        inline std::uint8_t saturateU8(int v) {
+            return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+
+#ifdef OSVR_FUSED_EDGE_AVX2
+        bool cpuSupportsAVX2() {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+            /// The OS must also save the upper halves of the YMM registers.
+            __cpuid(info, 1);
+            const int osxsaveAndAvx = (1 << 27) | (1 << 28);
+            if ((info[2] & osxsaveAndAvx) != osxsaveAndAvx ||
+                (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+        }
+
+        /// The AVX2 code uses helper functions rather than lambdas, since
+        /// lambdas wouldn't get the AVX2 target.
+        OSVR_FUSED_EDGE_AVX2_TARGET inline __m256i
+        load16AVX2(std::uint8_t const *p) {
+            return _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<__m128i const *>(p)));
+        }
+
+        /// Sixteen pixels of Laplacian, before saturation.
+        OSVR_FUSED_EDGE_AVX2_TARGET inline __m256i
+        laplacian16AVX2(std::uint8_t const *up, std::uint8_t const *mid,
+                        std::uint8_t const *down, int x, __m256i vscale) {
+            auto corners = _mm256_add_epi16(
+                _mm256_add_epi16(load16AVX2(up + x - 1),
+                                 load16AVX2(up + x + 1)),
+                _mm256_add_epi16(load16AVX2(down + x - 1),
+                                 load16AVX2(down + x + 1)));
+            auto center = load16AVX2(mid + x);
+            auto v = _mm256_sub_epi16(_mm256_slli_epi16(corners, 1),
+                                      _mm256_slli_epi16(center, 3));
+            return _mm256_mullo_epi16(v, vscale);
+        }
+
+        /// AVX2 part of laplacianRow(), starting at column x.
+        /// @return the first column left for the caller.
+        OSVR_FUSED_EDGE_AVX2_TARGET int
+        laplacianRowAVX2(std::uint8_t const *up, std::uint8_t const *mid,
+                         std::uint8_t const *down, int cols, int scale,
+                         std::uint8_t *out, int x) {
+            const __m256i vscale = _mm256_set1_epi16(static_cast<short>(scale));
+            for (; x + 32 <= cols - 1; x += 32) {
+                /// packus works within 128-bit lanes: put the quadwords back
+                /// in order afterwards.
+                auto packed = _mm256_permute4x64_epi64(
+                    _mm256_packus_epi16(
+                        laplacian16AVX2(up, mid, down, x, vscale),
+                        laplacian16AVX2(up, mid, down, x + 16, vscale)),
+                    0xD8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + x),
+                                    packed);
+            }
+            return x;
+        }
+#endif
+
+        FusedEdgeInstructionSet detectInstructionSet() {
+#ifdef OSVR_FUSED_EDGE_AVX2
+            if (cpuSupportsAVX2()) {
+                return FusedEdgeInstructionSet::AVX2;
+            }
+#endif
+#ifdef OSVR_FUSED_EDGE_SSE2
+            return FusedEdgeInstructionSet::SSE2;
+#else
+            return FusedEdgeInstructionSet::Scalar;
+#endif
+        }
+
+        /// The widest instruction set usable on this CPU.
+        FusedEdgeInstructionSet supportedInstructionSet() {
+            static const FusedEdgeInstructionSet isa = detectInstructionSet();
+            return isa;
+        }
+
+        /// Laplacian with aperture 3, as OpenCV defines it: the kernel is
+        /// [2 0 2; 0 -8 0; 2 0 2], scaled.
+        void laplacianRow(std::uint8_t const *up, std::uint8_t const *mid,
+                          std::uint8_t const *down, int cols, int scale,
+                          FusedEdgeInstructionSet isa, std::uint8_t *out) {
+            auto scalarAt = [&](int x) {
+                auto xl = reflect101(x - 1, cols);
+                auto xr = reflect101(x + 1, cols);
+                auto v = 2 * (up[xl] + up[xr] + down[xl] + down[xr]) -
+                         8 * mid[x];
+                out[x] = saturateU8(v * scale);
+            };
+            scalarAt(0);
+            int x = 1;
+            /// Vector loops read from x - 1 through x + width, so they stop
+            /// short of the last column, which needs reflection.
+#ifdef OSVR_FUSED_EDGE_AVX2
+            if (isa >= FusedEdgeInstructionSet::AVX2) {
+                x = laplacianRowAVX2(up, mid, down, cols, scale, out, x);
+            }
+#endif
+#ifdef OSVR_FUSED_EDGE_SSE2
+            if (isa >= FusedEdgeInstructionSet::SSE2) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i vscale =
+                    _mm_set1_epi16(static_cast<short>(scale));
+                for (; x + 16 <= cols - 1; x += 16) {
+                    auto ul = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(up + x - 1));
+                    auto ur = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(up + x + 1));
+                    auto dl = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(down + x - 1));
+                    auto dr = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(down + x + 1));
+                    auto c = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(mid + x));
+                    auto lo = [&](__m128i a) {
+                        return _mm_unpacklo_epi8(a, zero);
+                    };
+                    auto hi = [&](__m128i a) {
+                        return _mm_unpackhi_epi8(a, zero);
+                    };
+                    auto cornersLo =
+                        _mm_add_epi16(_mm_add_epi16(lo(ul), lo(ur)),
+                                      _mm_add_epi16(lo(dl), lo(dr)));
+                    auto cornersHi =
+                        _mm_add_epi16(_mm_add_epi16(hi(ul), hi(ur)),
+                                      _mm_add_epi16(hi(dl), hi(dr)));
+                    auto vLo = _mm_mullo_epi16(
+                        _mm_sub_epi16(_mm_slli_epi16(cornersLo, 1),
+                                      _mm_slli_epi16(lo(c), 3)),
+                        vscale);
+                    auto vHi = _mm_mullo_epi16(
+                        _mm_sub_epi16(_mm_slli_epi16(cornersHi, 1),
+                                      _mm_slli_epi16(hi(c), 3)),
+                        vscale);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                                     _mm_packus_epi16(vLo, vHi));
+                }
+            }
+#endif
+            for (; x < cols; ++x) {
+                scalarAt(x);
+            }
+        }
+
+        void thresholdRow(std::uint8_t const *in, int cols, int threshold,
+                          FusedEdgeInstructionSet isa, std::uint8_t *out) {
+            if (threshold < 0) {
+                std::memset(out, 255, cols);
+                return;
+            }
+            if (threshold >= 255) {
+                std::memset(out, 0, cols);
+                return;
+            }
+            int x = 0;
+#ifdef OSVR_FUSED_EDGE_SSE2
+            if (isa >= FusedEdgeInstructionSet::SSE2) {
+                /// in > t exactly when the saturating in - t is nonzero.
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i ones = _mm_set1_epi8(-1);
+                const __m128i t = _mm_set1_epi8(static_cast<char>(threshold));
+                for (; x + 16 <= cols; x += 16) {
+                    auto v = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(in + x));
+                    auto notAbove = _mm_cmpeq_epi8(_mm_subs_epu8(v, t), zero);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                                     _mm_xor_si128(notAbove, ones));
+                }
+            }
+#endif
+            for (; x < cols; ++x) {
+                out[x] = in[x] > threshold ? 255 : 0;
+            }
+        }
+
+        /// Vertical half of the 3x3 Gaussian ([1 2 1] in each direction).
+        void verticalBlurRow(std::uint8_t const *up, std::uint8_t const *mid,
+                             std::uint8_t const *down, int cols,
+                             FusedEdgeInstructionSet isa, std::uint16_t *out) {
+            int x = 0;
+#ifdef OSVR_FUSED_EDGE_SSE2
+            if (isa >= FusedEdgeInstructionSet::SSE2) {
+                const __m128i zero = _mm_setzero_si128();
+                for (; x + 16 <= cols; x += 16) {
+                    auto u = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(up + x));
+                    auto m = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(mid + x));
+                    auto d = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(down + x));
+                    auto sumLo = _mm_add_epi16(
+                        _mm_add_epi16(_mm_unpacklo_epi8(u, zero),
+                                      _mm_unpacklo_epi8(d, zero)),
+                        _mm_slli_epi16(_mm_unpacklo_epi8(m, zero), 1));
+                    auto sumHi = _mm_add_epi16(
+                        _mm_add_epi16(_mm_unpackhi_epi8(u, zero),
+                                      _mm_unpackhi_epi8(d, zero)),
+                        _mm_slli_epi16(_mm_unpackhi_epi8(m, zero), 1));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                                     sumLo);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x + 8),
+                                     sumHi);
+                }
+            }
+#endif
+            for (; x < cols; ++x) {
+                out[x] =
+                    static_cast<std::uint16_t>(up[x] + 2 * mid[x] + down[x]);
+            }
+        }
+
+        /// Horizontal half of the 3x3 Gaussian, rounding as OpenCV's
+        /// fixed-point 8-bit implementation does, followed by the threshold.
+        void horizontalBlurThresholdRow(std::uint16_t const *in, int cols,
+                                        int threshold,
+                                        FusedEdgeInstructionSet isa,
+                                        std::uint8_t *out) {
+            auto scalarAt = [&](int x) {
+                auto h = in[reflect101(x - 1, cols)] + 2 * in[x] +
+                         in[reflect101(x + 1, cols)];
+                out[x] = ((h + 8) >> 4) > threshold ? 255 : 0;
+            };
+            scalarAt(0);
+            int x = 1;
+#ifdef OSVR_FUSED_EDGE_SSE2
+            if (isa >= FusedEdgeInstructionSet::SSE2 && threshold >= 0 &&
+                threshold < 255) {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i ones = _mm_set1_epi8(-1);
+                const __m128i rounding = _mm_set1_epi16(8);
+                const __m128i t = _mm_set1_epi8(static_cast<char>(threshold));
+                auto blur8 = [&](int xx) {
+                    auto l = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(in + xx - 1));
+                    auto c = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(in + xx));
+                    auto r = _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(in + xx + 1));
+                    auto h = _mm_add_epi16(_mm_add_epi16(l, r),
+                                           _mm_slli_epi16(c, 1));
+                    return _mm_srli_epi16(_mm_add_epi16(h, rounding), 4);
+                };
+                for (; x + 16 <= cols - 1; x += 16) {
+                    auto v = _mm_packus_epi16(blur8(x), blur8(x + 8));
+                    auto notAbove = _mm_cmpeq_epi8(_mm_subs_epu8(v, t), zero);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x),
+                                     _mm_xor_si128(notAbove, ones));
+                }
+            }
+#endif
+            for (; x < cols; ++x) {
+                scalarAt(x);
+            }
+        }
+    } // namespace
+
+    void fusedEdgeDetect(std::uint8_t const *src, std::size_t srcStep,
+                         int rows, int cols, FusedEdgeKernelParams const &p,
+                         std::uint8_t *edge, std::size_t edgeStep,
+                         std::uint8_t *binary, std::size_t binaryStep,
+                         std::vector<std::uint16_t> &scratch) {
+        auto srcRow = [&](int y) {
+            return src + reflect101(y, rows) * srcStep;
+        };
+        auto edgeRow = [&](int y) {
+            return edge + reflect101(y, rows) * edgeStep;
+        };
+        auto isa = std::min(p.maxInstructionSet, supportedInstructionSet());
+        if (p.postBlur) {
+            scratch.resize(cols);
+        }
+        /// The blur of a row needs the edge rows on either side, so it lags
+        /// the edge detection by one row.
+        auto blurAndThreshold = [&](int y) {
+            verticalBlurRow(edgeRow(y - 1), edgeRow(y), edgeRow(y + 1), cols,
+                            isa, scratch.data());
+            horizontalBlurThresholdRow(scratch.data(), cols, p.threshold, isa,
+                                       binary + y * binaryStep);
+        };
+        for (int y = 0; y < rows; ++y) {
+            auto edgeOut = edge + y * edgeStep;
+            laplacianRow(srcRow(y - 1), srcRow(y), srcRow(y + 1), cols,
+                         p.laplacianScale, isa, edgeOut);
+            if (!p.postBlur) {
+                thresholdRow(edgeOut, cols, p.threshold, isa,
+                             binary + y * binaryStep);
+            } else if (y > 0) {
+                blurAndThreshold(y - 1);
+            }
+        }
+        if (p.postBlur) {
+            blurAndThreshold(rows - 1);
+        }
+    }
+
+    const char *getFusedEdgeKernelInstructionSet() {
+        switch (supportedInstructionSet()) {
+        case FusedEdgeInstructionSet::AVX2:
+            return "AVX2";
+        case FusedEdgeInstructionSet::SSE2:
+            return "SSE2";
+        default:
+            return "scalar";
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
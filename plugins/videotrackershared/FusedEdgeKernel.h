@@ -0,0 +1,92 @@
+/** @file
+    @brief Header for a single-pass, SIMD-accelerated edge detection and
+    binarization kernel for 8-bit grayscale images.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FusedEdgeKernel_h_GUID_ADDC88F0_1E1F_4E15_9217_945D02A698F1
+#define INCLUDED_FusedEdgeKernel_h_GUID_ADDC88F0_1E1F_4E15_9217_945D02A698F1
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Largest Laplacian scale factor the fused kernel handles: keeps the
+    /// scaled intermediate within 16 bits.
+    static const int FUSED_EDGE_MAX_SCALE = 16;
+
+    /// Instruction sets the fused kernel has code for, narrowest first.
+    enum class FusedEdgeInstructionSet { Scalar, SSE2, AVX2 };
+
+    struct FusedEdgeKernelParams {
+        /// Integer scale applied to the Laplacian, in [0,
+        /// FUSED_EDGE_MAX_SCALE].
+        int laplacianScale = 1;
+        /// Whether to apply a 3x3 Gaussian blur to the edge image before
+        /// thresholding.
+        bool postBlur = true;
+        /// Pixels (of the optionally-blurred edge image) strictly greater
+        /// than this become 255 in the binary image, the rest 0.
+        int threshold = 0;
+        /// Widest instruction set to use if the CPU supports it: only
+        /// lowered to test the narrower code paths.
+        FusedEdgeInstructionSet maxInstructionSet =
+            FusedEdgeInstructionSet::AVX2;
+    };
+
+    /// @brief Computes, in a single pass over the image, the equivalent of:
+    ///
+    /// - `cv::Laplacian(src, edge, CV_8U, 3, laplacianScale)`
+    /// - if postBlur, `cv::GaussianBlur(edge, tmp, cv::Size(3, 3), 0, 0)`
+    /// - `cv::threshold(postBlur ? tmp : edge, binary, threshold, 255,
+    ///   cv::THRESH_BINARY)`
+    ///
+    /// with the default (reflect-101) border handling, keeping intermediate
+    /// rows in cache rather than making a full pass per step. Uses AVX2 if
+    /// the CPU supports it, SSE2 if the compiler targets it, and scalar code
+    /// otherwise, all with identical results.
+    ///
+    /// Images are 8-bit single channel, rows x cols, with the given row
+    /// strides in bytes. The source must be at least 2x2.
+    ///
+    /// @param scratch Storage reused between calls to avoid allocation.
+    void fusedEdgeDetect(std::uint8_t const *src, std::size_t srcStep,
+                         int rows, int cols, FusedEdgeKernelParams const &p,
+                         std::uint8_t *edge, std::size_t edgeStep,
+                         std::uint8_t *binary, std::size_t binaryStep,
+                         std::vector<std::uint16_t> &scratch);
+
+    /// @brief Name of the widest instruction set the fused kernel uses on
+    /// this CPU: "AVX2", "SSE2", or "scalar".
+    const char *getFusedEdgeKernelInstructionSet();
+} // namespace vbtracker
+} // namespace osvr
+#endif // INCLUDED_FusedEdgeKernel_h_GUID_ADDC88F0_1E1F_4E15_9217_945D02A698F1
@@ -0,0 +1,149 @@
+/** @file
+    @brief Test checking that every code path of the fused edge detection
+    kernel exactly matches the equivalent sequence of OpenCV operations.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <FusedEdgeKernel.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using osvr::vbtracker::FusedEdgeInstructionSet;
+using osvr::vbtracker::FusedEdgeKernelParams;
+using osvr::vbtracker::fusedEdgeDetect;
+
+namespace {
+/// @brief A mostly-dark frame with bright blobs, like those the tracker sees,
+/// plus some noise so that the Laplacian takes on a spread of values.
+cv::Mat makeFrame(int rows, int cols, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(0, 24);
+    cv::Mat ret(rows, cols, CV_8UC1);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            ret.at<std::uint8_t>(y, x) = static_cast<std::uint8_t>(noise(rng));
+        }
+    }
+    std::uniform_int_distribution<int> row(0, rows - 1);
+    std::uniform_int_distribution<int> col(0, cols - 1);
+    for (int i = 0; i < (rows * cols) / 200 + 1; ++i) {
+        cv::circle(ret, cv::Point(col(rng), row(rng)), 2, cv::Scalar(255),
+                   -1);
+    }
+    return ret;
+}
+
+int countMismatched(cv::Mat const &a, cv::Mat const &b) {
+    cv::Mat diff;
+    cv::compare(a, b, diff, cv::CMP_NE);
+    return cv::countNonZero(diff);
+}
+} // namespace
+
+class FusedEdgeKernel
+    : public ::testing::TestWithParam<FusedEdgeInstructionSet> {
+  protected:
+    void checkMatchesOpenCV(cv::Mat const &src, FusedEdgeKernelParams p) {
+        p.maxInstructionSet = GetParam();
+        /// OpenCV reads pixels outside of a region of interest rather than
+        /// reflecting at its borders, so give it a standalone copy.
+        cv::Mat isolated = src.clone();
+        cv::Mat edge, blurred, expected;
+        cv::Laplacian(isolated, edge, CV_8U, 3, p.laplacianScale);
+        if (p.postBlur) {
+            cv::GaussianBlur(edge, blurred, cv::Size(3, 3), 0, 0);
+        } else {
+            blurred = edge;
+        }
+        cv::threshold(blurred, expected, p.threshold, 255, cv::THRESH_BINARY);
+
+        cv::Mat fusedEdge(src.size(), CV_8UC1);
+        cv::Mat fusedBinary(src.size(), CV_8UC1);
+        fusedEdgeDetect(src.data, src.step, src.rows, src.cols, p,
+                        fusedEdge.data, fusedEdge.step, fusedBinary.data,
+                        fusedBinary.step, m_scratch);
+        EXPECT_EQ(0, countMismatched(edge, fusedEdge))
+            << src.rows << "x" << src.cols << ", scale " << p.laplacianScale;
+        EXPECT_EQ(0, countMismatched(expected, fusedBinary))
+            << src.rows << "x" << src.cols << ", scale " << p.laplacianScale
+            << ", threshold " << p.threshold << ", postBlur " << p.postBlur;
+    }
+
+  private:
+    std::vector<std::uint16_t> m_scratch;
+};
+
+TEST_P(FusedEdgeKernel, MatchesOpenCVForAnySize) {
+    /// Includes sizes shorter than, and not multiples of, the vector widths.
+    const int sizes[][2] = {{2, 2}, {3, 5},    {7, 17},   {9, 33},
+                            {16, 64}, {31, 97}, {480, 640}};
+    unsigned seed = 0;
+    for (auto const &size : sizes) {
+        auto src = makeFrame(size[0], size[1], seed++);
+        for (bool postBlur : {false, true}) {
+            FusedEdgeKernelParams p;
+            p.postBlur = postBlur;
+            p.threshold = 40;
+            checkMatchesOpenCV(src, p);
+        }
+    }
+}
+
+TEST_P(FusedEdgeKernel, MatchesOpenCVForAnyScaleAndThreshold) {
+    auto src = makeFrame(60, 150, 42);
+    for (int scale : {0, 1, 2, 5, osvr::vbtracker::FUSED_EDGE_MAX_SCALE}) {
+        for (int threshold : {-1, 0, 1, 40, 128, 254, 255}) {
+            for (bool postBlur : {false, true}) {
+                FusedEdgeKernelParams p;
+                p.laplacianScale = scale;
+                p.threshold = threshold;
+                p.postBlur = postBlur;
+                checkMatchesOpenCV(src, p);
+            }
+        }
+    }
+}
+
+TEST_P(FusedEdgeKernel, MatchesOpenCVWithPaddedRows) {
+    /// A region of interest has a row stride larger than its width.
+    auto frame = makeFrame(100, 200, 7);
+    auto roi = frame(cv::Rect(13, 21, 101, 55));
+    FusedEdgeKernelParams p;
+    p.threshold = 20;
+    checkMatchesOpenCV(roi, p);
+}
+
+/// Instruction sets the CPU lacks fall back to narrower ones, so every
+/// value can be tested anywhere.
+INSTANTIATE_TEST_CASE_P(InstructionSets, FusedEdgeKernel,
+                        ::testing::Values(FusedEdgeInstructionSet::Scalar,
+                                          FusedEdgeInstructionSet::SSE2,
+                                          FusedEdgeInstructionSet::AVX2));
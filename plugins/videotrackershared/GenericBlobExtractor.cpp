@@ -29,10 +29,55 @@
 // - none
 
 // Standard includes
-// - none
+#include <utility>
 
 namespace osvr {
 namespace vbtracker {
+    /// Clips the regions to the image and replaces overlapping regions with
+    /// their bounding rectangle, so no part of the image is searched twice.
+    static inline BlobRegionList mergeRegions(BlobRegionList const &regions,
+                                              cv::Rect const &imageRect) {
+        BlobRegionList ret;
+        ret.reserve(regions.size());
+        for (auto const &region : regions) {
+            auto clipped = region & imageRect;
+            if (clipped.area() == 0) {
+                continue;
+            }
+            /// Absorb any regions we already have that overlap this one -
+            /// repeat, since the grown region may now overlap others.
+            bool merged = true;
+            while (merged) {
+                merged = false;
+                for (auto it = ret.begin(), e = ret.end(); it != e; ++it) {
+                    if ((*it & clipped).area() > 0) {
+                        clipped |= *it;
+                        ret.erase(it);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+            ret.push_back(clipped);
+        }
+        return ret;
+    }
+
+    /// Does the measurement reach a border of the region that isn't also a
+    /// border of the image? If so, the blob may extend past the region.
+    static inline bool touchesRegionBoundary(LedMeasurement const &meas,
+                                             cv::Rect const &region,
+                                             cv::Rect const &imageRect) {
+        auto radius = meas.diameter / 2.f + 1.f;
+        auto x = meas.loc.x;
+        auto y = meas.loc.y;
+        return (region.x > imageRect.x && x - radius < 0) ||
+               (region.y > imageRect.y && y - radius < 0) ||
+               (region.br().x < imageRect.br().x &&
+                x + radius > region.width) ||
+               (region.br().y < imageRect.br().y &&
+                y + radius > region.height);
+    }
 
     GenericBlobExtractor::~GenericBlobExtractor() {}
 
@@ -55,6 +100,7 @@ namespace vbtracker {
     GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage) {
         latestMeasurements_.clear();
         lastGrayImage_ = grayImage.clone();
+        lastImageRange_ = ImageRangeInfo(lastGrayImage_);
 
         m_debugThresholdImageDirty = true;
         m_debugBlobImageDirty = true;
@@ -62,5 +108,36 @@ namespace vbtracker {
         return latestMeasurements_;
     }
 
+    LedMeasurementVec const &
+    GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage,
+                                       BlobRegionList const &regions) {
+        latestMeasurements_.clear();
+        cv::Mat fullImage = grayImage.clone();
+        auto imageRect = cv::Rect(cv::Point(0, 0), fullImage.size());
+        lastImageRange_ = ImageRangeInfo(fullImage);
+
+        m_debugThresholdImageDirty = true;
+        m_debugBlobImageDirty = true;
+        for (auto const &region : mergeRegions(regions, imageRect)) {
+            /// The derived class extracts from whatever getLatestGrayImage()
+            /// returns, so temporarily point that at a (non-copying) view of
+            /// just this region. Extractors can find the full image through
+            /// the view (cv::Mat::locateROI) to size their working buffers.
+            lastGrayImage_ = fullImage(region);
+            auto regionMeasurements = extractBlobs_();
+            for (auto &meas : regionMeasurements) {
+                if (touchesRegionBoundary(meas, region, imageRect)) {
+                    continue;
+                }
+                meas.loc.x += static_cast<float>(region.x);
+                meas.loc.y += static_cast<float>(region.y);
+                meas.imageSize = fullImage.size();
+                latestMeasurements_.push_back(std::move(meas));
+            }
+        }
+        lastGrayImage_ = fullImage;
+        return latestMeasurements_;
+    }
+
 } // namespace vbtracker
 } // namespace osvr
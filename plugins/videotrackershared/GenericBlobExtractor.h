@@ -26,6 +26,7 @@
 #define INCLUDED_GenericBlobExtractor_h_GUID_0EE9AD0D_FCD3_498A_EF04_19D24185ED6B
 
 // Internal Includes
+#include "BlobExtractor.h"
 #include "LedMeasurement.h"
 
 // Library/third-party includes
@@ -33,9 +34,12 @@
 
 // Standard includes
 #include <memory>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
+    /// List of image regions to restrict blob extraction to.
+    using BlobRegionList = std::vector<cv::Rect>;
 
     /// This is an interface/base class for blob extractors that have the
     /// ability to provide graphical debug views at some of their inner workings
@@ -49,11 +53,30 @@ namespace vbtracker {
         cv::Mat const &getDebugBlobImage();
 
         LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage);
+
+        /// Like extractBlobs(cv::Mat const &), but only searches the given
+        /// regions of the image (clipped to the image and merged where they
+        /// overlap), for when the caller can predict where the blobs will be.
+        /// Measurements are reported in full-image coordinates. Blobs cut off
+        /// by a region boundary are skipped rather than reported with a
+        /// skewed center. Thresholds are derived from the whole image, so a
+        /// region holding a single dim LED isn't binarized differently.
+        ///
+        /// Debug images generated by the extractor only reflect the last
+        /// region processed.
+        LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage,
+                                              BlobRegionList const &regions);
         LedMeasurementVec const &getLatestMeasurements() const {
             return latestMeasurements_;
         }
 
       protected:
+        /// The intensity range of the whole image passed to extractBlobs(),
+        /// even while extracting from just one region of it: derived classes
+        /// should base their thresholds on this.
+        ImageRangeInfo const &getLatestImageRange() const {
+            return lastImageRange_;
+        }
         virtual cv::Mat generateDebugThresholdImage_() const = 0;
         virtual cv::Mat generateDebugBlobImage_() const = 0;
         virtual LedMeasurementVec extractBlobs_() = 0;
@@ -61,6 +84,7 @@ namespace vbtracker {
 
       private:
         cv::Mat lastGrayImage_;
+        ImageRangeInfo lastImageRange_;
         LedMeasurementVec latestMeasurements_;
 
         bool m_debugThresholdImageDirty = true;
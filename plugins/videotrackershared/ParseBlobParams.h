@@ -68,6 +68,8 @@ namespace vbtracker {
                              "postEdgeDetectionBlurSize");
         getOptionalParameter(p.postEdgeDetectionBlurThreshold, config,
                              "postEdgeDetectionBlurThreshold");
+        getOptionalParameter(p.fusedEdgeDetection, config,
+                             "fusedEdgeDetection");
     }
 } // End namespace vbtracker
 } // End namespace osvr
@@ -78,7 +78,7 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 // Standard includes
-// - none
+#include <algorithm>
 
 namespace osvr {
 namespace vbtracker {
@@ -94,6 +94,19 @@ namespace vbtracker {
             : kSize_(kSize), destDepth_(destDepth), scale_(scale),
               delta_(delta), borderType_(borderType) {}
 
+        /// Sizes the cached temporaries for images up to the given size, so
+        /// that smaller images (such as regions of interest) can be processed
+        /// later without re-doing the setup.
+        void reserve(cv::Size const &size) {
+            if (size.width > reservedSize_.width ||
+                size.height > reservedSize_.height) {
+                reservedSize_ =
+                    cv::Size(std::max(size.width, reservedSize_.width),
+                             std::max(size.height, reservedSize_.height));
+                setup_ = false;
+            }
+        }
+
         void apply(cv::InputArray mySrc, cv::OutputArray myDst) {
             if (kSize_ == 1 || kSize_ == 3) {
                 // small enough to just use the stock stuff, which doesn't
@@ -113,8 +126,8 @@ namespace vbtracker {
                 /// Must be kept in sync with doesImageMatchCache()
                 srcDepth_ = src.depth();
                 srcChannels_ = src.channels();
-                srcCols_ = src.cols;
-                srcRows_ = src.rows;
+                srcCols_ = std::max(src.cols, reservedSize_.width);
+                srcRows_ = std::max(src.rows, reservedSize_.height);
                 srcType_ = src.type();
                 /// Actually go produce the things we need.
                 setupImpl();
@@ -126,24 +139,28 @@ namespace vbtracker {
             cv::Mat dst = myDst.getMat();
 
             /// the remaining body of cv::Laplacian that we couldn't cache
-            /// between calls.
+            /// between calls, working in the left part of our temporaries if
+            /// this image is narrower than the ones we set up for.
+            int dy0 = std::min(dy0_, src.rows);
+            cv::Mat d2x = d2x_.colRange(0, src.cols);
+            cv::Mat d2y = d2y_.colRange(0, src.cols);
             int y = fx_->start(src), dsty = 0, dy = 0;
             fy_->start(src);
             const uchar *sptr = src.data + y * src.step;
 
-            for (; dsty < src.rows; sptr += dy0_ * src.step, dsty += dy) {
-                fx_->proceed(sptr, (int)src.step, dy0_, d2x_.data,
-                             (int)d2x_.step);
-                dy = fy_->proceed(sptr, (int)src.step, dy0_, d2y_.data,
-                                  (int)d2y_.step);
+            for (; dsty < src.rows; sptr += dy0 * src.step, dsty += dy) {
+                fx_->proceed(sptr, (int)src.step, dy0, d2x.data,
+                             (int)d2x.step);
+                dy = fy_->proceed(sptr, (int)src.step, dy0, d2y.data,
+                                  (int)d2y.step);
                 if (dy > 0) {
                     /// this is just creating a new header, not allocating new
                     /// memory.
                     cv::Mat dstripe = dst.rowRange(dsty, dsty + dy);
-                    d2x_.rows = d2y_.rows =
+                    d2x.rows = d2y.rows =
                         dy; // modify the headers, which should work
-                    d2x_ += d2y_;
-                    d2x_.convertTo(dstripe, destType_, scale_, delta_);
+                    d2x += d2y;
+                    d2x.convertTo(dstripe, destType_, scale_, delta_);
                 }
             }
         }
@@ -152,8 +169,8 @@ namespace vbtracker {
         bool doesImageMatchCache(cv::Mat const &src) const {
             /// must be kept in sync with the if (!setup_) section in apply()
             return (srcDepth_ == src.depth()) &&
-                   (srcChannels_ == src.channels()) && (srcCols_ == src.cols) &&
-                   (srcRows_ == src.rows) && (srcType_ == src.type());
+                   (srcChannels_ == src.channels()) && (srcCols_ >= src.cols) &&
+                   (srcRows_ >= src.rows) && (srcType_ == src.type());
         }
         int ktype() const {
             return std::max<int>({CV_32F, destDepth_, srcDepth_});
@@ -206,10 +223,12 @@ namespace vbtracker {
         /// @{
         int srcDepth_ = 0;
         int srcChannels_ = 0;
+        /// The largest size seen or reserved, which the temporaries fit.
         int srcCols_ = 0;
         int srcRows_ = 0;
         int srcType_ = 0;
         /// @}
+        cv::Size reservedSize_;
         /// @name Generated by setupImpl
         /// @{
         int workType_;
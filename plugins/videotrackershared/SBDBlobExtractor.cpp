@@ -468,7 +468,7 @@ namespace vbtracker {
 
         // Construct a blob detector and find the blobs in the image.
         auto &p = m_params;
-        auto rangeInfo = ImageRangeInfo(grayImage);
+        auto const &rangeInfo = getLatestImageRange();
         if (rangeInfo.maxVal < p.absoluteMinThreshold) {
             /// empty image, early out!
             return;
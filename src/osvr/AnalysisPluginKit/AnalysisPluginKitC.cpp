@@ -27,6 +27,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/PluginHost/HostThreadSection.h>
 #include <osvr/Common/ClientContext.h>
 #include <osvr/Client/CreateContext.h>
 #include <osvr/Util/MacroToolsC.h>
@@ -82,6 +83,10 @@ osvrAnalysisSyncInit(OSVR_IN_PTR OSVR_PluginRegContext ctx,
     OSVR_VALIDATE_OUTPUT_PTR(device, "device token");
     OSVR_VALIDATE_OUTPUT_PTR(clientCtx, "client context");
 
+    // The client context registers handlers on the server's connection, and
+    // the device is already live there once created, so if this is hardware
+    // detection on a worker thread, hold off the server loop throughout.
+    osvr::pluginhost::HostThreadSection section;
     auto initialResult =
         osvrDeviceSyncInitWithOptions(ctx, name, options, device);
     if (initialResult == OSVR_RETURN_FAILURE) {
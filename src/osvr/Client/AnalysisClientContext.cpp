@@ -57,6 +57,9 @@ namespace client {
         /// Create all the remote handler factories.
         populateRemoteHandlerFactory(m_factory, m_vrpnConns);
 
+        // The server's own devices are reached over its connection itself, so
+        // their tracker reports come straight off the in-process report bus
+        // rather than being packed and unpacked by VRPN.
         m_vrpnConns.addConnection(m_mainConn, "localhost");
         m_vrpnConns.addConnection(m_mainConn, host);
         std::string sysDeviceName =
@@ -79,6 +82,13 @@ namespace client {
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
             }));
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                if (!m_pathTreeOwner.applyTreeDelta(delta)) {
+                    OSVR_DEV_VERBOSE("Ignoring path tree delta that does not "
+                                     "apply to our tree");
+                }
+            });
 
         // No startup spin.
     }
@@ -32,15 +32,37 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/PathElementTypes.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
 
 // Standard includes
 #include <unordered_set>
+#include <vector>
 
 namespace osvr {
 namespace client {
+    namespace {
+        /// @brief Summarizes everything about a resolved source that a remote
+        /// handler is constructed from, so we can tell whether a tree update
+        /// requires a new handler.
+        Json::Value summarizeSource(common::OriginalSource const &source) {
+            Json::Value ret(Json::objectValue);
+            ret["device"] = source.getDevicePath();
+            auto const &elt = source.getDeviceElement();
+            ret["deviceName"] = elt.getFullDeviceName();
+            ret["descriptor"] = elt.getDescriptor();
+            ret["interface"] = source.getInterfaceName();
+            auto sensor = source.getSensorNumber();
+            if (sensor) {
+                ret["sensor"] = *sensor;
+            }
+            ret["transform"] = source.getTransformJson();
+            return ret;
+        }
+    } // namespace
+
     ClientInterfaceObjectManager::ClientInterfaceObjectManager(
         common::PathTreeOwner &tree, RemoteHandlerFactory &handlerFactory,
         common::ClientContext &ctx)
@@ -48,10 +70,20 @@ namespace client {
           m_factory(handlerFactory), m_ctx(&ctx) {
         m_treeObserver->setEventCallback(
             common::PathTreeEvents::AboutToUpdate,
-            [&](common::PathTree &) { m_interfaces.clearHandlers(); });
+            [&](common::PathTree &) {
+                m_interfaces.clearHandlers();
+                m_resolvedSources.clear();
+                m_resolutionCache.invalidate();
+            });
         m_treeObserver->setEventCallback(
             common::PathTreeEvents::AfterUpdate,
             [&](common::PathTree &) { m_connectNeededCallbacks(); });
+        m_treeObserver->setEventCallback(
+            common::PathTreeEvents::AfterIncrementalUpdate,
+            [&](common::PathTree &) {
+                m_resolutionCache.invalidate();
+                m_reconnectChangedCallbacks();
+            });
     }
 
     void ClientInterfaceObjectManager::addInterface(
@@ -81,8 +113,10 @@ namespace client {
         /// for this path, if found. Ensures that if we early-out (fail to set
         /// up a handler) we don't have a leftover one still active.
         m_interfaces.eraseHandlerForPath(path);
+        m_resolvedSources.erase(path);
 
-        auto source = common::resolveTreeNode(m_pathTree, path);
+        auto source =
+            common::resolveTreeNode(m_pathTree, path, m_resolutionCache);
         if (!source.is_initialized()) {
             if (verboseFailure) {
                 logger()->info() << "Could not resolve source for " << path;
@@ -100,6 +134,7 @@ namespace client {
             BOOST_ASSERT_MSG(
                 !oldHandler,
                 "We removed the old handler before so it should be null now");
+            m_resolvedSources[path] = summarizeSource(*source);
             return true;
         }
 
@@ -112,6 +147,7 @@ namespace client {
     void ClientInterfaceObjectManager::m_removeCallbacksOnPath(
         std::string const &path) {
         m_interfaces.eraseHandlerForPath(path);
+        m_resolvedSources.erase(path);
     }
 
     void ClientInterfaceObjectManager::m_connectNeededCallbacks() {
@@ -132,6 +168,26 @@ namespace client {
                          << " unconnected paths successfully";
     }
 
+    void ClientInterfaceObjectManager::m_reconnectChangedCallbacks() {
+        std::vector<std::string> changedPaths;
+        for (auto const &resolved : m_resolvedSources) {
+            auto source = common::resolveTreeNode(m_pathTree, resolved.first,
+                                                  m_resolutionCache);
+            if (!source.is_initialized() ||
+                !(summarizeSource(*source) == resolved.second)) {
+                changedPaths.push_back(resolved.first);
+            }
+        }
+        for (auto const &path : changedPaths) {
+            logger()->info() << "Source for " << path
+                             << " changed, replacing its handler";
+            if (!m_connectCallbacksOnPath(path)) {
+                m_removeCallbacksOnPath(path);
+            }
+        }
+        m_connectNeededCallbacks();
+    }
+
     util::log::LoggerPtr const &ClientInterfaceObjectManager::logger() const {
         return m_ctx->logger();
     }
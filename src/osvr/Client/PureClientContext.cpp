@@ -121,6 +121,16 @@ namespace client {
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
             }));
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &msg, util::time::TimeValue const &) {
+                Json::Value delta = msg;
+                replaceLocalhostServers(delta["set"], m_host);
+                if (!m_pathTreeOwner.applyTreeDelta(delta)) {
+                    logger()->debug("Got a path tree delta that does not "
+                                    "apply to our tree, waiting for a full "
+                                    "tree");
+                }
+            });
 
         typedef std::chrono::system_clock clock;
         auto begin = clock::now();
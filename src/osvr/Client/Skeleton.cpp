@@ -74,6 +74,15 @@ OSVR_SkeletonBoneCount OSVR_SkeletonObject::getNumBones() const {
 OSVR_SkeletonJointCount OSVR_SkeletonObject::getNumJoints() const {
     return m_cfg->getNumJoints();
 }
+bool OSVR_SkeletonObject::getSnapshot(OSVR_SkeletonJointState *joints,
+                                      OSVR_SkeletonJointCount jointCapacity,
+                                      OSVR_SkeletonJointCount *numJoints,
+                                      OSVR_SkeletonBoneState *bones,
+                                      OSVR_SkeletonBoneCount boneCapacity,
+                                      OSVR_SkeletonBoneCount *numBones) const {
+    return m_cfg->getSnapshot(joints, jointCapacity, numJoints, bones,
+                              boneCapacity, numBones);
+}
 std::string
 OSVR_SkeletonObject::getBoneName(OSVR_SkeletonBoneCount boneId) const {
     return m_cfg->getBoneName(boneId);
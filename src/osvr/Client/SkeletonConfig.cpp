@@ -139,14 +139,7 @@ namespace client {
         SkeletonConfigPtr cfg(new SkeletonConfig(ctx));
         /// get the path tree
         osvr::common::clonePathTree(articulationTree, cfg->m_articulationTree);
-
-        ArticulationTreeTraverser traverser(cfg->m_jointMap, cfg->m_boneMap,
-                                            cfg->m_jointInterfaces, cfg->m_ctx);
-        osvr::util::traverseWith(
-            articulationTree.getRoot(),
-            [&traverser](osvr::common::PathNode const &node) {
-                osvr::common::applyPathNodeVisitor(traverser, node);
-            });
+        cfg->m_parseArticulationTree();
 
         return cfg;
     }
@@ -162,6 +155,15 @@ namespace client {
 
         /// get the path tree
         osvr::common::clonePathTree(articulationTree, m_articulationTree);
+        m_parseArticulationTree();
+    }
+
+    void SkeletonConfig::updateSkeletonPoses() {
+        m_jointStates.update(m_jointInterfaces);
+        m_boneStates.update(m_boneInterfaces);
+    }
+
+    void SkeletonConfig::m_parseArticulationTree() {
         ArticulationTreeTraverser traverser(m_jointMap, m_boneMap,
                                             m_jointInterfaces, m_ctx);
         osvr::util::traverseWith(
@@ -169,30 +171,15 @@ namespace client {
             [&traverser](osvr::common::PathNode const &node) {
                 osvr::common::applyPathNodeVisitor(traverser, node);
             });
-    }
-
-    void SkeletonConfig::updateSkeletonPoses() {
-
-        // clear old values
-        m_jointPoses.clear();
-        m_bonePoses.clear();
 
-        for (auto &val : m_jointInterfaces) {
-            OSVR_TimeValue timestamp;
-            OSVR_Pose3 pose;
-            osvrPose3SetIdentity(&pose);
-            if (val.second->getState<OSVR_PoseReport>(timestamp, pose)) {
-                m_jointPoses.push_back(std::make_pair(val.first, pose));
-            }
-        }
-        for (auto &val : m_boneInterfaces) {
-            OSVR_TimeValue timestamp;
-            OSVR_Pose3 pose;
-            osvrPose3SetIdentity(&pose);
-            if (val.second->getState<OSVR_PoseReport>(timestamp, pose)) {
-                m_bonePoses.push_back(std::make_pair(val.first, pose));
-            }
-        }
+        // The registries only change here: count them once, rather than on
+        // every query.
+        m_numJoints = static_cast<OSVR_SkeletonJointCount>(
+            m_jointMap.getEntries().size());
+        m_numBones = static_cast<OSVR_SkeletonBoneCount>(
+            m_boneMap.getEntries().size());
+        m_jointStates.reset(m_jointInterfaces, m_numJoints);
+        m_boneStates.reset(m_boneInterfaces, m_numBones);
     }
 } // namespace client
 } // namespace osvr
@@ -28,11 +28,15 @@
 #include "RemoteHandlerInternals.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
+#include <osvr/Common/Buffer.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/InProcessReportBus.h>
 #include <osvr/Common/JSONTransformVisitor.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/Serialization.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerPoseBatch.h>
 #include <osvr/Common/TrackerSensorInfo.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -50,7 +54,7 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace ei = osvr::util::eigen_interop;
 
@@ -63,20 +67,40 @@ namespace client {
             bool reportPosition = false;
             bool reportOrientation = false;
         };
+        /// @param device Device name without host, as its VRPN sender is
+        /// named.
+        /// @param channel If non-null, the device's in-process report
+        /// channel, subscribed to instead of its VRPN messages.
         VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
+                           std::string const &device,
+                           common::InProcessReportChannelPtr const &channel,
                            Options const &options,
                            common::TrackerSensorInfo const &info,
                            common::Transform const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces,
                            common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
+            : m_conn(conn), m_channel(channel), m_transform(t), m_ctx(ctx),
+              m_internals(ifaces), m_opts(options), m_info(info),
+              m_sensor(sensor) {
+            if (m_channel) {
+                m_subscribe(true);
+                OSVR_DEV_VERBOSE("Constructed an in-process TrackerHandler for "
+                                 << src << " sensor "
+                                 << m_sensor.get_value_or(-1));
+                return;
+            }
+            m_remote.reset(new vrpn_Tracker_Remote(src, conn.get()));
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->register_change_handler(this,
                                                   &VRPNTrackerHandler::handle,
                                                   m_sensor.get_value_or(-1));
+                m_poseBatchType = m_conn->register_message_type(
+                    common::messages::TrackerPoseBatch::identifier());
+                m_sender = m_conn->register_sender(device.c_str());
+                m_conn->register_handler(m_poseBatchType,
+                                         &VRPNTrackerHandler::handlePoseBatch,
+                                         this, m_sender);
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
                 m_remote->register_change_handler(
@@ -93,10 +117,17 @@ namespace client {
                              << src << " sensor " << m_sensor.get_value_or(-1));
         }
         virtual ~VRPNTrackerHandler() {
+            if (m_channel) {
+                m_subscribe(false);
+                return;
+            }
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->unregister_change_handler(this,
                                                     &VRPNTrackerHandler::handle,
                                                     m_sensor.get_value_or(-1));
+                m_conn->unregister_handler(m_poseBatchType,
+                                           &VRPNTrackerHandler::handlePoseBatch,
+                                           this, m_sender);
             }
             if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
                 m_remote->unregister_change_handler(
@@ -133,18 +164,86 @@ namespace client {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
+
+        /// @brief Fans a batch of poses out to the per-sensor handling.
+        static int VRPN_CALLBACK handlePoseBatch(void *userdata,
+                                                 vrpn_HANDLERPARAM p) {
+            auto self = static_cast<VRPNTrackerHandler *>(userdata);
+            auto bufReader =
+                common::readExternalBuffer(p.buffer, p.payload_len);
+            common::messages::TrackerPoseBatch::MessageSerialization msg;
+            common::deserialize(bufReader, msg);
+            for (auto const &entry : msg.getEntries()) {
+                if (self->m_sensor &&
+                    OSVR_ChannelCount(*self->m_sensor) != entry.sensor) {
+                    continue;
+                }
+                self->m_handle(entry.pose, entry.sensor, entry.timestamp);
+            }
+            return 0;
+        }
+
+        /// @brief In-process report callback.
+        template <typename StateType>
+        static void handleInProcess(void *userdata, StateType const &state,
+                                    OSVR_ChannelCount sensor,
+                                    util::time::TimeValue const &timestamp) {
+            auto self = static_cast<VRPNTrackerHandler *>(userdata);
+            if (self->m_sensor &&
+                OSVR_ChannelCount(*self->m_sensor) != sensor) {
+                return;
+            }
+            self->m_handle(state, sensor, timestamp);
+        }
+
+        virtual void update() {
+            if (m_remote) {
+                m_remote->mainloop();
+            }
+        }
 
       private:
+        /// Subscribes to (or unsubscribes from) the in-process reports we
+        /// need.
+        void m_subscribe(bool subscribe) {
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                m_subscribeTo<OSVR_PoseState>(subscribe);
+            }
+            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
+                m_subscribeTo<OSVR_VelocityState>(subscribe);
+            }
+            if (m_info.reportsLinearAcceleration ||
+                m_info.reportsAngularAcceleration) {
+                m_subscribeTo<OSVR_AccelerationState>(subscribe);
+            }
+        }
+
+        template <typename StateType> void m_subscribeTo(bool subscribe) {
+            if (subscribe) {
+                m_channel->subscribe<StateType>(&handleInProcess<StateType>,
+                                                this);
+            } else {
+                m_channel->unsubscribe<StateType>(
+                    &handleInProcess<StateType>, this);
+            }
+        }
+
         /// Pass pose messages on to the client
         void m_handle(vrpn_TRACKERCB const &info) {
-            common::tracing::markNewTrackerData();
-            OSVR_PoseReport report;
-            report.sensor = info.sensor;
+            OSVR_PoseState pose;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_handle(pose, info.sensor, timestamp);
+        }
+
+        void m_handle(OSVR_PoseState const &pose, OSVR_ChannelCount sensor,
+                      OSVR_TimeValue const &timestamp) {
+            common::tracing::markNewTrackerData();
+            OSVR_PoseReport report;
+            report.sensor = sensor;
+            report.pose = pose;
             auto xform = getCurrentTransform();
             ei::map(report.pose) =
                 xform.transform(ei::map(report.pose).matrix());
@@ -155,7 +254,7 @@ namespace client {
 
             if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = sensor;
                 positionReport.xyz = report.pose.translation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp,
@@ -164,7 +263,7 @@ namespace client {
 
             if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = sensor;
                 oriReport.rotation = report.pose.rotation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
@@ -173,27 +272,36 @@ namespace client {
 
         /// Pass velocity messages on to the client
         void m_handle(vrpn_TRACKERVELCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
-
+            OSVR_VelocityState state;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            osvrVec3FromQuatlib(&(state.linearVelocity), info.vel);
+            osvrQuatFromQuatlib(&(state.angularVelocity.incrementalRotation),
+                                info.vel_quat);
+            state.angularVelocity.dt = info.vel_quat_dt;
+            m_handle(state, info.sensor, timestamp);
+        }
+
+        void m_handle(OSVR_VelocityState const &velState,
+                      OSVR_ChannelCount sensor,
+                      OSVR_TimeValue const &timestamp) {
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
 
             OSVR_VelocityReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
             auto xform = getCurrentTransform();
 
             overallReport.state.linearVelocityValid =
                 m_info.reportsLinearVelocity;
             if (m_info.reportsLinearVelocity) {
-                OSVR_LinearVelocityState vel;
-                osvrVec3FromQuatlib(&(vel), info.vel);
+                OSVR_LinearVelocityState vel = velState.linearVelocity;
 
                 ei::map(vel) = xform.transformDerivative(ei::map(vel));
 
                 overallReport.state.linearVelocity = vel;
                 OSVR_LinearVelocityReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = vel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
@@ -201,17 +309,14 @@ namespace client {
             overallReport.state.angularVelocityValid =
                 m_info.reportsAngularVelocity;
             if (m_info.reportsAngularVelocity) {
-                OSVR_AngularVelocityState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.vel_quat);
-                state.dt = info.vel_quat_dt;
+                OSVR_AngularVelocityState state = velState.angularVelocity;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularVelocity = state;
                 OSVR_AngularVelocityReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = state;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
@@ -221,27 +326,38 @@ namespace client {
 
         /// Pass acceleration messages on to the client
         void m_handle(vrpn_TRACKERACCCB const &info) {
-            /// @todo should we be marking a trace event here?
-            // common::tracing::markNewTrackerData();
+            OSVR_AccelerationState state;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            osvrVec3FromQuatlib(&(state.linearAcceleration), info.acc);
+            osvrQuatFromQuatlib(
+                &(state.angularAcceleration.incrementalRotation),
+                info.acc_quat);
+            state.angularAcceleration.dt = info.acc_quat_dt;
+            m_handle(state, info.sensor, timestamp);
+        }
 
+        void m_handle(OSVR_AccelerationState const &accelState,
+                      OSVR_ChannelCount sensor,
+                      OSVR_TimeValue const &timestamp) {
+            /// @todo should we be marking a trace event here?
+            // common::tracing::markNewTrackerData();
             OSVR_AccelerationReport overallReport;
-            overallReport.sensor = info.sensor;
+            overallReport.sensor = sensor;
 
             auto xform = getCurrentTransform();
 
             overallReport.state.linearAccelerationValid =
                 m_info.reportsLinearAcceleration;
             if (m_info.reportsLinearAcceleration) {
-                OSVR_LinearAccelerationState accel;
-                osvrVec3FromQuatlib(&(accel), info.acc);
+                OSVR_LinearAccelerationState accel =
+                    accelState.linearAcceleration;
 
                 ei::map(accel) = xform.transformDerivative(ei::map(accel));
 
                 overallReport.state.linearAcceleration = accel;
                 OSVR_LinearAccelerationReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = accel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
@@ -249,24 +365,27 @@ namespace client {
                 m_info.reportsAngularAcceleration;
             if (m_info.reportsAngularAcceleration) {
 
-                OSVR_AngularAccelerationState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.acc_quat);
-                state.dt = info.acc_quat_dt;
+                OSVR_AngularAccelerationState state =
+                    accelState.angularAcceleration;
 
                 ei::map(state.incrementalRotation) = xform.transformDerivative(
                     ei::map(state.incrementalRotation));
 
                 overallReport.state.angularAcceleration = state;
                 OSVR_AngularAccelerationReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = state;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
+        vrpn_ConnectionPtr m_conn;
+        /// @brief Only if not using the in-process channel.
         unique_ptr<vrpn_Tracker_Remote> m_remote;
+        vrpn_int32 m_poseBatchType = -1;
+        vrpn_int32 m_sender = -1;
+        common::InProcessReportChannelPtr m_channel;
         common::Transform m_transform;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
@@ -304,10 +423,16 @@ namespace client {
             xform = xformParse.getTransform();
         }
 
+        // A device served on the very connection we'd receive it over lives
+        // in this process: skip VRPN and take its reports directly.
+        auto conn = m_conns.getConnection(devElt);
+        auto channel =
+            common::findInProcessReports(conn.get(), devElt.getDeviceName());
+
         /// @todo find out why make_shared causes a crash here
         ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, info, xform, source.getSensorNumber(), ifaces, ctx));
+            conn, devElt.getFullDeviceName().c_str(), devElt.getDeviceName(),
+            channel, opts, info, xform, source.getSensorNumber(), ifaces, ctx));
         return ret;
     }
 
@@ -26,6 +26,7 @@
 #include <osvr/Client/Viewer.h>
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Util/EigenInterop.h>
 
 // Library/third-party includes
 // - none
@@ -52,5 +53,14 @@ namespace client {
         return m_head->hasStateForReportType<OSVR_PoseReport>();
     }
 
+    Eigen::Isometry3d
+    Viewer::getPoseIsometryAtTime(util::time::TimeValue const &when) const {
+        OSVR_PoseState pose;
+        if (!m_head->getPoseStateAtTime(when, pose)) {
+            throw NoPoseYet();
+        }
+        return util::fromPose(pose);
+    }
+
 } // namespace client
 } // namespace osvr
@@ -45,11 +45,15 @@ namespace client {
         if (!hasState) {
             throw NoPoseYet();
         }
-        Eigen::Isometry3d transformedPose =
-            util::fromPose(pose) * Eigen::Translation3d(m_offset) *
-            Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
-                              Eigen::Vector3d::UnitY());
-        return transformedPose;
+        return getPoseIsometry(util::fromPose(pose));
+    }
+
+    Eigen::Isometry3d
+    ViewerEye::getPoseIsometry(Eigen::Isometry3d const &viewerPose) const {
+        Eigen::Isometry3d eyeFromViewer = Eigen::Isometry3d::Identity();
+        eyeFromViewer.linear() = m_eyeRotation;
+        eyeFromViewer.translation() = m_offset;
+        return viewerPose * eyeFromViewer;
     }
     OSVR_Pose3 ViewerEye::getPose() const {
         Eigen::Isometry3d transformedPose = getPoseIsometry();
@@ -67,6 +71,11 @@ namespace client {
         return transformedPose.inverse().matrix();
     }
 
+    Eigen::Matrix4d
+    ViewerEye::getView(Eigen::Isometry3d const &viewerPose) const {
+        return getPoseIsometry(viewerPose).inverse().matrix();
+    }
+
     util::Rectd ViewerEye::m_getRect(double near, double /*far*/ = 100) const {
         util::Rectd rect(m_unitBounds);
         // Scale the in-plane positions based on the near plane to put
@@ -194,7 +203,11 @@ namespace client {
           m_unitBounds(unitBounds), m_rot180(rot180), m_pitchTilt(pitchTilt),
           m_radDistortParams(radDistortParams),
           m_displayInputIdx(displayInputIdx),
-          m_opticalAxisOffsetY(opticalAxisOffsetY) {}
+          m_opticalAxisOffsetY(opticalAxisOffsetY),
+          m_eyeRotation(
+              Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
+                                Eigen::Vector3d::UnitY())
+                  .toRotationMatrix()) {}
 
 } // namespace client
 } // namespace osvr
@@ -33,12 +33,15 @@
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/MatrixConventions.h>
 #include <osvr/Util/MatrixEigenAssign.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
 
 // Standard includes
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 struct OSVR_DisplayConfigObject {
     OSVR_DisplayConfigObject(OSVR_ClientContext context)
@@ -225,6 +228,23 @@ OSVR_ReturnCode osvrClientGetViewerEyePose(OSVR_DisplayConfig disp,
     return OSVR_RETURN_FAILURE;
 }
 
+template <typename Scalar>
+static inline bool nearFarValid(Scalar near, Scalar far) {
+    if (near == 0 || far == 0) {
+        OSVR_DEV_VERBOSE("Can't specify a near or far distance as 0!");
+        return false;
+    }
+    if (near < 0 || far < 0) {
+        OSVR_DEV_VERBOSE("Can't specify a negative near or far distance!");
+        return false;
+    }
+    if (near == far) {
+        OSVR_DEV_VERBOSE("Can't specify equal near and far distances!");
+        return false;
+    }
+    return true;
+}
+
 template <typename Scalar>
 static inline OSVR_ReturnCode getViewMatrixImpl(OSVR_DisplayConfig disp,
                                                 OSVR_ViewerCount viewer,
@@ -265,6 +285,87 @@ OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     return getViewMatrixImpl(disp, viewer, eye, mat, flags);
 }
 
+template <typename Scalar>
+static inline OSVR_ReturnCode getEyeMatricesAtTimeImpl(
+    OSVR_DisplayConfig disp, const OSVR_TimeValue *displayTime, Scalar near,
+    Scalar far, OSVR_MatrixConventions flags, OSVR_EyeCount numEyes,
+    Scalar *viewMatrices, Scalar *projectionMatrices) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_OUTPUT_PTR(viewMatrices, "view matrices");
+    if (!nearFarValid(near, far)) {
+        return OSVR_RETURN_FAILURE;
+    }
+    auto &cfg = *disp->cfg;
+    const auto numViewers = cfg.getNumViewers();
+    std::size_t totalEyes = 0;
+    for (OSVR_ViewerCount viewer = 0; viewer < numViewers; ++viewer) {
+        /// Check up front, so we don't fail part way through the output.
+        if (!cfg.getViewer(viewer).hasPose()) {
+            OSVR_DEV_VERBOSE(
+                "Error getting display eye matrices: no pose yet available");
+            return OSVR_RETURN_FAILURE;
+        }
+        totalEyes += cfg.getNumViewerEyes(viewer);
+    }
+    if (numEyes < totalEyes) {
+        OSVR_DEV_VERBOSE("Error getting display eye matrices: output has room "
+                         "for "
+                         << int(numEyes) << " eyes but there are "
+                         << totalEyes);
+        return OSVR_RETURN_FAILURE;
+    }
+    /// Fill local buffers, and only copy them out once everything succeeded,
+    /// so an exception part way through leaves the outputs unmodified.
+    std::vector<Scalar> views(totalEyes * OSVR_MATRIX_SIZE);
+    std::vector<Scalar> projections(projectionMatrices ? views.size() : 0);
+    try {
+        std::size_t outputIdx = 0;
+        for (OSVR_ViewerCount viewer = 0; viewer < numViewers; ++viewer) {
+            auto &viewerObj = cfg.getViewer(viewer);
+            /// One pose snapshot for all of this viewer's eyes.
+            Eigen::Isometry3d viewerPose =
+                displayTime ? viewerObj.getPoseIsometryAtTime(*displayTime)
+                            : osvr::util::fromPose(viewerObj.getPose());
+            const auto numViewerEyes = cfg.getNumViewerEyes(viewer);
+            for (OSVR_EyeCount eye = 0; eye < numViewerEyes;
+                 ++eye, ++outputIdx) {
+                auto &eyeObj = cfg.getViewerEye(viewer, eye);
+                osvr::util::matrixEigenAssign(
+                    eyeObj.getView(viewerPose), flags,
+                    views.data() + outputIdx * OSVR_MATRIX_SIZE);
+                if (projectionMatrices) {
+                    osvr::util::matrixEigenAssign(
+                        eyeObj.getProjection(near, far, flags), flags,
+                        projections.data() + outputIdx * OSVR_MATRIX_SIZE);
+                }
+            }
+        }
+    } catch (std::exception &e) {
+        OSVR_DEV_VERBOSE(
+            "Error getting display eye matrices - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+    std::copy(begin(views), end(views), viewMatrices);
+    std::copy(begin(projections), end(projections), projectionMatrices);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetDisplayEyeMatricesAtTimed(
+    OSVR_DisplayConfig disp, const OSVR_TimeValue *displayTime, double near,
+    double far, OSVR_MatrixConventions flags, OSVR_EyeCount numEyes,
+    double *viewMatrices, double *projectionMatrices) {
+    return getEyeMatricesAtTimeImpl(disp, displayTime, near, far, flags,
+                                    numEyes, viewMatrices, projectionMatrices);
+}
+
+OSVR_ReturnCode osvrClientGetDisplayEyeMatricesAtTimef(
+    OSVR_DisplayConfig disp, const OSVR_TimeValue *displayTime, float near,
+    float far, OSVR_MatrixConventions flags, OSVR_EyeCount numEyes,
+    float *viewMatrices, float *projectionMatrices) {
+    return getEyeMatricesAtTimeImpl(disp, displayTime, near, far, flags,
+                                    numEyes, viewMatrices, projectionMatrices);
+}
+
 OSVR_ReturnCode
 osvrClientGetNumSurfacesForViewerEye(OSVR_DisplayConfig disp,
                                      OSVR_ViewerCount viewer, OSVR_EyeCount eye,
@@ -327,16 +428,7 @@ getProjectionMatrixImpl(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer,
     OSVR_VALIDATE_EYE_ID;
     OSVR_VALIDATE_SURFACE_ID;
     OSVR_VALIDATE_OUTPUT_PTR(mat, "projection matrix");
-    if (near == 0 || far == 0) {
-        OSVR_DEV_VERBOSE("Can't specify a near or far distance as 0!");
-        return OSVR_RETURN_FAILURE;
-    }
-    if (near < 0 || far < 0) {
-        OSVR_DEV_VERBOSE("Can't specify a negative near or far distance!");
-        return OSVR_RETURN_FAILURE;
-    }
-    if (near == far) {
-        OSVR_DEV_VERBOSE("Can't specify equal near and far distances!");
+    if (!nearFarValid(near, far)) {
         return OSVR_RETURN_FAILURE;
     }
     osvr::util::matrixEigenAssign(
@@ -62,3 +62,22 @@ OSVR_CALLBACK_METHODS(NaviPosition)
 OSVR_CALLBACK_METHODS(Skeleton)
 
 #undef OSVR_CALLBACK_METHODS
+
+OSVR_ReturnCode osvrClientEnablePoseHistory(OSVR_ClientInterface iface,
+                                            uint32_t capacity) {
+    if (!iface || capacity == 0) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->enableStateHistory<OSVR_PoseReport>(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                                       const struct OSVR_TimeValue *when,
+                                       OSVR_PoseState *state) {
+    if (!iface || !when || !state) {
+        return OSVR_RETURN_FAILURE;
+    }
+    bool hasState = iface->getPoseStateAtTime(*when, *state);
+    return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
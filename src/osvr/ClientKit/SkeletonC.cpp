@@ -253,4 +253,22 @@ osvrClientGetSkeletonNumJoints(OSVR_Skeleton skel,
     OSVR_VALIDATE_OUTPUT_PTR(numJoints, "number of joints");
     *numJoints = skel->getNumJoints();
     return OSVR_RETURN_SUCCESS;
-}
\ No newline at end of file
+}
+OSVR_ReturnCode osvrClientGetSkeletonSnapshot(
+    OSVR_Skeleton skel, OSVR_SkeletonJointState *joints,
+    OSVR_SkeletonJointCount jointCapacity, OSVR_SkeletonJointCount *numJoints,
+    OSVR_SkeletonBoneState *bones, OSVR_SkeletonBoneCount boneCapacity,
+    OSVR_SkeletonBoneCount *numBones) {
+    OSVR_VALIDATE_SKELETON_CONFIG;
+    OSVR_VALIDATE_OUTPUT_PTR(numJoints, "number of joint states");
+    OSVR_VALIDATE_OUTPUT_PTR(numBones, "number of bone states");
+    if (!skel->getSnapshot(joints, jointCapacity, numJoints, bones,
+                           boneCapacity, numBones)) {
+        OSVR_DEV_VERBOSE("Error getting skeleton snapshot: room for "
+                         << jointCapacity << " joints and " << boneCapacity
+                         << " bones, need " << *numJoints << " and "
+                         << *numBones);
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PoseAtTime.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -42,4 +43,10 @@ std::string const &OSVR_ClientInterfaceObject::getPath() const {
     return m_path;
 }
 
+bool OSVR_ClientInterfaceObject::getPoseStateAtTime(
+    osvr::util::time::TimeValue const &when, OSVR_PoseState &state) const {
+    osvr::common::tracing::markGetState(m_path);
+    return osvr::common::getPoseAtTime(m_state, when, state);
+}
+
 void OSVR_ClientInterfaceObject::update() {}
@@ -28,6 +28,7 @@
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
 #include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 #include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Util/Log.h>
 #include <osvr/Util/Logger.h>
@@ -36,6 +37,7 @@
 #include <boost/version.hpp>
 
 // Standard includes
+#include <cstring>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -53,7 +55,10 @@ namespace common {
     /// shared-memory objects (Bookkeeping, ElementData) changes, if Boost
     /// Interprocess changes affect the utilized ABI, or if other changes occur
     /// that would interfere with communication.
-    static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
+    ///
+    /// - Level 1: added generation stamps to ElementData and the lock-free
+    ///   mode fields to Bookkeeping.
+    static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 1;
 
 #ifdef _WIN32
 #if (BOOST_VERSION < 105400)
@@ -226,6 +231,24 @@ namespace common {
         }
     } // namespace
 
+    namespace detail {
+        IPCPutResult::~IPCPutResult() {
+            if (nullptr != lockFreeBookkeeping) {
+                if (abandoned) {
+                    lockFreeBookkeeping->abandonElementLockFree(seq);
+                } else {
+                    lockFreeBookkeeping->commitElementLockFree(seq);
+                }
+                return;
+            }
+#ifdef OSVR_SHM_LOCK_DEBUGGING
+            OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence " << seq);
+#endif
+            elementLock.unlock();
+            boundsLock.unlock();
+        }
+    } // namespace detail
+
     IPCRingBuffer::BufferWriteProxy::BufferWriteProxy(
         detail::IPCPutResultPtr &&data, IPCRingBufferPtr &&shm)
         : m_buf(nullptr), m_seq(0), m_data(std::move(data)) {
@@ -236,6 +259,14 @@ namespace common {
         }
     }
 
+    void IPCRingBuffer::BufferWriteProxy::abandon() {
+        if (m_data) {
+            m_data->abandoned = true;
+            m_data.reset();
+        }
+        m_buf = nullptr;
+    }
+
     IPCRingBuffer::BufferReadProxy::BufferReadProxy(
         detail::IPCGetResultPtr &&data, IPCRingBufferPtr &&shm)
         : m_buf(nullptr), m_seq(0), m_data(std::move(data)) {
@@ -294,28 +325,47 @@ namespace common {
             m_bookkeeping = m_seg->getBookkeeping();
             m_opts.setEntries(m_bookkeeping->getCapacity());
             m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            m_opts.setLockFree(m_bookkeeping->isLockFree());
         }
 
         detail::IPCPutResultPtr put() {
+            if (m_opts.getLockFree()) {
+                return m_bookkeeping->produceElementLockFree();
+            }
             return m_bookkeeping->produceElement();
         }
 
         detail::IPCGetResultPtr get(sequence_type num) {
             detail::IPCGetResultPtr ret;
+            if (m_opts.getLockFree()) {
+                auto copy = m_makeCopyBuffer();
+                if (m_bookkeeping->readElementLockFree(num, copy.get())) {
+                    ret = m_wrapCopy(std::move(copy), num);
+                }
+                return ret;
+            }
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
             if (nullptr != elt) {
                 auto readerLock = elt->getSharableLock();
                 auto buf = elt->getBuf(readerLock);
                 /// The nullptr will be filled in by the main object.
-                ret.reset(new detail::IPCGetResult{buf, std::move(readerLock),
-                                                   num, nullptr});
+                ret.reset(new detail::IPCGetResult{
+                    buf, std::move(readerLock), num, nullptr, nullptr});
             }
             return ret;
         }
 
         detail::IPCGetResultPtr getLatest() {
             detail::IPCGetResultPtr ret;
+            if (m_opts.getLockFree()) {
+                auto copy = m_makeCopyBuffer();
+                sequence_type num;
+                if (m_bookkeeping->readLatestLockFree(copy.get(), num)) {
+                    ret = m_wrapCopy(std::move(copy), num);
+                }
+                return ret;
+            }
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->back(boundsLock);
             if (nullptr != elt) {
@@ -324,7 +374,8 @@ namespace common {
                 /// The nullptr will be filled in by the main object.
                 ret.reset(new detail::IPCGetResult{
                     buf, std::move(readerLock),
-                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr});
+                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr,
+                    nullptr});
             }
             return ret;
         }
@@ -332,6 +383,20 @@ namespace common {
         Options const &getOpts() const { return m_opts; }
 
       private:
+        util::AlignedImageBufferPtr m_makeCopyBuffer() const {
+            return util::makeAlignedImageBuffer(m_opts.getEntrySize(),
+                                                m_opts.getAlignment());
+        }
+
+        static detail::IPCGetResultPtr
+        m_wrapCopy(util::AlignedImageBufferPtr &&copy, sequence_type num) {
+            auto buf = copy.get();
+            /// The nullptr will be filled in by the main object.
+            return detail::IPCGetResultPtr(new detail::IPCGetResult{
+                buf, ipc::sharable_lock_type(), num, nullptr,
+                std::move(copy)});
+        }
+
         unique_ptr<SharedMemorySegmentHolder> m_seg;
         detail::Bookkeeping *m_bookkeeping;
 
@@ -412,6 +477,10 @@ namespace common {
         return m_impl->getOpts().getEntries();
     }
 
+    bool IPCRingBuffer::isLockFree() const {
+        return m_impl->getOpts().getLockFree();
+    }
+
     IPCRingBuffer::BufferWriteProxy IPCRingBuffer::put() {
         return BufferWriteProxy(m_impl->put(), shared_from_this());
     }
@@ -29,6 +29,7 @@
 #include <osvr/Common/IPCRingBuffer.h>
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 
 // Library/third-party includes
 // - none
@@ -40,20 +41,21 @@ namespace osvr {
 namespace common {
 
     namespace detail {
+        class Bookkeeping;
         struct IPCPutResult {
-            ~IPCPutResult() {
-#ifdef OSVR_SHM_LOCK_DEBUGGING
-                OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
-                                 << seq);
-#endif
-                elementLock.unlock();
-                boundsLock.unlock();
-            }
+            /// @brief Defined out of line, since in lock-free mode it must
+            /// call into the Bookkeeping object to publish the element.
+            ~IPCPutResult();
             IPCRingBuffer::value_type *buffer;
             IPCRingBuffer::sequence_type seq;
             ipc::exclusive_lock_type elementLock;
             ipc::exclusive_lock_type boundsLock;
             IPCRingBufferPtr shm;
+            /// @brief Non-null only in lock-free mode.
+            Bookkeeping *lockFreeBookkeeping;
+            /// @brief Set (lock-free mode only) to release the element
+            /// without publishing it.
+            bool abandoned;
         };
 
         struct IPCGetResult {
@@ -62,12 +64,16 @@ namespace common {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing shared lock on sequence " << seq);
 #endif
-                elementLock.unlock();
+                if (elementLock) {
+                    elementLock.unlock();
+                }
             }
             IPCRingBuffer::value_type *buffer;
             ipc::sharable_lock_type elementLock;
             IPCRingBuffer::sequence_type seq;
             IPCRingBufferPtr shm;
+            /// @brief In lock-free mode, owns the copy that buffer points to.
+            util::AlignedImageBufferPtr copy;
         };
     } // namespace detail
 
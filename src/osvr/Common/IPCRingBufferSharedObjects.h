@@ -37,6 +37,8 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <atomic>
+#include <cstring>
 #include <utility>
 
 namespace osvr {
@@ -45,11 +47,21 @@ namespace common {
     namespace detail {
         namespace bip = boost::interprocess;
 
+        /// @brief The type used for generation stamps in lock-free mode: must
+        /// be lock-free (and thus address-free) to be usable across processes.
+        typedef std::atomic<uint32_t> atomic_stamp_type;
+        static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                      "Lock-free ring buffer mode requires always-lock-free "
+                      "32-bit atomics to be usable in shared memory.");
+
         class ElementData : public ipc::ObjectWithMutex, boost::noncopyable {
           public:
             typedef IPCRingBuffer::value_type BufferType;
+            typedef IPCRingBuffer::sequence_type sequence_type;
 
-            ElementData() : m_buf(nullptr) {}
+            ElementData()
+                : m_buf(nullptr), m_generation(UNWRITTEN_GENERATION),
+                  m_seq(0) {}
 
             template <typename LockType>
             BufferType *getBuf(LockType &lock) const {
@@ -57,6 +69,56 @@ namespace common {
                 return m_buf.get();
             }
 
+            /// @name Lock-free mode (seqlock-style) access
+            /// @brief The generation is odd while the (single) producer is
+            /// writing, and is bumped to an even value once the element is
+            /// complete. Readers copy the data out, then verify the generation
+            /// didn't change. A generation of UNWRITTEN_GENERATION means the
+            /// element has never been completely written, and holds no data.
+            /// @{
+            /// @brief Marks the element as being written for the given
+            /// sequence number, and returns the buffer to write to.
+            BufferType *beginWrite(sequence_type seq) {
+                auto gen = m_generation.load(std::memory_order_relaxed);
+                m_generation.store(gen + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_seq.store(seq, std::memory_order_relaxed);
+                return m_buf.get();
+            }
+
+            /// @brief Marks the element as complete and visible to readers.
+            void endWrite() {
+                auto gen = m_generation.load(std::memory_order_relaxed) + 1;
+                if (UNWRITTEN_GENERATION == gen) {
+                    // Skip the sentinel when the stamp wraps.
+                    gen += 2;
+                }
+                m_generation.store(gen, std::memory_order_release);
+            }
+
+            /// @brief Copies the element into dest if it currently holds
+            /// the given sequence number and wasn't modified during the copy.
+            /// @return true if dest contains a consistent copy.
+            bool tryRead(sequence_type seq, BufferType *dest,
+                         size_t len) const {
+                auto gen = m_generation.load(std::memory_order_acquire);
+                if (gen & 0x1) {
+                    // write in progress
+                    return false;
+                }
+                if (UNWRITTEN_GENERATION == gen) {
+                    // never written: m_seq and the buffer are meaningless
+                    return false;
+                }
+                if (m_seq.load(std::memory_order_relaxed) != seq) {
+                    return false;
+                }
+                std::memcpy(dest, m_buf.get(), len);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return m_generation.load(std::memory_order_relaxed) == gen;
+            }
+            /// @}
+
             template <typename ManagedMemory>
             void allocateBuf(ManagedMemory &shm,
                              IPCRingBuffer::Options const &opts) {
@@ -73,13 +135,17 @@ namespace common {
             }
 
           private:
+            static const uint32_t UNWRITTEN_GENERATION = 0;
             ipc_offset_ptr<BufferType> m_buf;
+            atomic_stamp_type m_generation;
+            atomic_stamp_type m_seq;
         };
 
         class Bookkeeping : public ipc::ObjectWithMutex, boost::noncopyable {
           public:
             typedef IPCRingBuffer::sequence_type sequence_type;
             typedef uint16_t raw_index_type;
+            typedef ElementData::BufferType BufferType;
 
             template <typename ManagedMemory>
             static Bookkeeping *find(ManagedMemory &shm) {
@@ -111,7 +177,9 @@ namespace common {
                   elementArray(shm.template construct<ElementData>(
                       bip::unique_instance)[m_capacity]()),
                   m_beginSequenceNumber(0), m_nextSequenceNumber(0), m_begin(0),
-                  m_size(0), m_bufLen(opts.getEntrySize()) {
+                  m_size(0), m_bufLen(opts.getEntrySize()),
+                  m_lockFree(opts.getLockFree()), m_latestPublished(0),
+                  m_anyPublished(0) {
 
                 auto lock = getExclusiveLock();
                 {
@@ -146,6 +214,9 @@ namespace common {
             /// @brief Get capacity of elements.
             uint32_t getBufferLength() const { return m_bufLen; }
 
+            /// @brief Was this buffer created in lock-free mode?
+            bool isLockFree() const { return m_lockFree; }
+
             template <typename LockType>
             ElementData &getByRawIndex(raw_index_type index, LockType &lock) {
                 verifyReaderLock(lock);
@@ -201,11 +272,72 @@ namespace common {
                 /// shared memory nullptr filled in by outer class
                 IPCPutResultPtr ret(new IPCPutResult{
                     back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                    std::move(elementLock), std::move(lock), nullptr, nullptr,
+                    false});
                 return ret;
             }
 
+            /// @name Lock-free mode
+            /// @brief Only valid if isLockFree(): the mutexes are not used in
+            /// this mode, so there must be only a single producer.
+            /// @{
+            IPCPutResultPtr produceElementLockFree() {
+                auto sequenceNumber = m_nextSequenceNumber;
+                m_nextSequenceNumber++;
+                auto &elt = m_getBySequenceNumberLockFree(sequenceNumber);
+                /// shared memory nullptr filled in by outer class
+                IPCPutResultPtr ret(new IPCPutResult{
+                    elt.beginWrite(sequenceNumber), sequenceNumber,
+                    ipc::exclusive_lock_type(), ipc::exclusive_lock_type(),
+                    nullptr, this, false});
+                return ret;
+            }
+
+            /// @brief Called once the producer is done writing the element
+            /// with the given sequence number.
+            void commitElementLockFree(sequence_type num) {
+                m_getBySequenceNumberLockFree(num).endWrite();
+                m_latestPublished.store(num, std::memory_order_release);
+                m_anyPublished.store(1, std::memory_order_release);
+            }
+
+            /// @brief Called instead of commitElementLockFree() if the
+            /// producer gives up on the element: it is left consistent for
+            /// the seqlock but never becomes the latest published element, and
+            /// no client is ever told its sequence number.
+            void abandonElementLockFree(sequence_type num) {
+                m_getBySequenceNumberLockFree(num).endWrite();
+            }
+
+            /// @brief Attempts to copy the element with the given sequence
+            /// number into dest (which must be at least getBufferLength()
+            /// bytes).
+            bool readElementLockFree(sequence_type num, BufferType *dest) {
+                return m_getBySequenceNumberLockFree(num).tryRead(num, dest,
+                                                                  m_bufLen);
+            }
+
+            /// @brief Attempts to copy the most recently published element
+            /// into dest, retrying a few times if the producer laps us.
+            bool readLatestLockFree(BufferType *dest, sequence_type &num) {
+                static const int MAX_ATTEMPTS = 3;
+                if (0 == m_anyPublished.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                for (int i = 0; i < MAX_ATTEMPTS; ++i) {
+                    num = m_latestPublished.load(std::memory_order_acquire);
+                    if (readElementLockFree(num, dest)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            /// @}
+
           private:
+            ElementData &m_getBySequenceNumberLockFree(sequence_type num) {
+                return *(elementArray + (num % m_capacity));
+            }
             raw_index_type m_capacity;
             ipc_offset_ptr<ElementData> elementArray;
             IPCRingBuffer::sequence_type m_beginSequenceNumber;
@@ -213,6 +345,9 @@ namespace common {
             raw_index_type m_begin;
             raw_index_type m_size;
             uint32_t m_bufLen;
+            bool m_lockFree;
+            atomic_stamp_type m_latestPublished;
+            atomic_stamp_type m_anyPublished;
         };
     } // namespace detail
 
@@ -0,0 +1,214 @@
+/** @file
+    @brief Header containing the splitting of images into chunks for sending
+    over the network, and their reassembly on the receiving end.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageChunkAssembly_h_GUID_B8BEEDA9_8F51_4DBC_BDE0_19ED52D2A36E
+#define INCLUDED_ImageChunkAssembly_h_GUID_B8BEEDA9_8F51_4DBC_BDE0_19ED52D2A36E
+
+// Internal Includes
+#include "ImageWireCodec.h"
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    inline uint32_t getBufferSize(OSVR_ImagingMetadata const &meta) {
+        return meta.height * meta.width * meta.depth * meta.channels;
+    }
+    inline bool sameMetadata(OSVR_ImagingMetadata const &a,
+                             OSVR_ImagingMetadata const &b) {
+        return a.height == b.height && a.width == b.width &&
+               a.channels == b.channels && a.depth == b.depth &&
+               a.type == b.type;
+    }
+
+    /// @brief Raw image bytes per chunk: chosen so that a chunk's worst-case
+    /// encoding plus header still fits in a single VRPN TCP message.
+    static const uint32_t WIRE_CHUNK_RAW_SIZE = 60000;
+
+    /// @brief The number of chunks an image of the given size is sent in.
+    inline uint32_t getChunkCount(uint32_t bytes) {
+        return (bytes + WIRE_CHUNK_RAW_SIZE - 1) / WIRE_CHUNK_RAW_SIZE;
+    }
+
+    namespace messages {
+        /// @brief Everything in an image chunk message but the payload.
+        struct ImageChunkHeader {
+            OSVR_ImagingMetadata metadata;
+            OSVR_ChannelCount sensor;
+            uint32_t frame;
+            uint32_t chunk;
+            uint32_t chunkCount;
+            uint32_t rawOffset;
+            uint32_t rawLength;
+            ImageWireCompression encoding;
+        };
+    } // namespace messages
+
+    /// @brief Splits an image into chunks, each encoded with the given
+    /// compression if that makes it smaller, calling
+    /// f(header, payload, payloadLength) for each in order.
+    template <typename F>
+    inline void forEachImageChunk(OSVR_ImagingMetadata const &metadata,
+                                  OSVR_ImageBufferElement const *imageData,
+                                  OSVR_ChannelCount sensor, uint32_t frame,
+                                  ImageWireCompression compression, F &&f) {
+        auto bytes = getBufferSize(metadata);
+        messages::ImageChunkHeader header;
+        header.metadata = metadata;
+        header.sensor = sensor;
+        header.frame = frame;
+        header.chunkCount = getChunkCount(bytes);
+        std::vector<uint8_t> encoded;
+        for (uint32_t i = 0; i < header.chunkCount; ++i) {
+            header.chunk = i;
+            header.rawOffset = i * WIRE_CHUNK_RAW_SIZE;
+            header.rawLength =
+                std::min(WIRE_CHUNK_RAW_SIZE, bytes - header.rawOffset);
+            auto raw = imageData + header.rawOffset;
+            uint8_t const *payload = raw;
+            uint32_t payloadLen = header.rawLength;
+            header.encoding = ImageWireCompression::None;
+            if (compression == ImageWireCompression::RunLength) {
+                encoded.clear();
+                image_codec::rleEncode(raw, header.rawLength, encoded);
+                if (encoded.size() < header.rawLength) {
+                    header.encoding = ImageWireCompression::RunLength;
+                    payload = encoded.data();
+                    payloadLen = static_cast<uint32_t>(encoded.size());
+                }
+            }
+            f(header, payload, payloadLen);
+        }
+    }
+
+    /// @brief Client-side reassembly of the chunked images of one sensor.
+    /// Chunks may arrive in any order, but a chunk of a new frame drops any
+    /// incomplete previous frame.
+    class ImageChunkAssembler {
+      public:
+        /// @brief Adds a received chunk, ignoring it if malformed.
+        ///
+        /// @return true if this completed a frame, now available from
+        /// getImage().
+        bool addChunk(messages::ImageChunkHeader const &header,
+                      uint8_t const *payload, uint32_t payloadLen) {
+            auto bytes = getBufferSize(header.metadata);
+            if (header.chunk >= header.chunkCount ||
+                header.chunkCount != getChunkCount(bytes) ||
+                header.rawOffset != header.chunk * WIRE_CHUNK_RAW_SIZE ||
+                header.rawLength > WIRE_CHUNK_RAW_SIZE ||
+                header.rawOffset > bytes ||
+                header.rawLength > bytes - header.rawOffset) {
+                OSVR_DEV_VERBOSE("Ignoring malformed image chunk");
+                return false;
+            }
+
+            if (!m_active || m_frame != header.frame) {
+                // Start of a new frame: any incomplete previous frame is
+                // dropped.
+                m_active = true;
+                m_frame = header.frame;
+                m_image.sensor = header.sensor;
+                m_image.metadata = header.metadata;
+                m_chunkCount = header.chunkCount;
+                m_chunksRemaining = header.chunkCount;
+                m_received.assign(header.chunkCount, false);
+                if (!m_image.buffer || m_image.buffer.use_count() > 1 ||
+                    m_bufferSize != bytes) {
+                    // Only reuse the buffer if no client is still holding
+                    // it.
+                    m_image.buffer = util::makeAlignedImageBuffer(bytes);
+                    m_bufferSize = bytes;
+                }
+            } else if (!sameMetadata(m_image.metadata, header.metadata) ||
+                       m_chunkCount != header.chunkCount) {
+                OSVR_DEV_VERBOSE("Image chunk disagrees with the rest of its "
+                                 "frame, dropping the frame");
+                m_active = false;
+                return false;
+            }
+            if (m_received[header.chunk]) {
+                return false;
+            }
+
+            auto dest = m_image.buffer.get() + header.rawOffset;
+            switch (header.encoding) {
+            case ImageWireCompression::None:
+                if (payloadLen != header.rawLength) {
+                    m_active = false;
+                    return false;
+                }
+                std::memcpy(dest, payload, header.rawLength);
+                break;
+            case ImageWireCompression::RunLength:
+                if (!image_codec::rleDecode(payload, payloadLen, dest,
+                                            header.rawLength)) {
+                    OSVR_DEV_VERBOSE("Could not decode image chunk");
+                    m_active = false;
+                    return false;
+                }
+                break;
+            default:
+                OSVR_DEV_VERBOSE("Unrecognized image chunk encoding");
+                m_active = false;
+                return false;
+            }
+            m_received[header.chunk] = true;
+            m_chunksRemaining--;
+            if (m_chunksRemaining > 0) {
+                return false;
+            }
+            m_active = false;
+            return true;
+        }
+
+        /// @brief The most recently completed frame. Its buffer is reused
+        /// for a later frame only once no copy of this is left.
+        ImageData const &getImage() const { return m_image; }
+
+      private:
+        bool m_active = false;
+        uint32_t m_frame = 0;
+        uint32_t m_chunkCount = 0;
+        uint32_t m_chunksRemaining = 0;
+        ImageData m_image;
+        /// @brief Allocated size of m_image.buffer, in bytes.
+        uint32_t m_bufferSize = 0;
+        std::vector<bool> m_received;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageChunkAssembly_h_GUID_B8BEEDA9_8F51_4DBC_BDE0_19ED52D2A36E
@@ -0,0 +1,132 @@
+/** @file
+    @brief Header containing the simple byte-oriented codec used to compress
+    image chunks sent over the network.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageWireCodec_h_GUID_2C96178E_ECDD_4B41_8F5B_C32EC84BCE32
+#define INCLUDED_ImageWireCodec_h_GUID_2C96178E_ECDD_4B41_8F5B_C32EC84BCE32
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace image_codec {
+        /// @brief Run-length encoding in the style of PackBits: a control
+        /// byte 0-127 is followed by that many plus one literal bytes, while a
+        /// control byte 128-255 is followed by a single byte to be repeated
+        /// (control - 125) times, for runs of 3 to 130.
+        ///
+        /// Dark camera frames (such as IR tracking camera frames, mostly black
+        /// with a few bright blobs) compress very well with this, and the
+        /// worst-case expansion is bounded by rleMaxEncodedSize().
+        static const std::size_t RLE_MAX_LITERAL = 128;
+        static const std::size_t RLE_MIN_RUN = 3;
+        static const std::size_t RLE_MAX_RUN = 130;
+        static const uint8_t RLE_RUN_BIAS = 125;
+
+        /// @brief Upper bound on the encoded size of len bytes of input.
+        inline std::size_t rleMaxEncodedSize(std::size_t len) {
+            return len + (len + RLE_MAX_LITERAL - 1) / RLE_MAX_LITERAL;
+        }
+
+        /// @brief Appends the run-length encoding of the input to out.
+        inline void rleEncode(uint8_t const *input, std::size_t len,
+                              std::vector<uint8_t> &out) {
+            out.reserve(out.size() + rleMaxEncodedSize(len));
+            std::size_t i = 0;
+            std::size_t literalStart = 0;
+            auto flushLiterals = [&](std::size_t end) {
+                while (literalStart < end) {
+                    auto n = end - literalStart;
+                    if (n > RLE_MAX_LITERAL) {
+                        n = RLE_MAX_LITERAL;
+                    }
+                    out.push_back(static_cast<uint8_t>(n - 1));
+                    out.insert(out.end(), input + literalStart,
+                               input + literalStart + n);
+                    literalStart += n;
+                }
+            };
+            while (i < len) {
+                auto val = input[i];
+                std::size_t run = 1;
+                while (i + run < len && run < RLE_MAX_RUN &&
+                       input[i + run] == val) {
+                    ++run;
+                }
+                if (run >= RLE_MIN_RUN) {
+                    flushLiterals(i);
+                    out.push_back(static_cast<uint8_t>(run + RLE_RUN_BIAS));
+                    out.push_back(val);
+                    i += run;
+                    literalStart = i;
+                } else {
+                    i += run;
+                }
+            }
+            flushLiterals(len);
+        }
+
+        /// @brief Decodes run-length encoded input into exactly outLen bytes
+        /// of output.
+        /// @return false if the input was malformed or did not decode to
+        /// exactly outLen bytes.
+        inline bool rleDecode(uint8_t const *input, std::size_t len,
+                              uint8_t *output, std::size_t outLen) {
+            std::size_t in = 0;
+            std::size_t out = 0;
+            while (in < len) {
+                auto control = input[in++];
+                if (control < RLE_MAX_LITERAL) {
+                    std::size_t n = control + 1;
+                    if (in + n > len || out + n > outLen) {
+                        return false;
+                    }
+                    std::memcpy(output + out, input + in, n);
+                    in += n;
+                    out += n;
+                } else {
+                    std::size_t n = control - RLE_RUN_BIAS;
+                    if (in >= len || out + n > outLen) {
+                        return false;
+                    }
+                    std::memset(output + out, input[in++], n);
+                    out += n;
+                }
+            }
+            return out == outLen;
+        }
+    } // namespace image_codec
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageWireCodec_h_GUID_2C96178E_ECDD_4B41_8F5B_C32EC84BCE32
@@ -24,25 +24,27 @@
 
 // Internal Includes
 #include <osvr/Common/ImagingComponent.h>
+#include "ImageChunkAssembly.h"
+#include "ImageWireCodec.h"
 #include <osvr/Common/BaseDevice.h>
 #include <osvr/Common/Serialization.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Util/AlignedMemoryUniquePtr.h>
 #include <osvr/Util/Flag.h>
+#include <osvr/Util/TimeValue.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
+#include <algorithm>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 namespace osvr {
 namespace common {
-    static inline uint32_t getBufferSize(OSVR_ImagingMetadata const &meta) {
-        return meta.height * meta.width * meta.depth * meta.channels;
-    }
     namespace messages {
         namespace {
             template <typename T>
@@ -107,6 +109,64 @@ namespace common {
             return "com.osvr.imaging.imageregion";
         }
 
+        namespace {
+            template <typename T>
+            void process(ImageChunkHeader &header, T &p) {
+                process(header.metadata, p);
+                p(header.sensor);
+                p(header.frame);
+                p(header.chunk);
+                p(header.chunkCount);
+                p(header.rawOffset);
+                p(header.rawLength);
+                p(header.encoding,
+                  serialization::EnumAsIntegerTag<ImageWireCompression,
+                                                  uint8_t>());
+            }
+        } // namespace
+
+        class ImageRegionChunk::MessageSerialization {
+          public:
+            MessageSerialization(ImageChunkHeader const &header,
+                                 uint8_t const *payload, uint32_t payloadLen)
+                : m_header(header),
+                  m_payloadPtr(const_cast<uint8_t *>(
+                      payload)), // only read from when serializing
+                  m_payloadLen(payloadLen) {}
+
+            MessageSerialization() : m_payloadPtr(nullptr), m_payloadLen(0) {}
+
+            template <typename T> void processMessage(T &p) {
+                process(m_header, p);
+                p(m_payloadLen);
+                /// Allocate the payload storage, if we're deserializing only.
+                allocatePayload(p.isDeserialize());
+                p(m_payloadPtr,
+                  serialization::AlignedDataBufferTag(m_payloadLen));
+            }
+
+            ImageChunkHeader const &getHeader() const { return m_header; }
+            uint8_t const *getPayload() const { return m_payloadPtr; }
+            uint32_t getPayloadLength() const { return m_payloadLen; }
+
+          private:
+            void allocatePayload(std::true_type const &) {
+                m_payload.resize(m_payloadLen);
+                m_payloadPtr = m_payload.data();
+            }
+            void allocatePayload(std::false_type const &) {
+                // Does nothing if we're serializing.
+            }
+
+            ImageChunkHeader m_header;
+            uint8_t *m_payloadPtr;
+            uint32_t m_payloadLen;
+            std::vector<uint8_t> m_payload;
+        };
+        const char *ImageRegionChunk::identifier() {
+            return "com.osvr.imaging.imageregionchunk";
+        }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         namespace {
             struct InProcessMemoryMessage {
@@ -200,7 +260,20 @@ namespace common {
         shared_ptr<ImagingComponent> ret(new ImagingComponent());
         return ret;
     }
-    ImagingComponent::ImagingComponent() {}
+    /// @brief Generous upper bound on the serialized size of everything in a
+    /// chunk message but the payload.
+    static const size_t WIRE_CHUNK_HEADER_SIZE = 64;
+    static_assert(WIRE_CHUNK_RAW_SIZE +
+                          WIRE_CHUNK_RAW_SIZE / image_codec::RLE_MAX_LITERAL +
+                          1 + WIRE_CHUNK_HEADER_SIZE <
+                      vrpn_CONNECTION_TCP_BUFLEN,
+                  "Worst-case chunk message must fit in a VRPN message");
+
+    ImagingComponent::ImagingComponent()
+        : m_gotOne(false), m_wireChunking(false),
+          m_wireCompression(ImageWireCompression::None),
+          m_wireMaxBytesPerSecond(0), m_wireBudget(0), m_wireBudgetTime{0, 0},
+          m_wireFrame(0), m_shmLockFree(false) {}
 
     ImagingComponent::~ImagingComponent() = default;
 
@@ -212,19 +285,85 @@ namespace common {
         util::Flag dataSent;
 
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+        // All clients are in-process, so nothing goes on the wire.
         dataSent += m_sendImageDataViaInProcessMemory(metadata, imageData,
                                                       sensor, timestamp);
 #else
         dataSent += m_sendImageDataViaSharedMemory(metadata, imageData, sensor,
                                                    timestamp);
-#endif
         dataSent +=
             m_sendImageDataOnTheWire(metadata, imageData, sensor, timestamp);
+#endif
         if (dataSent) {
             m_checkFirst(metadata);
         }
     }
 
+    OSVR_ImageBufferElement *
+    ImagingComponent::acquireImageBuffer(OSVR_ImagingMetadata metadata,
+                                         OSVR_ChannelCount sensor) {
+        m_growShmVecIfRequired(sensor);
+        auto &pending = m_pending[sensor];
+        // An acquire without a commit in between means the plugin gave up on
+        // the previous buffer: don't let any of it reach clients. (This also
+        // drops any previous slot before we possibly replace the ring buffer
+        // it lives in.)
+        if (pending.shmSlot) {
+            pending.shmSlot->abandon();
+            pending.shmSlot.reset();
+        }
+        pending.buffer.reset();
+        pending.metadata = metadata;
+#ifndef OSVR_COMMON_IN_PROCESS_IMAGING
+        if (m_shmLockFree) {
+            if (!m_ensureShmBuf(metadata, sensor)) {
+                return nullptr;
+            }
+            pending.shmSlot.reset(
+                new IPCRingBuffer::BufferWriteProxy(m_shmBuf[sensor]->put()));
+            return pending.shmSlot->get();
+        }
+        // With mutexes, a slot handed out here would keep its exclusive lock
+        // (blocking every reader) until the plugin commits, so the plugin
+        // fills a private buffer that commit copies in instead.
+#endif
+        pending.buffer = util::makeAlignedImageBuffer(getBufferSize(metadata));
+        return pending.buffer.get();
+    }
+
+    bool ImagingComponent::commitImageBuffer(OSVR_ChannelCount sensor,
+                                             OSVR_TimeValue const &timestamp) {
+        if (m_pending.size() <= sensor) {
+            return false;
+        }
+        auto &pending = m_pending[sensor];
+        auto metadata = pending.metadata;
+        if (pending.buffer) {
+            auto buffer = std::move(pending.buffer);
+#ifdef OSVR_COMMON_IN_PROCESS_IMAGING
+            m_sendInProcessBuffer(metadata, std::move(buffer), sensor,
+                                  timestamp);
+            m_checkFirst(metadata);
+#else
+            sendImageData(metadata, buffer.get(), sensor, timestamp);
+#endif
+            return true;
+        }
+        if (!pending.shmSlot) {
+            return false;
+        }
+        OSVR_ImageBufferElement *imageData = pending.shmSlot->get();
+        auto seq = pending.shmSlot->getSequenceNumber();
+        // Releasing the slot publishes it, so it must happen before clients
+        // hear about it. We're the only writer, so the data stays valid for
+        // the wire send below until our next acquire.
+        pending.shmSlot.reset();
+        m_sendSharedMemoryNotification(metadata, seq, sensor, timestamp);
+        m_sendImageDataOnTheWire(metadata, imageData, sensor, timestamp);
+        m_checkFirst(metadata);
+        return true;
+    }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
     bool ImagingComponent::m_sendImageDataViaInProcessMemory(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
@@ -234,17 +373,22 @@ namespace common {
         auto imageBufferCopy = util::makeAlignedImageBuffer(imageBufferSize);
         memcpy(imageBufferCopy.get(), imageData, imageBufferSize);
 
+        m_sendInProcessBuffer(metadata, std::move(imageBufferCopy), sensor,
+                              timestamp);
+        return true;
+    }
+
+    void ImagingComponent::m_sendInProcessBuffer(
+        OSVR_ImagingMetadata metadata, util::AlignedImageBufferPtr &&buffer,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
         Buffer<> buf;
         messages::ImagePlacedInProcessMemory::MessageSerialization
             serialization(messages::InProcessMemoryMessage{
-                metadata, sensor,
-                reinterpret_cast<intptr_t>(imageBufferCopy.release())});
+                metadata, sensor, reinterpret_cast<intptr_t>(buffer.release())});
 
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInProcessMemory.getMessageType(), timestamp);
-
-        return true;
     }
 #endif
 
@@ -252,10 +396,21 @@ namespace common {
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
 
+        if (!m_ensureShmBuf(metadata, sensor)) {
+            return false;
+        }
+        auto seq = m_shmBuf[sensor]->put(imageData, getBufferSize(metadata));
+        m_sendSharedMemoryNotification(metadata, seq, sensor, timestamp);
+        return true;
+    }
+
+    bool ImagingComponent::m_ensureShmBuf(OSVR_ImagingMetadata const &metadata,
+                                          OSVR_ChannelCount sensor) {
         m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
         if (!m_shmBuf[sensor] ||
-            m_shmBuf[sensor]->getEntrySize() != imageBufferSize) {
+            m_shmBuf[sensor]->getEntrySize() != imageBufferSize ||
+            m_shmBuf[sensor]->isLockFree() != m_shmLockFree) {
             // create or replace the shared memory ring buffer.
             auto makeName = [](OSVR_ChannelCount sensor,
                                std::string const &devName) {
@@ -266,16 +421,21 @@ namespace common {
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
+                    .setEntrySize(imageBufferSize)
+                    .setLockFree(m_shmLockFree));
         }
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
                 "Some issue creating shared memory for imaging, skipping out.");
             return false;
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        return true;
+    }
 
+    void ImagingComponent::m_sendSharedMemoryNotification(
+        OSVR_ImagingMetadata metadata, IPCRingBuffer::sequence_type seq,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        auto &shm = *(m_shmBuf[sensor]);
         Buffer<> buf;
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
             messages::SharedMemoryMessage{metadata, seq, sensor,
@@ -284,34 +444,82 @@ namespace common {
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
-
-        return true;
     }
 
     bool ImagingComponent::m_sendImageDataOnTheWire(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-        /// @todo currently only handle 8bit data over network
-        if (metadata.depth != 1) {
+        auto bytes = getBufferSize(metadata);
+        /// Single-message format currently only handles 8bit data over
+        /// network.
+        Buffer<> buf;
+        bool singleMessage = false;
+        if (metadata.depth == 1 &&
+            (!m_wireChunking ||
+             m_wireCompression == ImageWireCompression::None)) {
+            messages::ImageRegion::MessageSerialization msg(metadata,
+                                                            imageData, sensor);
+            serialize(buf, msg);
+            singleMessage = buf.size() <= vrpn_CONNECTION_TCP_BUFLEN;
+        }
+        if (!singleMessage && !m_wireChunking) {
             return false;
         }
-        Buffer<> buf;
-        messages::ImageRegion::MessageSerialization msg(metadata, imageData,
-                                                        sensor);
-        serialize(buf, msg);
-        if (buf.size() > vrpn_CONNECTION_TCP_BUFLEN) {
-#if 0
-            OSVR_DEV_VERBOSE("Skipping imaging message: size is "
-                             << buf.size() << " vs the maximum of "
-                             << vrpn_CONNECTION_TCP_BUFLEN);
-#endif
+        if (!m_wireBudgetAllows(bytes, timestamp)) {
             return false;
         }
-        m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
+        if (singleMessage) {
+            m_getParent().packMessage(buf, imageRegion.getMessageType(),
+                                      timestamp);
+        } else {
+            m_sendImageChunks(metadata, imageData, sensor, timestamp);
+        }
         m_getParent().sendPending();
         return true;
     }
 
+    void ImagingComponent::m_sendImageChunks(
+        OSVR_ImagingMetadata const &metadata,
+        OSVR_ImageBufferElement const *imageData, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
+        forEachImageChunk(
+            metadata, imageData, sensor, m_wireFrame++, m_wireCompression,
+            [&](messages::ImageChunkHeader const &header,
+                uint8_t const *payload, uint32_t payloadLen) {
+                Buffer<> buf;
+                messages::ImageRegionChunk::MessageSerialization msg(
+                    header, payload, payloadLen);
+                serialize(buf, msg);
+                m_getParent().packMessage(
+                    buf, imageRegionChunk.getMessageType(), timestamp);
+            });
+    }
+
+    bool ImagingComponent::m_wireBudgetAllows(uint32_t bytes,
+                                              OSVR_TimeValue const &timestamp) {
+        if (0 == m_wireMaxBytesPerSecond) {
+            return true;
+        }
+        double maxBudget = m_wireMaxBytesPerSecond;
+        if (0 == m_wireBudgetTime.seconds &&
+            0 == m_wireBudgetTime.microseconds) {
+            // First frame: start with a full second's worth.
+            m_wireBudget = maxBudget;
+        } else {
+            auto elapsed = util::time::duration(timestamp, m_wireBudgetTime);
+            if (elapsed > 0) {
+                m_wireBudget = std::min(
+                    maxBudget, m_wireBudget + elapsed * maxBudget);
+            }
+        }
+        m_wireBudgetTime = timestamp;
+        if (m_wireBudget < bytes) {
+            return false;
+        }
+        m_wireBudget -= bytes;
+        return true;
+    }
+
     int VRPN_CALLBACK
     ImagingComponent::m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ImagingComponent *>(userdata);
@@ -320,6 +528,9 @@ namespace common {
         messages::ImageRegion::MessageSerialization msg;
         deserialize(bufReader, msg);
         auto data = msg.getData();
+        if (self->m_receivingViaSharedMemory(data.sensor)) {
+            return 0;
+        }
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
         self->m_checkFirst(data.metadata);
@@ -329,6 +540,36 @@ namespace common {
         return 0;
     }
 
+    int VRPN_CALLBACK ImagingComponent::m_handleImageRegionChunk(
+        void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageRegionChunk::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto const &header = msg.getHeader();
+        if (self->m_receivingViaSharedMemory(header.sensor)) {
+            return 0;
+        }
+
+        while (self->m_chunkAssembly.size() <= header.sensor) {
+            self->m_chunkAssembly.emplace_back(new ImageChunkAssembler);
+        }
+        auto &assembler = *self->m_chunkAssembly[header.sensor];
+        if (!assembler.addChunk(header, msg.getPayload(),
+                                msg.getPayloadLength())) {
+            return 0;
+        }
+
+        auto const &data = assembler.getImage();
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        self->m_checkFirst(data.metadata);
+        for (auto const &cb : self->m_cb) {
+            cb(data, timestamp);
+        }
+        return 0;
+    }
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
     int VRPN_CALLBACK ImagingComponent::m_handleImagePlacedInProcessMemory(
         void *userdata, vrpn_HANDLERPARAM p) {
@@ -408,6 +649,9 @@ namespace common {
             m_registerHandler(&ImagingComponent::m_handleImageRegion, this,
                               imageRegion.getMessageType());
 
+            m_registerHandler(&ImagingComponent::m_handleImageRegionChunk,
+                              this, imageRegionChunk.getMessageType());
+
             m_registerHandler(
                 &ImagingComponent::m_handleImagePlacedInSharedMemory, this,
                 imagePlacedInSharedMemory.getMessageType());
@@ -420,8 +664,26 @@ namespace common {
         }
         m_cb.push_back(handler);
     }
+    void ImagingComponent::setSharedMemoryLockFree(bool lockFree) {
+        m_shmLockFree = lockFree;
+    }
+
+    void ImagingComponent::setWireChunkingEnabled(bool enabled) {
+        m_wireChunking = enabled;
+    }
+
+    void
+    ImagingComponent::setWireCompression(ImageWireCompression compression) {
+        m_wireCompression = compression;
+    }
+
+    void ImagingComponent::setWireMaxBytesPerSecond(uint32_t bytes) {
+        m_wireMaxBytesPerSecond = bytes;
+    }
+
     void ImagingComponent::m_parentSet() {
         m_getParent().registerMessageType(imageRegion);
+        m_getParent().registerMessageType(imageRegionChunk);
         m_getParent().registerMessageType(imagePlacedInSharedMemory);
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         m_getParent().registerMessageType(imagePlacedInProcessMemory);
@@ -437,10 +699,20 @@ namespace common {
         OSVR_DEV_VERBOSE("Sending/receiving first frame: width="
                          << metadata.width << " height=" << metadata.height);
     }
+    bool ImagingComponent::m_receivingViaSharedMemory(
+        OSVR_ChannelCount sensor) const {
+        // Only set on the client side once the server's ring buffer has been
+        // found, and that notification precedes any copy on the wire.
+        return m_shmBuf.size() > sensor && m_shmBuf[sensor];
+    }
+
     void ImagingComponent::m_growShmVecIfRequired(OSVR_ChannelCount sensor) {
         if (m_shmBuf.size() <= sensor) {
             m_shmBuf.resize(sensor + 1);
         }
+        if (m_pending.size() <= sensor) {
+            m_pending.resize(sensor + 1);
+        }
     }
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,75 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Internal Includes
+#include <osvr/Common/InProcessReportBus.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace osvr {
+namespace common {
+    namespace {
+        typedef std::pair<vrpn_Connection *, std::string> ChannelKey;
+        /// Devices may be created on several threads, so the registry is
+        /// guarded - unlike the channels themselves.
+        std::mutex g_channelMutex;
+        std::map<ChannelKey, InProcessReportChannelPtr> g_channels;
+    } // namespace
+
+    InProcessReportChannelPtr
+    advertiseInProcessReports(vrpn_Connection *conn,
+                              std::string const &device) {
+        auto channel = make_shared<InProcessReportChannel>();
+        std::lock_guard<std::mutex> lock(g_channelMutex);
+        g_channels[ChannelKey(conn, device)] = channel;
+        return channel;
+    }
+
+    void withdrawInProcessReports(vrpn_Connection *conn,
+                                  std::string const &device,
+                                  InProcessReportChannelPtr const &channel) {
+        std::lock_guard<std::mutex> lock(g_channelMutex);
+        auto it = g_channels.find(ChannelKey(conn, device));
+        if (it != end(g_channels) && it->second == channel) {
+            g_channels.erase(it);
+        }
+    }
+
+    InProcessReportChannelPtr
+    findInProcessReports(vrpn_Connection *conn, std::string const &device) {
+        std::lock_guard<std::mutex> lock(g_channelMutex);
+        auto it = g_channels.find(ChannelKey(conn, device));
+        if (it == end(g_channels)) {
+            return InProcessReportChannelPtr();
+        }
+        return it->second;
+    }
+
+} // namespace common
+} // namespace osvr
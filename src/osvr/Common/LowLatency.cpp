@@ -24,14 +24,31 @@
 
 // Internal Includes
 #include <osvr/Common/LowLatency.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cerrno>
+#include <cstring>
 
 #ifdef _WIN32
 #define NO_MINMAX
 #include <windows.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace osvr {
 namespace common {
+    static std::atomic<bool> s_lockMemory(false);
+
+    void setLowLatencyMemoryLocking(bool enable) { s_lockMemory = enable; }
 
 #ifdef _WIN32
 #define OSVR_HAVE_LOWLATENCY_CODE
@@ -61,6 +78,33 @@ namespace common {
     }
 #endif
 
+#ifdef __linux__
+#define OSVR_HAVE_LOWLATENCY_CODE
+    struct LowLatency::Impl {
+        bool memoryLocked = false;
+    };
+
+    LowLatency::LowLatency() : m_impl(new Impl) {
+        if (!s_lockMemory) {
+            return;
+        }
+        if (0 == mlockall(MCL_CURRENT | MCL_FUTURE)) {
+            m_impl->memoryLocked = true;
+        } else {
+            auto err = errno;
+            util::log::make_logger("LowLatency")->warn()
+                << "Could not lock process memory (requires CAP_IPC_LOCK or "
+                   "a large enough RLIMIT_MEMLOCK): "
+                << std::strerror(err);
+        }
+    }
+    LowLatency::~LowLatency() {
+        if (m_impl->memoryLocked) {
+            munlockall();
+        }
+    }
+#endif
+
 #ifndef OSVR_HAVE_LOWLATENCY_CODE
     // Fallback no-op implementations
     struct LowLatency::Impl {};
@@ -72,10 +72,19 @@ namespace common {
     }
 
     void PathTreeOwner::replaceTree(Json::Value const &nodes) {
-        for_each_cleanup_pointers(
-            m_observers, [&](PathTreeObserver const &observer) {
-                observer.notifyEvent(PathTreeEvents::AboutToUpdate, m_tree);
-            });
+        // Until the next version marker, we can't tell which deltas apply.
+        m_version.reset();
+
+        if (m_valid) {
+            auto delta = pathTreeDelta(pathTreeToJson(m_tree), nodes);
+            if (!isEmptyPathTreeDelta(delta)) {
+                applyPathTreeDelta(m_tree, delta);
+                m_notify(PathTreeEvents::AfterIncrementalUpdate);
+            }
+            return;
+        }
+
+        m_notify(PathTreeEvents::AboutToUpdate);
 
         m_tree.reset();
 
@@ -83,10 +92,35 @@ namespace common {
 
         m_valid = true;
 
-        for_each_cleanup_pointers(
-            m_observers, [&](PathTreeObserver const &observer) {
-                observer.notifyEvent(PathTreeEvents::AfterUpdate, m_tree);
-            });
+        m_notify(PathTreeEvents::AfterUpdate);
+    }
+
+    static const char VERSION_KEY[] = "version";
+    static const char BASE_VERSION_KEY[] = "baseVersion";
+
+    bool PathTreeOwner::applyTreeDelta(Json::Value const &delta) {
+        if (!m_valid) {
+            return false;
+        }
+        auto const &baseVersion = delta[BASE_VERSION_KEY];
+        if (!baseVersion.isNull()) {
+            if (!m_version || baseVersion.asUInt() != *m_version) {
+                return false;
+            }
+        }
+        m_version = delta[VERSION_KEY].asUInt();
+        if (!isEmptyPathTreeDelta(delta)) {
+            applyPathTreeDelta(m_tree, delta);
+            m_notify(PathTreeEvents::AfterIncrementalUpdate);
+        }
+        return true;
+    }
+
+    void PathTreeOwner::m_notify(PathTreeEvents e) {
+        for_each_cleanup_pointers(m_observers,
+                                  [&](PathTreeObserver const &observer) {
+                                      observer.notifyEvent(e, m_tree);
+                                  });
     }
 } // namespace common
 } // namespace osvr
@@ -35,7 +35,8 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
@@ -101,5 +102,75 @@ namespace common {
             tree.getNodeByPath(node["path"].asString()).value() = elt;
         }
     }
+
+    static const char DELTA_SET_KEY[] = "set";
+    static const char DELTA_REMOVE_KEY[] = "remove";
+
+    Json::Value pathTreeDelta(Json::Value const &oldNodes,
+                              Json::Value const &newNodes) {
+        std::unordered_map<std::string, Json::Value const *> oldByPath;
+        oldByPath.reserve(oldNodes.size());
+        for (auto const &node : oldNodes) {
+            oldByPath[node["path"].asString()] = &node;
+        }
+
+        Json::Value ret(Json::objectValue);
+        Json::Value &set = ret[DELTA_SET_KEY] = Json::arrayValue;
+        Json::Value &remove = ret[DELTA_REMOVE_KEY] = Json::arrayValue;
+        for (auto const &node : newNodes) {
+            auto it = oldByPath.find(node["path"].asString());
+            if (it == end(oldByPath)) {
+                set.append(node);
+                continue;
+            }
+            if (!(*(it->second) == node)) {
+                set.append(node);
+            }
+            // Whatever is left at the end was removed.
+            oldByPath.erase(it);
+        }
+        for (auto const &leftover : oldByPath) {
+            remove.append(leftover.first);
+        }
+        return ret;
+    }
+
+    bool isEmptyPathTreeDelta(Json::Value const &delta) {
+        return delta[DELTA_SET_KEY].empty() && delta[DELTA_REMOVE_KEY].empty();
+    }
+
+    /// @brief Removes the node at path from the tree if it is null and has
+    /// no children, then does the same for each of its ancestors in turn.
+    static void pruneNullBranch(PathTree const &tree, std::string const &path) {
+        PathNode const *node = nullptr;
+        try {
+            node = &tree.getNodeByPath(path);
+        } catch (util::tree::NoSuchChild &) {
+            // Already pruned along with a removed descendant.
+            return;
+        }
+        auto parent = node->getParent();
+        while (parent && elements::isNull(node->value()) &&
+               !node->hasChildren()) {
+            auto name = node->getName();
+            parent->removeChildByName(name);
+            node = parent;
+            parent = node->getParent();
+        }
+    }
+
+    void applyPathTreeDelta(PathTree &tree, Json::Value const &delta) {
+        Json::Value const &removed = delta[DELTA_REMOVE_KEY];
+        for (auto const &path : removed) {
+            tree.getNodeByPath(path.asString()).value() =
+                elements::NullElement();
+        }
+        jsonToPathTree(tree, delta[DELTA_SET_KEY]);
+        // Prune only after applying the sets, so a removed node that is the
+        // parent of a newly-set one stays in place.
+        for (auto const &path : removed) {
+            pruneNullBranch(tree, path.asString());
+        }
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
@@ -0,0 +1,117 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/PoseAtTime.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    namespace {
+        using PoseHistory = StateHistoryFor<OSVR_PoseReport>;
+
+        void interpolate(PoseHistory::Entry const &before,
+                         PoseHistory::Entry const &after,
+                         util::time::TimeValue const &when,
+                         OSVR_PoseState &pose) {
+            auto span = util::time::duration(after.timestamp, before.timestamp);
+            double t = 0;
+            if (span > 0) {
+                t = util::time::duration(when, before.timestamp) / span;
+            }
+            util::vecMap(pose.translation) =
+                util::vecMap(before.state.translation) +
+                t * (util::vecMap(after.state.translation) -
+                     util::vecMap(before.state.translation));
+            util::toQuat(util::fromQuat(before.state.rotation)
+                             .slerp(t, util::fromQuat(after.state.rotation)),
+                         pose.rotation);
+        }
+
+        /// @brief Apply dt seconds of the given velocity to the pose.
+        ///
+        /// The incremental rotation, like the VRPN velocity quaternion it
+        /// comes from, is taken to be in the same frame as the pose
+        /// orientation, so it is pre-multiplied.
+        void extrapolate(OSVR_VelocityState const &vel, double dt,
+                         OSVR_PoseState &pose) {
+            if (vel.linearVelocityValid) {
+                util::vecMap(pose.translation) +=
+                    dt * util::vecMap(vel.linearVelocity);
+            }
+            if (vel.angularVelocityValid && vel.angularVelocity.dt > 0) {
+                Eigen::AngleAxisd incremental(
+                    util::fromQuat(vel.angularVelocity.incrementalRotation));
+                Eigen::AngleAxisd rotation(incremental.angle() * dt /
+                                               vel.angularVelocity.dt,
+                                           incremental.axis());
+                util::toQuat(Eigen::Quaterniond(rotation) *
+                                 util::fromQuat(pose.rotation),
+                             pose.rotation);
+            }
+        }
+    } // namespace
+
+    bool getPoseAtTime(InterfaceState const &state,
+                       util::time::TimeValue const &when,
+                       OSVR_PoseState &pose) {
+        util::time::TimeValue timestamp;
+        auto history = state.getHistory<OSVR_PoseReport>();
+        if (history && !history->empty()) {
+            PoseHistory::Entry const *before = nullptr;
+            PoseHistory::Entry const *after = nullptr;
+            if (history->findBracket(when, before, after)) {
+                interpolate(*before, *after, when, pose);
+                return true;
+            }
+            if (osvrTimeValueGreater(history->oldest().timestamp, when)) {
+                pose = history->oldest().state;
+                return true;
+            }
+            timestamp = history->newest().timestamp;
+            pose = history->newest().state;
+        } else if (state.hasState<OSVR_PoseReport>()) {
+            state.getState<OSVR_PoseReport>(timestamp, pose);
+        } else {
+            return false;
+        }
+
+        auto dt = util::time::duration(when, timestamp);
+        if (dt > 0 && state.hasState<OSVR_VelocityReport>()) {
+            util::time::TimeValue velTimestamp;
+            OSVR_VelocityState vel;
+            state.getState<OSVR_VelocityReport>(velTimestamp, vel);
+            extrapolate(vel, std::min(dt, MAX_POSE_EXTRAPOLATION), pose);
+        }
+        return true;
+    }
+} // namespace common
+} // namespace osvr
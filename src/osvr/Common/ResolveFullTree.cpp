@@ -43,10 +43,11 @@ namespace common {
 
     std::vector<std::string> resolveFullTree(PathTree &tree) {
         std::vector<std::string> badPaths;
+        TreeResolutionCache cache;
         osvr::util::traverseWith(
-            tree.getRoot(), [&tree, &badPaths](PathNode const &node) {
+            tree.getRoot(), [&tree, &badPaths, &cache](PathNode const &node) {
                 auto fullPath = getFullPath(node);
-                auto result = resolveTreeNode(tree, fullPath);
+                auto result = resolveTreeNode(tree, fullPath, cache);
                 if (!result && isNodeAnAlias(node)) {
                     // OK, so this is an alias (it should have resolved) and yet
                     // it didn't. Add the path to the list of bad paths.
@@ -71,15 +71,17 @@ namespace common {
 
     // Forward declaration
     void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                             OriginalSource &source);
+                             OriginalSource &source,
+                             TreeResolutionCache *cache);
 
     class TreeResolutionVisitor : public boost::static_visitor<>,
                                   boost::noncopyable {
       public:
         TreeResolutionVisitor(common::PathTree &tree, common::PathNode &node,
-                              common::OriginalSource &source)
+                              common::OriginalSource &source,
+                              TreeResolutionCache *cache)
             : boost::static_visitor<>(), m_tree(tree), m_node(node),
-              m_source(source) {}
+              m_source(source), m_cache(cache) {}
 
         /// @brief Fallback case
         template <typename T> void operator()(T const &) {
@@ -89,17 +91,13 @@ namespace common {
         /// @brief Handle an alias element
         void operator()(elements::AliasElement const &elt) {
             // This is an alias.
-            ParsedAlias parsed(elt.getSource());
-            if (!parsed.isValid()) {
+            bool valid = m_cache
+                             ? m_handleAlias(
+                                   m_cache->getParsedAlias(elt.getSource()))
+                             : m_handleAlias(ParsedAlias(elt.getSource()));
+            if (!valid) {
                 OSVR_DEV_VERBOSE("Couldn't parse alias: " << elt.getSource());
-                return;
-            }
-            /// @todo update the element with the normalized source?
-            if (!parsed.isSimple()) {
-                // Not simple: store the full string as a transform.
-                m_source.nestTransform(parsed.getAliasValue());
             }
-            m_recurse(parsed.getLeaf());
         }
 
         /// @brief Handle a sensor element
@@ -123,37 +121,92 @@ namespace common {
         }
 
       private:
+        /// @return false if the alias was invalid
+        bool m_handleAlias(ParsedAlias const &parsed) {
+            if (!parsed.isValid()) {
+                return false;
+            }
+            /// @todo update the element with the normalized source?
+            if (!parsed.isSimple()) {
+                // Not simple: store the full string as a transform.
+                m_source.nestTransform(parsed.getAliasValue());
+            }
+            m_recurse(parsed.getLeaf());
+            return true;
+        }
         void m_decompose() { m_source.decompose(m_node); }
         void m_recurse(std::string const &path) {
-            resolveTreeNodeImpl(m_tree, path, m_source);
+            resolveTreeNodeImpl(m_tree, path, m_source, m_cache);
         }
         PathTree &m_getPathTree() { return m_tree; }
 
         PathTree &m_tree;
         PathNode &m_node;
         OriginalSource &m_source;
+        TreeResolutionCache *m_cache;
     };
 
     inline void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                                    OriginalSource &source) {
+                                    OriginalSource &source,
+                                    TreeResolutionCache *cache) {
         auto &node = pathTree.getNodeByPath(path);
 
         // First do any inference possible here.
         ifNullTryInferFromParent(node);
 
         // Now visit.
-        TreeResolutionVisitor visitor(pathTree, node, source);
+        TreeResolutionVisitor visitor(pathTree, node, source, cache);
         boost::apply_visitor(visitor, node.value());
     }
 
     boost::optional<OriginalSource> resolveTreeNode(PathTree &pathTree,
                                                     std::string const &path) {
         OriginalSource source;
-        resolveTreeNodeImpl(pathTree, path, source);
+        resolveTreeNodeImpl(pathTree, path, source, nullptr);
         if (source.isResolved()) {
             return source;
         }
         return boost::optional<OriginalSource>();
     }
+
+    /// @brief Parsed aliases don't depend on the tree, so they are kept across
+    /// invalidations - unless there get to be this many of them.
+    static const std::size_t MAX_CACHED_ALIASES = 4096;
+
+    TreeResolutionCache::TreeResolutionCache() {}
+
+    void TreeResolutionCache::invalidate() {
+        m_results.clear();
+        if (m_aliases.size() > MAX_CACHED_ALIASES) {
+            m_aliases.clear();
+        }
+        ++m_generation;
+    }
+
+    ParsedAlias const &
+    TreeResolutionCache::getParsedAlias(std::string const &source) {
+        auto it = m_aliases.find(source);
+        if (it == end(m_aliases)) {
+            it = m_aliases.emplace(source, ParsedAlias(source)).first;
+        }
+        return it->second;
+    }
+
+    boost::optional<OriginalSource>
+    resolveTreeNode(PathTree &pathTree, std::string const &path,
+                    TreeResolutionCache &cache) {
+        auto it = cache.m_results.find(path);
+        if (it != end(cache.m_results)) {
+            return it->second;
+        }
+        OriginalSource source;
+        resolveTreeNodeImpl(pathTree, path, source, &cache);
+        boost::optional<OriginalSource> ret;
+        if (source.isResolved()) {
+            ret = source;
+        }
+        cache.m_results.emplace(path, ret);
+        return ret;
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
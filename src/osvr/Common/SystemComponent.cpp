@@ -93,6 +93,62 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeDeltaFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        static const char TREE_DELTA_QUERY_KEY[] = "query";
+
+        class TreeDeltaSupportQueryFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaSupportQueryFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaSupportQueryFromServer";
+        }
+
+        class TreeDeltaSupportToServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaSupportToServer::identifier() {
+            return "com.osvr.system.TreeDeltaSupportToServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -133,15 +189,59 @@ namespace common {
     }
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
-        auto config = pathTreeToJson(tree);
+        sendReplacementTree(pathTreeToJson(tree));
+    }
+
+    void SystemComponent::sendReplacementTree(Json::Value const &nodes) {
         Buffer<> buf;
-        messages::ReplacementTreeFromServer::MessageSerialization msg(config);
+        messages::ReplacementTreeFromServer::MessageSerialization msg(nodes);
         serialize(buf, msg);
         m_getParent().packMessage(buf, treeOut.getMessageType());
 
         m_getParent().sendPending(); // forcing this since it will cause
                                      // shuffling of remotes on the client.
     }
+
+    void SystemComponent::sendTreeDelta(Json::Value const &delta) {
+        Buffer<> buf;
+        messages::TreeDeltaFromServer::MessageSerialization msg(delta);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaOut.getMessageType());
+
+        m_getParent().sendPending();
+    }
+
+    void SystemComponent::registerTreeDeltaHandler(JsonHandler cb) {
+        if (m_treeDeltaHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
+            m_registerHandler(&SystemComponent::m_handleTreeDeltaSupportQuery,
+                              this, treeDeltaSupportQueryOut.getMessageType());
+        }
+        m_treeDeltaHandlers.push_back(cb);
+    }
+
+    void SystemComponent::sendTreeDeltaSupportQuery(uint32_t query) {
+        Json::Value payload(Json::objectValue);
+        payload[messages::TREE_DELTA_QUERY_KEY] = query;
+        Buffer<> buf;
+        messages::TreeDeltaSupportQueryFromServer::MessageSerialization msg(
+            payload);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf,
+                                  treeDeltaSupportQueryOut.getMessageType());
+
+        m_getParent().sendPending();
+    }
+
+    void SystemComponent::registerTreeDeltaSupportHandler(
+        TreeDeltaSupportHandler cb) {
+        if (m_treeDeltaSupportHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDeltaSupport, this,
+                              treeDeltaSupportIn.getMessageType());
+        }
+        m_treeDeltaSupportHandlers.push_back(cb);
+    }
     void SystemComponent::registerReplaceTreeHandler(JsonHandler cb) {
         if (m_replaceTreeHandlers.empty()) {
             m_registerHandler(&SystemComponent::m_handleReplaceTree, this,
@@ -155,6 +255,9 @@ namespace common {
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(treeDeltaSupportQueryOut);
+        m_getParent().registerMessageType(treeDeltaSupportIn);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -171,5 +274,54 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        BOOST_ASSERT_MSG(msg.getValue().isObject(),
+                         "tree delta message must be an object!");
+        for (auto const &cb : self->m_treeDeltaHandlers) {
+            cb(msg.getValue(), timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDeltaSupportQuery(void *userdata,
+                                                       vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaSupportQueryFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+
+        /// Echo the query back so the server can tell which round of
+        /// questions this answers.
+        Json::Value payload(Json::objectValue);
+        payload[messages::TREE_DELTA_QUERY_KEY] =
+            msg.getValue()[messages::TREE_DELTA_QUERY_KEY];
+        Buffer<> buf;
+        messages::TreeDeltaSupportToServer::MessageSerialization reply(
+            payload);
+        serialize(buf, reply);
+        self->m_getParent().packMessage(
+            buf, self->treeDeltaSupportIn.getMessageType());
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDeltaSupport(void *userdata,
+                                                  vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaSupportToServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto query = msg.getValue()[messages::TREE_DELTA_QUERY_KEY].asUInt();
+        for (auto const &cb : self->m_treeDeltaSupportHandlers) {
+            cb(query);
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
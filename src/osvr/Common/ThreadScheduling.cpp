@@ -0,0 +1,187 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ThreadScheduling.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace osvr {
+namespace common {
+    namespace {
+        static const std::size_t NUM_ROLES = 3;
+
+        class SchedulingRegistry {
+          public:
+            void set(ThreadRole role, ThreadSchedulingConfig const &config) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_configs[static_cast<std::size_t>(role)] = config;
+            }
+            ThreadSchedulingConfig get(ThreadRole role) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_configs[static_cast<std::size_t>(role)];
+            }
+
+          private:
+            std::mutex m_mutex;
+            ThreadSchedulingConfig m_configs[NUM_ROLES];
+        };
+
+        SchedulingRegistry &getRegistry() {
+            static SchedulingRegistry registry;
+            return registry;
+        }
+
+        const char *getRoleName(ThreadRole role) {
+            switch (role) {
+            case ThreadRole::ServerMainLoop:
+                return "server main loop";
+            case ThreadRole::AsyncDevice:
+                return "async device";
+            case ThreadRole::Tracker:
+                return "tracker";
+            }
+            return "unknown";
+        }
+    } // namespace
+
+    bool parseSchedulingPolicy(std::string const &name,
+                               SchedulingPolicy &policy) {
+        if (name == "default") {
+            policy = SchedulingPolicy::Default;
+        } else if (name == "fifo") {
+            policy = SchedulingPolicy::Fifo;
+        } else if (name == "rr") {
+            policy = SchedulingPolicy::RoundRobin;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void setThreadSchedulingConfig(ThreadRole role,
+                                   ThreadSchedulingConfig const &config) {
+        getRegistry().set(role, config);
+    }
+
+    ThreadSchedulingConfig getThreadSchedulingConfig(ThreadRole role) {
+        return getRegistry().get(role);
+    }
+
+#ifdef __linux__
+    bool applyThreadScheduling(ThreadSchedulingConfig const &config,
+                               std::string &error) {
+        error.clear();
+        bool success = true;
+        auto appendError = [&](std::string const &msg, int err) {
+            if (!error.empty()) {
+                error += "; ";
+            }
+            error += msg + ": " + std::strerror(err);
+            success = false;
+        };
+        if (!config.cpus.empty()) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (auto cpu : config.cpus) {
+                if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                    appendError("CPU index " + std::to_string(cpu) +
+                                    " out of range",
+                                EINVAL);
+                    return false;
+                }
+                CPU_SET(cpu, &cpus);
+            }
+            auto ret =
+                pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            if (ret != 0) {
+                appendError("Could not set CPU affinity", ret);
+            }
+        }
+        if (config.policy != SchedulingPolicy::Default) {
+            int policy = config.policy == SchedulingPolicy::Fifo ? SCHED_FIFO
+                                                                 : SCHED_RR;
+            sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = std::min(
+                std::max(config.priority, sched_get_priority_min(policy)),
+                sched_get_priority_max(policy));
+            auto ret = pthread_setschedparam(pthread_self(), policy, &param);
+            if (ret == EPERM) {
+                appendError("Could not set real-time scheduling policy "
+                            "(requires CAP_SYS_NICE or RLIMIT_RTPRIO)",
+                            ret);
+            } else if (ret != 0) {
+                appendError("Could not set real-time scheduling policy", ret);
+            }
+        }
+        return success;
+    }
+#else
+    /// Scheduling and affinity are only implemented for Linux: elsewhere, a
+    /// default configuration succeeds as a no-op, and anything else fails
+    /// with an "unsupported" error, leaving the thread unchanged.
+    bool applyThreadScheduling(ThreadSchedulingConfig const &config,
+                               std::string &error) {
+        error.clear();
+        if (config.isDefault()) {
+            return true;
+        }
+        error = "unsupported: thread scheduling configuration is only "
+                "implemented on Linux";
+        return false;
+    }
+#endif
+
+    bool applyThreadScheduling(ThreadRole role) {
+        auto config = getThreadSchedulingConfig(role);
+        if (config.isDefault()) {
+            return true;
+        }
+        std::string error;
+        if (applyThreadScheduling(config, error)) {
+            return true;
+        }
+        static util::log::LoggerPtr logger =
+            util::log::make_logger("ThreadScheduling");
+        logger->warn() << "Failed to apply the " << getRoleName(role)
+                       << " thread scheduling configuration: " << error;
+        return false;
+    }
+} // namespace common
+} // namespace osvr
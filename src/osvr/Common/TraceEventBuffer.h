@@ -0,0 +1,220 @@
+/** @file
+    @brief Header containing the per-thread event ring buffer and Chrome
+    trace-event writer used by the in-process tracing backend.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TraceEventBuffer_h_GUID_6F88719C_6E79_42DF_B16C_7142F2DEB566
+#define INCLUDED_TraceEventBuffer_h_GUID_6F88719C_6E79_42DF_B16C_7142F2DEB566
+
+// Internal Includes
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        enum class TraceEventCategory : std::uint8_t { Main, Worker };
+
+        /// @brief A single recorded span or instant, with its text copied in
+        /// (truncated if needed) since markers may be built in temporaries.
+        struct TraceEvent {
+            static const std::size_t MAX_TEXT_LENGTH = 46;
+            static const std::int64_t INSTANT = -1;
+            /// @brief Start time, in nanoseconds since the trace epoch.
+            std::int64_t timestamp;
+            /// @brief Length of the span in nanoseconds, or INSTANT for a
+            /// mark.
+            std::int64_t duration;
+            TraceEventCategory category;
+            char text[MAX_TEXT_LENGTH + 1];
+        };
+
+        /// @brief Fixed-capacity ring of trace events, written by a single
+        /// thread and readable from any other.
+        ///
+        /// Recording never blocks or allocates: once full, the oldest events
+        /// are overwritten. Each slot carries a sequence number, bumped before
+        /// and after it is written, so a snapshot taken while the owning
+        /// thread is still recording discards any entry that was being
+        /// overwritten as it was read.
+        class TraceEventBuffer : boost::noncopyable {
+          public:
+            TraceEventBuffer(std::size_t capacity, std::uint32_t threadId)
+                : m_capacity(std::max(capacity, std::size_t(1))),
+                  m_slots(new Slot[m_capacity]), m_head(0),
+                  m_threadId(threadId) {}
+
+            /// @brief Called only from the owning thread.
+            void record(TraceEventCategory category, const char *text,
+                        std::int64_t timestamp, std::int64_t duration) {
+                auto pos = m_head.load(std::memory_order_relaxed);
+                Slot &slot = m_slots[pos % m_capacity];
+                slot.sequence.store(writingSequence(pos),
+                                    std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                TraceEvent &ev = slot.event;
+                ev.timestamp = timestamp;
+                ev.duration = duration;
+                ev.category = category;
+                std::strncpy(ev.text, text, TraceEvent::MAX_TEXT_LENGTH);
+                ev.text[TraceEvent::MAX_TEXT_LENGTH] = '\0';
+                slot.sequence.store(writtenSequence(pos),
+                                    std::memory_order_release);
+                m_head.store(pos + 1, std::memory_order_release);
+            }
+
+            /// @brief Appends the events currently held, oldest first, to
+            /// out.
+            void snapshot(std::vector<TraceEvent> &out) const {
+                auto end = m_head.load(std::memory_order_acquire);
+                auto begin = end > m_capacity ? end - m_capacity : 0;
+                for (auto i = begin; i < end; ++i) {
+                    Slot const &slot = m_slots[i % m_capacity];
+                    auto expected = writtenSequence(i);
+                    if (slot.sequence.load(std::memory_order_acquire) !=
+                        expected) {
+                        /// Already lapped by the writer.
+                        continue;
+                    }
+                    TraceEvent ev = slot.event;
+                    /// If the writer started on this slot while we copied,
+                    /// the copy is suspect: drop it.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) !=
+                        expected) {
+                        continue;
+                    }
+                    out.push_back(ev);
+                }
+            }
+
+            /// @brief Total number of events recorded, including those since
+            /// overwritten.
+            std::uint64_t totalRecorded() const {
+                return m_head.load(std::memory_order_relaxed);
+            }
+
+            std::size_t capacity() const { return m_capacity; }
+            std::uint32_t threadId() const { return m_threadId; }
+
+          private:
+            /// @brief Sequence numbers are zero until a slot is first written,
+            /// odd while event number pos is being written to it, and even
+            /// (and nonzero) once it holds event number pos.
+            struct Slot {
+                Slot() : sequence(0) {}
+                std::atomic<std::uint64_t> sequence;
+                TraceEvent event;
+            };
+            static std::uint64_t writingSequence(std::uint64_t pos) {
+                return pos * 2 + 1;
+            }
+            static std::uint64_t writtenSequence(std::uint64_t pos) {
+                return pos * 2 + 2;
+            }
+
+            const std::size_t m_capacity;
+            unique_ptr<Slot[]> m_slots;
+            std::atomic<std::uint64_t> m_head;
+            const std::uint32_t m_threadId;
+        };
+
+        namespace detail {
+            inline void writeJsonString(std::ostream &os, const char *str) {
+                os << '"';
+                for (; *str; ++str) {
+                    auto c = static_cast<unsigned char>(*str);
+                    if (c == '"' || c == '\\') {
+                        os << '\\' << *str;
+                    } else if (c < 0x20) {
+                        os << "\\u" << std::hex << std::setw(4)
+                           << std::setfill('0') << int(c) << std::dec;
+                    } else {
+                        os << *str;
+                    }
+                }
+                os << '"';
+            }
+
+            /// @brief Chrome trace timestamps are in (fractional)
+            /// microseconds.
+            inline void writeMicroseconds(std::ostream &os, std::int64_t ns) {
+                if (ns < 0) {
+                    os << '-';
+                    ns = -ns;
+                }
+                os << ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+                   << ns % 1000;
+            }
+        } // namespace detail
+
+        /// @brief Writes the events held by the given buffers as Chrome
+        /// trace-event format JSON, viewable in chrome://tracing or Perfetto.
+        inline void
+        writeChromeTrace(std::ostream &os, long pid,
+                         std::vector<TraceEventBuffer const *> const &buffers) {
+            os << "{\"traceEvents\":[";
+            bool first = true;
+            std::vector<TraceEvent> events;
+            for (auto buf : buffers) {
+                events.clear();
+                buf->snapshot(events);
+                for (auto const &ev : events) {
+                    os << (first ? "\n" : ",\n");
+                    first = false;
+                    os << "{\"name\":";
+                    detail::writeJsonString(os, ev.text);
+                    os << ",\"cat\":\""
+                       << (ev.category == TraceEventCategory::Main ? "main"
+                                                                   : "worker")
+                       << "\",\"pid\":" << pid
+                       << ",\"tid\":" << buf->threadId() << ",\"ts\":";
+                    detail::writeMicroseconds(os, ev.timestamp);
+                    if (ev.duration == TraceEvent::INSTANT) {
+                        os << ",\"ph\":\"i\",\"s\":\"t\"}";
+                    } else {
+                        os << ",\"ph\":\"X\",\"dur\":";
+                        detail::writeMicroseconds(os, ev.duration);
+                        os << "}";
+                    }
+                }
+            }
+            os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        }
+    } // namespace tracing
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TraceEventBuffer_h_GUID_6F88719C_6E79_42DF_B16C_7142F2DEB566
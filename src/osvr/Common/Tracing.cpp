@@ -26,6 +26,10 @@
 #include <osvr/Common/Tracing.h>
 
 #ifdef OSVR_COMMON_TRACING_ENABLED
+#if OSVR_COMMON_TRACING_RINGBUFFER
+#include "TraceEventBuffer.h"
+#endif
+
 // Library/third-party includes
 #if OSVR_COMMON_TRACING_ETW
 #include <vrpn_WindowsH.h>
@@ -33,7 +37,16 @@
 #endif
 
 // Standard includes
-// - none
+#if OSVR_COMMON_TRACING_RINGBUFFER
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+#endif
 
 namespace osvr {
 namespace common {
@@ -57,6 +70,124 @@ namespace common {
         }
 
         void WorkerTracePolicy::mark(const char *text) { ETWWorkerMark(text); }
+
+        bool dumpTrace(std::string const &) { return false; }
+#endif
+
+#if OSVR_COMMON_TRACING_RINGBUFFER
+        namespace {
+            /// @brief Events kept per thread: at 64 bytes each, 512KiB.
+            static const std::size_t EVENTS_PER_THREAD = 8192;
+            static const char TRACE_FILE_ENV[] = "OSVR_TRACE_FILE";
+
+            /// @brief Owns the buffers of every thread that has traced, so
+            /// their events outlive the threads themselves.
+            class TraceRegistry {
+              public:
+                /// @brief Intentionally leaked, so tracing from static
+                /// destructors remains safe.
+                static TraceRegistry &instance() {
+                    static TraceRegistry *registry = new TraceRegistry;
+                    return *registry;
+                }
+
+                std::shared_ptr<TraceEventBuffer> addThread() {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    auto buf = std::make_shared<TraceEventBuffer>(
+                        EVENTS_PER_THREAD,
+                        static_cast<std::uint32_t>(m_buffers.size()));
+                    m_buffers.push_back(buf);
+                    return buf;
+                }
+
+                std::int64_t now() const {
+                    return std::chrono::duration_cast<
+                               std::chrono::nanoseconds>(clock::now() -
+                                                         m_epoch)
+                        .count();
+                }
+
+                bool dump(std::string const &filename) {
+                    std::ofstream os(filename);
+                    if (!os) {
+                        return false;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        std::vector<TraceEventBuffer const *> buffers;
+                        for (auto const &buf : m_buffers) {
+                            buffers.push_back(buf.get());
+                        }
+                        writeChromeTrace(os, static_cast<long>(::getpid()),
+                                         buffers);
+                    }
+                    os.close();
+                    return static_cast<bool>(os);
+                }
+
+              private:
+                using clock = std::chrono::steady_clock;
+                TraceRegistry() : m_epoch(clock::now()) {
+                    if (std::getenv(TRACE_FILE_ENV)) {
+                        std::atexit(&dumpAtExit);
+                    }
+                }
+                static void dumpAtExit() {
+                    auto fn = std::getenv(TRACE_FILE_ENV);
+                    if (fn) {
+                        instance().dump(fn);
+                    }
+                }
+                const clock::time_point m_epoch;
+                std::mutex m_mutex;
+                std::vector<std::shared_ptr<TraceEventBuffer>> m_buffers;
+            };
+
+            inline TraceEventBuffer &getThreadBuffer() {
+                thread_local std::shared_ptr<TraceEventBuffer> buf =
+                    TraceRegistry::instance().addThread();
+                return *buf;
+            }
+
+            inline void recordSpan(TraceEventCategory category,
+                                   const char *text, TraceBeginStamp stamp) {
+                auto end = TraceRegistry::instance().now();
+                getThreadBuffer().record(category, text, stamp, end - stamp);
+            }
+
+            inline void recordMark(TraceEventCategory category,
+                                   const char *text) {
+                getThreadBuffer().record(category, text,
+                                         TraceRegistry::instance().now(),
+                                         TraceEvent::INSTANT);
+            }
+        } // namespace
+
+        TraceBeginStamp MainTracePolicy::begin(const char *) {
+            return TraceRegistry::instance().now();
+        }
+        void MainTracePolicy::end(const char *text, TraceBeginStamp stamp) {
+            recordSpan(TraceEventCategory::Main, text, stamp);
+        }
+
+        void MainTracePolicy::mark(const char *text) {
+            recordMark(TraceEventCategory::Main, text);
+        }
+
+        TraceBeginStamp WorkerTracePolicy::begin(const char *) {
+            return TraceRegistry::instance().now();
+        }
+        void WorkerTracePolicy::end(const char *text, TraceBeginStamp stamp) {
+            recordSpan(TraceEventCategory::Worker, text, stamp);
+        }
+
+        void WorkerTracePolicy::mark(const char *text) {
+            recordMark(TraceEventCategory::Worker, text);
+        }
+
+        bool dumpTrace(std::string const &filename) {
+            return TraceRegistry::instance().dump(filename);
+        }
 #endif
     } // namespace tracing
 } // namespace common
@@ -84,6 +84,9 @@ namespace connection {
             {
                 m_lockDone.lock();
                 m_sharedDone = false;
+                if (m_control.m_requestNotifier) {
+                    m_control.m_requestNotifier();
+                }
                 while (m_mainMessage == AsyncAccessControl::MTM_WAIT) {
                     m_condAsyncThread.wait(
                         m_lock); // In here we unlock the mutex
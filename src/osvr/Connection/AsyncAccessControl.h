@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -67,6 +67,16 @@ namespace connection {
         /// @returns true if there was a request to send.
         bool mainThreadDenyPermanently();
 
+        /// @brief Set a function to be called by the async thread once its
+        /// request to send is pending, just before it blocks awaiting a
+        /// response - so an event-driven main thread can be woken to service
+        /// it.
+        ///
+        /// Set before the async thread starts making requests.
+        void setRequestNotifier(std::function<void()> const &notifier) {
+            m_requestNotifier = notifier;
+        }
+
       private:
         /// @brief Messages/status that may be set by the main thread for read
         /// by
@@ -104,6 +114,8 @@ namespace connection {
 
         boost::optional<boost::thread::id> m_currentRequestThread;
 
+        std::function<void()> m_requestNotifier;
+
         /// @brief For the main thread sleep/wake awaiting completion of the
         /// async thread's work.
         boost::condition_variable m_condMainThread;
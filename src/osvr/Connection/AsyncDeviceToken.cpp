@@ -27,6 +27,7 @@
 // Internal Includes
 #include "AsyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Common/ThreadScheduling.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -43,6 +44,11 @@ namespace connection {
     AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
         : OSVR_DeviceTokenObject(name) {}
 
+    AsyncDeviceToken::AsyncDeviceToken(std::string const &name,
+                                       AsyncSendQueueConfig const &queueConfig)
+        : OSVR_DeviceTokenObject(name),
+          m_queue(new AsyncSendQueue(queueConfig)) {}
+
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In ~AsyncDeviceToken");
@@ -77,6 +83,7 @@ namespace connection {
                 : m_cb(cb), m_run(&run) {}
             void operator()() {
                 OSVR_DEV_VERBOSE("WaitCallbackLoop starting");
+                common::applyThreadScheduling(common::ThreadRole::AsyncDevice);
                 ::util::LoopGuard guard(*m_run);
                 while (m_run->shouldContinue()) {
                     m_cb();
@@ -96,6 +103,7 @@ namespace connection {
     }
     void AsyncDeviceToken::m_ensureThreadStarted() {
         if ((!m_callbackThread) && m_cb) {
+            m_accessControl.setRequestNotifier([&] { m_signalWakeup(); });
             m_callbackThread.reset(
                 new boost::thread(WaitCallbackLoop(m_run, m_cb)));
             m_run.signalAndWaitForStart();
@@ -105,6 +113,13 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
+        if (m_queue) {
+            OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
+                             "enqueueing message");
+            m_queue->push(timestamp, type, bytestream, len);
+            m_signalWakeup();
+            return;
+        }
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                          "about to create RTS object");
         RequestToSend rts(m_accessControl);
@@ -133,6 +148,22 @@ namespace connection {
         RequestToSend m_rts;
     };
 
+    bool AsyncDeviceToken::m_sendReport(QueuedReportSender sender,
+                                        void *target, uint32_t key,
+                                        util::time::TimeValue const &timestamp,
+                                        const char *report, size_t len) {
+        if (!m_queue) {
+            return OSVR_DeviceTokenObject::m_sendReport(sender, target, key,
+                                                        timestamp, report, len);
+        }
+        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendReport\t"
+                         "enqueueing report");
+        bool queued =
+            m_queue->pushReport(sender, target, key, timestamp, report, len);
+        m_signalWakeup();
+        return queued;
+    }
+
     util::GuardPtr AsyncDeviceToken::m_getSendGuard() {
         util::GuardPtr ret(new AsyncSendGuard(m_accessControl));
         return ret;
@@ -140,6 +171,14 @@ namespace connection {
 
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        if (m_queue) {
+            auto dev = m_getConnectionDevice();
+            m_queue->drain([&](util::time::TimeValue const &timestamp,
+                               MessageType *type, const char *bytestream,
+                               size_t len) {
+                dev->sendData(timestamp, type, bytestream, len);
+            });
+        }
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
         bool handled = m_accessControl.mainThreadCTS();
@@ -152,6 +191,15 @@ namespace connection {
         }
     }
 
+    boost::optional<AsyncSendQueueStats>
+    AsyncDeviceToken::m_getSendQueueStats() const {
+        boost::optional<AsyncSendQueueStats> ret;
+        if (m_queue) {
+            ret = m_queue->getStats();
+        }
+        return ret;
+    }
+
     void AsyncDeviceToken::m_stopThreads() { signalAndWaitForShutdown(); }
 
 } // namespace connection
@@ -29,6 +29,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
 #include "AsyncAccessControl.h"
+#include "AsyncSendQueue.h"
 
 // Library/third-party includes
 #include <boost/thread.hpp>
@@ -42,6 +43,12 @@ namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
         AsyncDeviceToken(std::string const &name);
+        /// @brief Constructor for queued mode: data sent with sendData is
+        /// copied into a bounded queue and forwarded the next time the main
+        /// thread calls connectionInteract, instead of blocking the device
+        /// thread in an RTS/CTS handshake.
+        AsyncDeviceToken(std::string const &name,
+                         AsyncSendQueueConfig const &queueConfig);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
@@ -53,16 +60,25 @@ namespace connection {
         /// interaction occurs.
         void m_setUpdateCallback(DeviceUpdateCallback const &cb) override;
         /// Called from the async thread - only permitted to actually
-        /// send data when m_connectionInteract says so.
+        /// send data when m_connectionInteract says so (or enqueues it, in
+        /// queued mode).
         void m_sendData(util::time::TimeValue const &timestamp,
                         MessageType *type, const char *bytestream,
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
-
-        /// Called from the main thread - services requests to send from
-        /// the async thread.
+        /// Called from the async thread - in queued mode, enqueues the report
+        /// for the sender to be called from m_connectionInteract.
+        bool m_sendReport(QueuedReportSender sender, void *target,
+                          uint32_t key, util::time::TimeValue const &timestamp,
+                          const char *report, size_t len) override;
+
+        /// Called from the main thread - drains the send queue if any, then
+        /// services requests to send from the async thread.
         void m_connectionInteract() override;
 
+        boost::optional<AsyncSendQueueStats>
+        m_getSendQueueStats() const override;
+
         void m_stopThreads() override;
 
         void m_ensureThreadStarted();
@@ -71,6 +87,9 @@ namespace connection {
 
         AsyncAccessControl m_accessControl;
 
+        /// @brief Only present in queued mode.
+        unique_ptr<AsyncSendQueue> m_queue;
+
         ::util::RunLoopManagerBoost m_run;
     };
 } // namespace connection
@@ -0,0 +1,321 @@
+/** @file
+    @brief Header containing the bounded lock-free queue used by queued-mode
+    async device tokens to hand pre-serialized messages to the server thread.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncSendQueue_h_GUID_B9480EF9_499C_4B79_A940_B1F0DFDD064C
+#define INCLUDED_AsyncSendQueue_h_GUID_B9480EF9_499C_4B79_A940_B1F0DFDD064C
+
+// Internal Includes
+#include <osvr/Connection/AsyncSendQueueTypes.h>
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief A bounded, lock-free queue of pre-serialized messages (and of
+    /// reports captured as bytes, to be sent by a QueuedReportSender), with a
+    /// single producer (the device thread) and a single draining consumer
+    /// (the server thread).
+    ///
+    /// Each slot carries a sequence number (after Vyukov's bounded queue), so
+    /// the producer can also pop the oldest entry itself to implement the
+    /// drop-oldest overflow policy without taking a lock. Message payloads
+    /// live in per-slot vectors that are swapped, not copied, between the
+    /// slots and the threads' scratch buffers, so once every buffer has grown
+    /// to the usual message size no further allocation takes place.
+    class AsyncSendQueue : boost::noncopyable {
+      public:
+        explicit AsyncSendQueue(AsyncSendQueueConfig const &config)
+            : m_capacity(roundUpToPowerOfTwo(config.capacity)),
+              m_mask(m_capacity - 1), m_policy(config.policy),
+              m_slots(new Slot[m_capacity]), m_enqueuePos(0), m_dequeuePos(0),
+              m_batch(m_capacity), m_highWaterMark(0), m_enqueued(0),
+              m_sent(0), m_dropped(0), m_coalesced(0) {
+            for (std::size_t i = 0; i < m_capacity; ++i) {
+                m_slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Called from the device thread: copies the message into the
+        /// queue, applying the overflow policy if it is full. Raw messages
+        /// are opaque, so they are never coalesced.
+        ///
+        /// @returns false if the new message was discarded.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, std::size_t len) {
+            Destination dest;
+            dest.type = type;
+            dest.key = NO_COALESCE_KEY;
+            return m_push(dest, timestamp, bytestream, len);
+        }
+
+        /// @brief Called from the device thread: copies a report into the
+        /// queue, to be passed to @p sender when drained. Only reports with
+        /// the same sender, target and key are coalesced with each other.
+        ///
+        /// @returns false if the new report was discarded.
+        bool pushReport(QueuedReportSender sender, void *target, uint32_t key,
+                        util::time::TimeValue const &timestamp,
+                        const char *report, std::size_t len) {
+            Destination dest;
+            dest.sender = sender;
+            dest.target = target;
+            dest.key = key;
+            return m_push(dest, timestamp, report, len);
+        }
+
+        /// @brief Called from the server thread: forwards at most one queue's
+        /// worth of messages, in order. Raw messages go to the given
+        /// function, with signature `void (util::time::TimeValue const &,
+        /// MessageType *, const char *, std::size_t)`; reports go to their
+        /// sender.
+        ///
+        /// Bounded so that a device producing continuously cannot starve the
+        /// rest of the server loop.
+        ///
+        /// @returns the number of messages forwarded.
+        template <typename F> std::size_t drain(F &&send) {
+            std::size_t count = 0;
+            while (count < m_capacity && m_tryPop([&](Slot &slot) {
+                       auto &entry = m_batch[count];
+                       entry.timestamp = slot.timestamp;
+                       entry.dest = slot.dest;
+                       std::swap(slot.data, entry.data);
+                   })) {
+                ++count;
+            }
+            const bool coalesce =
+                (m_policy == AsyncSendOverflowPolicy::Coalesce);
+            std::size_t forwarded = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (coalesce && m_supersededInBatch(i, count)) {
+                    m_coalesced.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                auto const &entry = m_batch[i];
+                const char *data =
+                    entry.data.empty() ? nullptr : entry.data.data();
+                if (entry.dest.sender) {
+                    entry.dest.sender(entry.dest.target, entry.timestamp, data,
+                                      entry.data.size());
+                } else {
+                    send(entry.timestamp, entry.dest.type, data,
+                         entry.data.size());
+                }
+                ++forwarded;
+            }
+            m_sent.fetch_add(forwarded, std::memory_order_relaxed);
+            return forwarded;
+        }
+
+        /// @brief Number of messages currently queued (approximate if called
+        /// concurrently with push/drain).
+        std::size_t size() const {
+            auto enq = m_enqueuePos.load(std::memory_order_relaxed);
+            auto deq = m_dequeuePos.load(std::memory_order_relaxed);
+            return enq > deq ? enq - deq : 0;
+        }
+
+        std::size_t capacity() const { return m_capacity; }
+
+        AsyncSendQueueStats getStats() const {
+            AsyncSendQueueStats ret;
+            ret.depth = size();
+            ret.highWaterMark =
+                m_highWaterMark.load(std::memory_order_relaxed);
+            ret.capacity = m_capacity;
+            ret.enqueued = m_enqueued.load(std::memory_order_relaxed);
+            ret.sent = m_sent.load(std::memory_order_relaxed);
+            ret.dropped = m_dropped.load(std::memory_order_relaxed);
+            ret.coalesced = m_coalesced.load(std::memory_order_relaxed);
+            return ret;
+        }
+
+      private:
+        /// @brief Where a queued entry goes: either a raw message type, or a
+        /// report sender and its target.
+        struct Destination {
+            MessageType *type = nullptr;
+            QueuedReportSender sender = nullptr;
+            void *target = nullptr;
+            uint32_t key = 0;
+            bool sameAs(Destination const &other) const {
+                return type == other.type && sender == other.sender &&
+                       target == other.target && key == other.key &&
+                       key != NO_COALESCE_KEY;
+            }
+        };
+
+        struct Slot {
+            std::atomic<std::size_t> seq;
+            util::time::TimeValue timestamp;
+            Destination dest;
+            std::vector<char> data;
+        };
+
+        struct Entry {
+            util::time::TimeValue timestamp;
+            Destination dest;
+            std::vector<char> data;
+        };
+
+        static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+            std::size_t ret = 2;
+            while (ret < n) {
+                ret <<= 1;
+            }
+            return ret;
+        }
+
+        bool m_push(Destination const &dest,
+                    util::time::TimeValue const &timestamp,
+                    const char *bytestream, std::size_t len) {
+            if (!m_tryPush(dest, timestamp, bytestream, len)) {
+                if (m_policy == AsyncSendOverflowPolicy::DropNewest) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                bool droppedOne = false;
+                do {
+                    /// Make room by discarding the oldest entry - at most
+                    /// one, since if the consumer is mid-pop on the slot we
+                    /// need, it will be released momentarily.
+                    if (!droppedOne &&
+                        m_tryPop([&](Slot &slot) {
+                            std::swap(slot.data, m_producerScratch);
+                        })) {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        droppedOne = true;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                } while (!m_tryPush(dest, timestamp, bytestream, len));
+            }
+            m_enqueued.fetch_add(1, std::memory_order_relaxed);
+            auto depth = size();
+            if (depth > m_highWaterMark.load(std::memory_order_relaxed)) {
+                m_highWaterMark.store(depth, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        /// @brief Producer side: only ever called from the device thread.
+        bool m_tryPush(Destination const &dest,
+                       util::time::TimeValue const &timestamp,
+                       const char *bytestream, std::size_t len) {
+            auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot &slot = m_slots[pos & m_mask];
+            if (slot.seq.load(std::memory_order_acquire) != pos) {
+                // Full, or the oldest entry is still being popped.
+                return false;
+            }
+            slot.timestamp = timestamp;
+            slot.dest = dest;
+            slot.data.assign(bytestream, bytestream + len);
+            slot.seq.store(pos + 1, std::memory_order_release);
+            m_enqueuePos.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Consumer side: may be called from the server thread, or from
+        /// the device thread when discarding the oldest entry, so claiming a
+        /// slot is done with a compare-and-swap.
+        template <typename F> bool m_tryPop(F &&f) {
+            auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot &slot = m_slots[pos & m_mask];
+                auto seq = slot.seq.load(std::memory_order_acquire);
+                if (seq == pos + 1) {
+                    if (m_dequeuePos.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed)) {
+                        f(slot);
+                        slot.seq.store(pos + m_capacity,
+                                       std::memory_order_release);
+                        return true;
+                    }
+                    // pos was updated by the failed CAS: try again.
+                } else if (seq < pos + 1) {
+                    // Empty.
+                    return false;
+                } else {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// @brief Whether a later entry in the batch being drained has the
+        /// same destination and key. The batch is at most one queue long, so
+        /// the quadratic scan is cheap.
+        bool m_supersededInBatch(std::size_t i, std::size_t count) const {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                if (m_batch[i].dest.sameAs(m_batch[j].dest)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const std::size_t m_capacity;
+        const std::size_t m_mask;
+        const AsyncSendOverflowPolicy m_policy;
+        unique_ptr<Slot[]> m_slots;
+
+        std::atomic<std::size_t> m_enqueuePos;
+        std::atomic<std::size_t> m_dequeuePos;
+
+        /// @name Device thread only
+        /// @{
+        std::vector<char> m_producerScratch;
+        /// @}
+
+        /// @name Server thread only
+        /// @{
+        /// @brief Entries popped by the current drain, before forwarding.
+        std::vector<Entry> m_batch;
+        /// @}
+
+        /// @name Metrics
+        /// @{
+        std::atomic<std::size_t> m_highWaterMark;
+        std::atomic<uint64_t> m_enqueued;
+        std::atomic<uint64_t> m_sent;
+        std::atomic<uint64_t> m_dropped;
+        std::atomic<uint64_t> m_coalesced;
+        /// @}
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncSendQueue_h_GUID_B9480EF9_499C_4B79_A940_B1F0DFDD064C
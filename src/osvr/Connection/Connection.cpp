@@ -162,6 +162,17 @@ namespace connection {
         }
     }
 
+    void
+    Connection::setWakeupHandler(std::function<void()> const &handler) {
+        m_wakeupHandler = handler;
+    }
+
+    void Connection::signalWakeup() {
+        if (m_wakeupHandler) {
+            m_wakeupHandler();
+        }
+    }
+
     Connection::Connection()
         : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
 
@@ -45,11 +45,16 @@ using osvr::connection::VirtualDeviceToken;
 using osvr::connection::ConnectionPtr;
 using osvr::connection::MessageType;
 using osvr::connection::ConnectionDevicePtr;
+using osvr::connection::AsyncSendQueueStats;
 using osvr::util::GuardPtr;
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName()));
+    auto queueConfig = init.getAsyncSendQueue();
+    DeviceTokenPtr ret(
+        queueConfig
+            ? new AsyncDeviceToken(init.getQualifiedName(), *queueConfig)
+            : new AsyncDeviceToken(init.getQualifiedName()));
     ret->m_sharedInit(init);
     return ret;
 }
@@ -92,6 +97,22 @@ void OSVR_DeviceTokenObject::sendData(
 
 GuardPtr OSVR_DeviceTokenObject::getSendGuard() { return m_getSendGuard(); }
 
+bool OSVR_DeviceTokenObject::sendReport(
+    osvr::connection::QueuedReportSender sender, void *target, uint32_t key,
+    osvr::util::time::TimeValue const &timestamp, const char *report,
+    size_t len) {
+    return m_sendReport(sender, target, key, timestamp, report, len);
+}
+
+bool OSVR_DeviceTokenObject::hasSendQueue() const {
+    return bool(m_getSendQueueStats());
+}
+
+boost::optional<AsyncSendQueueStats>
+OSVR_DeviceTokenObject::getSendQueueStats() const {
+    return m_getSendQueueStats();
+}
+
 void OSVR_DeviceTokenObject::setUpdateCallback(
     osvr::connection::DeviceUpdateCallback const &cb) {
     m_setUpdateCallback(cb);
@@ -126,8 +147,27 @@ ConnectionDevicePtr OSVR_DeviceTokenObject::m_getConnectionDevice() {
     return m_dev;
 }
 
+void OSVR_DeviceTokenObject::m_signalWakeup() { m_conn->signalWakeup(); }
+
 void OSVR_DeviceTokenObject::m_stopThreads() {}
 
+bool OSVR_DeviceTokenObject::m_sendReport(
+    osvr::connection::QueuedReportSender sender, void *target, uint32_t,
+    osvr::util::time::TimeValue const &timestamp, const char *report,
+    size_t len) {
+    auto guard = m_getSendGuard();
+    if (!guard->lock()) {
+        return false;
+    }
+    sender(target, timestamp, report, len);
+    return true;
+}
+
+boost::optional<AsyncSendQueueStats>
+OSVR_DeviceTokenObject::m_getSendQueueStats() const {
+    return boost::none;
+}
+
 void OSVR_DeviceTokenObject::m_sharedInit(DeviceInitObject &init) {
     m_conn = init.getConnection();
     m_dev = m_conn->createConnectionDevice(init);
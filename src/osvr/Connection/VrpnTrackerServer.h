@@ -27,6 +27,10 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/InProcessReportBus.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
 #include <osvr/Connection/TrackerServerInterface.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
@@ -35,7 +39,7 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace osvr {
 namespace connection {
@@ -44,7 +48,11 @@ namespace connection {
       public:
         typedef vrpn_Tracker Base;
         VrpnTrackerServer(DeviceConstructionData &init)
-            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn) {
+            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn),
+              m_name(init.getQualifiedName()),
+              m_channel(common::advertiseInProcessReports(init.conn, m_name)) {
+            m_poseBatchType = d_connection->register_message_type(
+                common::messages::TrackerPoseBatch::identifier());
             // Initialize data
             m_resetPos();
             m_resetQuat();
@@ -55,6 +63,11 @@ namespace connection {
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
+
+        ~VrpnTrackerServer() {
+            common::withdrawInProcessReports(d_connection, m_name, m_channel);
+        }
+
         static const vrpn_uint32 CLASS_OF_SERVICE = vrpn_CONNECTION_LOW_LATENCY;
 
         void sendReport(OSVR_PositionState const &val,
@@ -135,6 +148,35 @@ namespace connection {
             m_sendAccel(sensor, tv);
         }
 
+        void sendPoseBatch(OSVR_TrackerPoseBatchEntry const *entries,
+                           OSVR_ChannelCount count) override {
+            typedef common::messages::TrackerPoseBatch TrackerPoseBatch;
+            for (OSVR_ChannelCount offset = 0; offset < count;) {
+                OSVR_ChannelCount n = count - offset;
+                if (n > TrackerPoseBatch::MAX_ENTRIES_PER_MESSAGE) {
+                    n = TrackerPoseBatch::MAX_ENTRIES_PER_MESSAGE;
+                }
+                TrackerPoseBatch::MessageSerialization msg(entries + offset, n);
+                common::Buffer<> buf;
+                common::serialize(buf, msg);
+                struct timeval msgTime;
+                util::time::toStructTimeval(msgTime,
+                                            entries[offset].timestamp);
+                d_connection->pack_message(
+                    static_cast<vrpn_uint32>(buf.size()), msgTime,
+                    m_poseBatchType, Base::d_sender_id, buf.data(),
+                    CLASS_OF_SERVICE);
+                offset += n;
+            }
+
+            if (m_channel->hasSubscribers<OSVR_PoseState>()) {
+                for (OSVR_ChannelCount i = 0; i < count; ++i) {
+                    m_channel->publish(entries[i].pose, entries[i].sensor,
+                                       entries[i].timestamp);
+                }
+            }
+        }
+
       private:
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
@@ -172,6 +214,14 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::position_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+
+            // In-process subscribers get the same data, unpacked.
+            if (m_channel->hasSubscribers<OSVR_PoseState>()) {
+                OSVR_PoseState pose;
+                osvrVec3FromQuatlib(&(pose.translation), Base::pos);
+                osvrQuatFromQuatlib(&(pose.rotation), Base::d_quat);
+                m_channel->publish(pose, sensor, ts);
+            }
         }
 
         void m_sendVelocity(OSVR_ChannelCount sensor,
@@ -184,6 +234,17 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp,
                                        Base::velocity_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
+
+            if (m_channel->hasSubscribers<OSVR_VelocityState>()) {
+                OSVR_VelocityState vel;
+                osvrVec3FromQuatlib(&(vel.linearVelocity), Base::vel);
+                osvrQuatFromQuatlib(&(vel.angularVelocity.incrementalRotation),
+                                    Base::vel_quat);
+                vel.angularVelocity.dt = Base::vel_quat_dt;
+                vel.linearVelocityValid = true;
+                vel.angularVelocityValid = true;
+                m_channel->publish(vel, sensor, ts);
+            }
         }
 
         void m_sendAccel(OSVR_ChannelCount sensor,
@@ -196,7 +257,24 @@ namespace connection {
             d_connection->pack_message(len, Base::timestamp, Base::accel_m_id,
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
+
+            if (m_channel->hasSubscribers<OSVR_AccelerationState>()) {
+                OSVR_AccelerationState acc;
+                osvrVec3FromQuatlib(&(acc.linearAcceleration), Base::acc);
+                osvrQuatFromQuatlib(
+                    &(acc.angularAcceleration.incrementalRotation),
+                    Base::acc_quat);
+                acc.angularAcceleration.dt = Base::acc_quat_dt;
+                acc.linearAccelerationValid = true;
+                acc.angularAccelerationValid = true;
+                m_channel->publish(acc, sensor, ts);
+            }
         }
+
+        std::string m_name;
+        vrpn_int32 m_poseBatchType;
+        /// @brief Our reports, for subscribers sharing our connection.
+        common::InProcessReportChannelPtr m_channel;
     };
 
 } // namespace connection
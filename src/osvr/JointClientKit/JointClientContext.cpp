@@ -91,21 +91,30 @@ namespace client {
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
             }));
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                if (!m_pathTreeOwner.applyTreeDelta(delta)) {
+                    OSVR_DEV_VERBOSE("Ignoring path tree delta that does not "
+                                     "apply to our tree");
+                }
+            });
     }
 
     JointClientContext::~JointClientContext() {}
 
     void JointClientContext::m_update() {
-        /// Run the server
-        m_server->update();
-
-        /// Mainloop connections
-        m_vrpnConns.updateAll();
-
-        /// Update system device
-        m_systemDevice->update();
-        /// Update handlers.
-        m_ifaceMgr.updateHandlers();
+        /// Run the server, then service our side of its connection while
+        /// still excluding hardware detection workers, which may be creating
+        /// devices on it.
+        m_server->update([&] {
+            /// Mainloop connections
+            m_vrpnConns.updateAll();
+
+            /// Update system device
+            m_systemDevice->update();
+            /// Update handlers.
+            m_ifaceMgr.updateHandlers();
+        });
     }
 
     void JointClientContext::m_sendRoute(std::string const &route) {
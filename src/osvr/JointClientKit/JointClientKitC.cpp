@@ -182,6 +182,9 @@ OSVR_ClientContext osvrJointClientInit(const char applicationIdentifier[],
             ctx->getServer().loadAutoPlugins();
             ctx->getServer().triggerHardwareDetect();
         }
+        // Updates don't wait for detection, so have the devices found at
+        // startup ready for the first one.
+        ctx->getServer().waitForHardwareDetect();
         // Transfer ownership to the client app.
         return ctx.release();
     } catch (std::exception const &e) {
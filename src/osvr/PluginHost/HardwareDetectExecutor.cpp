@@ -0,0 +1,145 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HardwareDetectExecutor.h"
+#include "HostThreadWorker.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace pluginhost {
+    HardwareDetectExecutor::HardwareDetectExecutor(
+        JobSource const &source, std::chrono::milliseconds minInterval,
+        std::size_t maxThreads)
+        : m_source(source), m_minInterval(minInterval),
+          m_maxThreads(std::max(maxThreads, std::size_t(1))),
+          m_stopping(false) {}
+
+    HardwareDetectExecutor::~HardwareDetectExecutor() { shutdown(); }
+
+    void HardwareDetectExecutor::setHostLock(LockFunction const &lock,
+                                             LockFunction const &unlock) {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_lock = lock;
+        m_unlock = unlock;
+    }
+
+    void HardwareDetectExecutor::request() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_pending = true;
+        if (!m_thread.joinable()) {
+            m_thread = std::thread([&] { m_run(); });
+        }
+        m_wakeup.notify_one();
+    }
+
+    void HardwareDetectExecutor::waitForIdle() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock,
+                    [&] { return m_stopping || (!m_pending && !m_running); });
+    }
+
+    void HardwareDetectExecutor::shutdown() {
+        std::thread thread;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+            thread = std::move(m_thread);
+        }
+        m_wakeup.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    std::uint64_t HardwareDetectExecutor::passesCompleted() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_passesCompleted;
+    }
+
+    void HardwareDetectExecutor::m_run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wakeup.wait(lock, [&] { return m_stopping || m_pending; });
+            if (m_stopping) {
+                break;
+            }
+            if (m_everRan &&
+                m_wakeup.wait_until(lock, m_lastStart + m_minInterval,
+                                    [&] { return bool(m_stopping); })) {
+                break;
+            }
+            // Everything requested so far is covered by this pass.
+            m_pending = false;
+            m_running = true;
+            m_everRan = true;
+            m_lastStart = clock::now();
+            lock.unlock();
+            m_runPass();
+            lock.lock();
+            m_running = false;
+            ++m_passesCompleted;
+            m_idle.notify_all();
+        }
+        m_pending = false;
+        m_idle.notify_all();
+    }
+
+    void HardwareDetectExecutor::m_runPass() {
+        std::vector<Job> jobs;
+        m_lockHost();
+        try {
+            jobs = m_source();
+        } catch (...) {
+            // Nothing to detect with.
+        }
+        m_unlockHost();
+
+        runOnHostThreadWorkers(jobs, m_maxThreads, [&] { m_lockHost(); },
+                               [&] { m_unlockHost(); }, &m_stopping);
+    }
+
+    void HardwareDetectExecutor::m_lockHost() {
+        if (m_lock) {
+            m_lock();
+        }
+    }
+
+    void HardwareDetectExecutor::m_unlockHost() {
+        if (m_unlock) {
+            m_unlock();
+        }
+    }
+
+} // namespace pluginhost
+} // namespace osvr
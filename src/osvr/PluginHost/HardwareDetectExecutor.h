@@ -0,0 +1,123 @@
+/** @file
+    @brief Header declaring the executor that runs hardware detection off the
+    host thread.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HardwareDetectExecutor_h_GUID_DC424AE6_1A0F_4CC5_9E74_30D5CFA4CE4A
+#define INCLUDED_HardwareDetectExecutor_h_GUID_DC424AE6_1A0F_4CC5_9E74_30D5CFA4CE4A
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace pluginhost {
+    /// @brief Runs hardware detection passes on a background thread, with the
+    /// jobs of each pass (one per plugin) spread over a few worker threads.
+    ///
+    /// Requests made while a pass is pending or running are coalesced into at
+    /// most one further pass, and passes start no more often than the minimum
+    /// interval. Jobs create devices inside a HostThreadSection, which takes
+    /// the host lock so that creation is serialized with the host's main
+    /// loop.
+    class HardwareDetectExecutor : boost::noncopyable {
+      public:
+        typedef std::function<void()> Job;
+        /// @brief Called at the start of each pass, with the host lock held,
+        /// to get the jobs to run.
+        typedef std::function<std::vector<Job>()> JobSource;
+        typedef std::function<void()> LockFunction;
+
+        HardwareDetectExecutor(JobSource const &source,
+                               std::chrono::milliseconds minInterval,
+                               std::size_t maxThreads);
+
+        /// @brief Stops after any jobs already running.
+        ~HardwareDetectExecutor();
+
+        /// @brief Sets the functions locking and unlocking the host's main
+        /// loop. Must be called before the first request.
+        void setHostLock(LockFunction const &lock, LockFunction const &unlock);
+
+        /// @brief Asks for a detection pass, without waiting for it.
+        void request();
+
+        /// @brief Blocks until no pass is pending or running.
+        ///
+        /// Must not be called with the host lock held.
+        void waitForIdle();
+
+        /// @brief Lets jobs already running finish, skips the rest, and stops
+        /// the background thread. Later requests are ignored.
+        ///
+        /// Must not be called with the host lock held.
+        void shutdown();
+
+        /// @brief Number of passes completed.
+        std::uint64_t passesCompleted() const;
+
+      private:
+        typedef std::chrono::steady_clock clock;
+        void m_run();
+        void m_runPass();
+        void m_lockHost();
+        void m_unlockHost();
+
+        const JobSource m_source;
+        const std::chrono::milliseconds m_minInterval;
+        const std::size_t m_maxThreads;
+        LockFunction m_lock;
+        LockFunction m_unlock;
+
+        std::atomic<bool> m_stopping;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::condition_variable m_idle;
+        /// @name Protected by m_mutex
+        /// @{
+        bool m_pending = false;
+        bool m_running = false;
+        bool m_everRan = false;
+        clock::time_point m_lastStart;
+        std::uint64_t m_passesCompleted = 0;
+        std::thread m_thread;
+        /// @}
+    };
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_HardwareDetectExecutor_h_GUID_DC424AE6_1A0F_4CC5_9E74_30D5CFA4CE4A
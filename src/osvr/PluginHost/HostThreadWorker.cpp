@@ -0,0 +1,137 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HostThreadWorker.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace osvr {
+namespace pluginhost {
+    namespace {
+        /// Registered worker threads, so a HostThreadSection knows whether
+        /// (and what) to lock. (Not thread_local, for the sake of older
+        /// MSVC.)
+        std::mutex g_workerMutex;
+        std::map<std::thread::id, HostThreadWorker *> g_workers;
+    } // namespace
+
+    HostThreadWorker::HostThreadWorker(HostLockFunction const &lock,
+                                       HostLockFunction const &unlock)
+        : m_lock(lock), m_unlock(unlock) {
+        std::lock_guard<std::mutex> guard(g_workerMutex);
+        g_workers[std::this_thread::get_id()] = this;
+    }
+
+    HostThreadWorker::~HostThreadWorker() {
+        std::lock_guard<std::mutex> guard(g_workerMutex);
+        g_workers.erase(std::this_thread::get_id());
+    }
+
+    void HostThreadWorker::enterSection() {
+        HostThreadWorker *worker = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(g_workerMutex);
+            auto it = g_workers.find(std::this_thread::get_id());
+            if (it == end(g_workers)) {
+                return;
+            }
+            if (it->second->m_depth++ == 0) {
+                worker = it->second;
+            }
+        }
+        if (worker && worker->m_lock) {
+            worker->m_lock();
+        }
+    }
+
+    void HostThreadWorker::leaveSection() {
+        HostThreadWorker *worker = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(g_workerMutex);
+            auto it = g_workers.find(std::this_thread::get_id());
+            if (it == end(g_workers)) {
+                return;
+            }
+            if (--it->second->m_depth == 0) {
+                worker = it->second;
+            }
+        }
+        if (worker && worker->m_unlock) {
+            worker->m_unlock();
+        }
+    }
+
+    void runOnHostThreadWorkers(std::vector<std::function<void()> > const &jobs,
+                                std::size_t maxThreads,
+                                HostLockFunction const &lock,
+                                HostLockFunction const &unlock,
+                                std::atomic<bool> const *stop) {
+        std::atomic<std::size_t> next(0);
+        auto work = [&] {
+            HostThreadWorker registration(lock, unlock);
+            while (!(stop && *stop)) {
+                auto i = next.fetch_add(1);
+                if (i >= jobs.size()) {
+                    break;
+                }
+                try {
+                    jobs[i]();
+                } catch (...) {
+                    // Jobs are expected to report their own errors.
+                }
+            }
+        };
+
+        auto numThreads =
+            std::min(std::max(maxThreads, std::size_t(1)), jobs.size());
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; ++i) {
+            try {
+                threads.emplace_back(work);
+            } catch (std::system_error &) {
+                // Carry on with the threads we have.
+                break;
+            }
+        }
+        if (threads.empty() && !jobs.empty()) {
+            // Couldn't start any: do it ourselves, like a worker would.
+            work();
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+} // namespace pluginhost
+} // namespace osvr
@@ -0,0 +1,79 @@
+/** @file
+    @brief Header declaring the registration of worker threads whose
+    HostThreadSections take a host lock, and a helper running jobs on them.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HostThreadWorker_h_GUID_BF5D3D26_02F9_465B_8056_100178D10C9F
+#define INCLUDED_HostThreadWorker_h_GUID_BF5D3D26_02F9_465B_8056_100178D10C9F
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace osvr {
+namespace pluginhost {
+    typedef std::function<void()> HostLockFunction;
+
+    /// @brief For its lifetime, registers the current thread as a worker
+    /// whose HostThreadSection objects take the given lock.
+    class HostThreadWorker : boost::noncopyable {
+      public:
+        HostThreadWorker(HostLockFunction const &lock,
+                         HostLockFunction const &unlock);
+        ~HostThreadWorker();
+
+        /// @name HostThreadSection implementation
+        /// @{
+        static void enterSection();
+        static void leaveSection();
+        /// @}
+
+      private:
+        HostLockFunction m_lock;
+        HostLockFunction m_unlock;
+        /// Nesting depth of HostThreadSection on this thread.
+        int m_depth = 0;
+    };
+
+    /// @brief Runs the jobs on up to maxThreads new worker threads (each
+    /// registered as a HostThreadWorker with the given lock) and waits for
+    /// them all. Exceptions thrown by jobs are swallowed. If stop is given
+    /// and becomes true, jobs not yet started are skipped.
+    void runOnHostThreadWorkers(std::vector<std::function<void()> > const &jobs,
+                                std::size_t maxThreads,
+                                HostLockFunction const &lock,
+                                HostLockFunction const &unlock,
+                                std::atomic<bool> const *stop = nullptr);
+} // namespace pluginhost
+} // namespace osvr
+
+#endif // INCLUDED_HostThreadWorker_h_GUID_BF5D3D26_02F9_465B_8056_100178D10C9F
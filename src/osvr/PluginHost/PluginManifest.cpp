@@ -0,0 +1,296 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/PluginHost/PluginManifest.h>
+#include <osvr/PluginHost/PathConfig.h>
+#include <osvr/Util/GetEnvironmentVariable.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/filesystem.hpp>
+#include <json/reader.h>
+#include <json/value.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <map>
+
+namespace osvr {
+namespace pluginhost {
+    namespace fs = boost::filesystem;
+
+    /// @brief Bumped on incompatible changes to the file format.
+    static const int MANIFEST_VERSION = 1;
+    static const char MANIFEST_FILENAME[] = "plugin-manifest.json";
+
+    /// @brief A directory listing is only trusted if made at least this many
+    /// seconds after the directory's last modification: otherwise, a further
+    /// change might not show in a coarse-grained timestamp.
+    static const std::time_t RACY_LISTING_SECONDS = 2;
+
+    namespace {
+        struct DirectoryEntry {
+            std::time_t mtime = 0;
+            /// When the listing was made.
+            std::time_t listed = 0;
+            /// Sorted names of the plugin files in the directory.
+            std::vector<std::string> files;
+        };
+
+        Json::Value toJson(std::vector<std::string> const &strings) {
+            Json::Value ret(Json::arrayValue);
+            for (auto const &str : strings) {
+                ret.append(str);
+            }
+            return ret;
+        }
+
+        std::vector<std::string> fromJson(Json::Value const &strings) {
+            std::vector<std::string> ret;
+            for (auto const &str : strings) {
+                ret.push_back(str.asString());
+            }
+            return ret;
+        }
+    } // namespace
+
+    struct PluginManifest::Impl {
+        Impl(std::string const &manifestFile, std::string const &extension)
+            : file(manifestFile), ext(extension) {}
+
+        /// @returns nullptr if the directory doesn't exist.
+        DirectoryEntry const *listDirectory(std::string const &dir);
+        void load();
+
+        const std::string file;
+        const std::string ext;
+        std::map<std::string, DirectoryEntry> directories;
+        bool dirty = false;
+        std::size_t directoriesCached = 0;
+        std::size_t directoriesScanned = 0;
+    };
+
+    DirectoryEntry const *
+    PluginManifest::Impl::listDirectory(std::string const &dir) {
+        boost::system::error_code ec;
+        if (!fs::is_directory(dir, ec)) {
+            if (directories.erase(dir)) {
+                dirty = true;
+            }
+            return nullptr;
+        }
+        auto mtime = fs::last_write_time(dir, ec);
+        auto it = directories.find(dir);
+        if (!ec && it != end(directories) && it->second.mtime == mtime &&
+            it->second.listed - mtime >= RACY_LISTING_SECONDS) {
+            ++directoriesCached;
+            return &it->second;
+        }
+
+        DirectoryEntry entry;
+        entry.mtime = mtime;
+        entry.listed = std::time(nullptr);
+        for (fs::directory_iterator file(dir, ec), e; !ec && file != e;
+             file.increment(ec)) {
+            /// @todo does this mean symlinks get excluded?
+            boost::system::error_code fileEc;
+            if (!fs::is_regular_file(file->path(), fileEc) ||
+                file->path().extension().generic_string() != ext) {
+                continue;
+            }
+            entry.files.push_back(file->path().filename().generic_string());
+        }
+        // Sorted, for a deterministic load order.
+        std::sort(begin(entry.files), end(entry.files));
+        ++directoriesScanned;
+        dirty = true;
+        auto &stored = directories[dir];
+        stored = std::move(entry);
+        return &stored;
+    }
+
+    void PluginManifest::Impl::load() {
+        if (file.empty()) {
+            return;
+        }
+        std::ifstream is(file);
+        if (!is.good()) {
+            return;
+        }
+        Json::Value root;
+        Json::Reader reader;
+        if (!reader.parse(is, root) || !root.isObject() ||
+            root["version"] != MANIFEST_VERSION ||
+            root["extension"] != ext) {
+            // Not ours, outdated, or corrupt: start afresh.
+            return;
+        }
+        try {
+            for (auto const &dir : root["directories"]) {
+                DirectoryEntry entry;
+                entry.mtime = std::time_t(dir["mtime"].asInt64());
+                entry.listed = std::time_t(dir["listed"].asInt64());
+                entry.files = fromJson(dir["files"]);
+                directories[dir["path"].asString()] = std::move(entry);
+            }
+        } catch (std::exception &) {
+            // Wrong types somewhere: start afresh.
+            directories.clear();
+        }
+    }
+
+    PluginManifest::PluginManifest(std::string const &file,
+                                   std::string const &ext)
+        : m_impl(new Impl(file, ext)) {
+        m_impl->load();
+    }
+
+    PluginManifest::~PluginManifest() {}
+
+    FileList PluginManifest::getPluginFiles(SearchPath const &searchPaths) {
+        FileList ret;
+        for (auto const &dir : searchPaths) {
+            auto listing = m_impl->listDirectory(dir);
+            if (!listing) {
+                continue;
+            }
+            for (auto const &name : listing->files) {
+                ret.push_back((fs::path(dir) / name).generic_string());
+            }
+        }
+        return ret;
+    }
+
+    std::string PluginManifest::findPlugin(SearchPath const &searchPaths,
+                                           std::string const &pluginName) {
+        for (auto const &dir : searchPaths) {
+            auto listing = m_impl->listDirectory(dir);
+            if (!listing) {
+                continue;
+            }
+            for (auto const &name : listing->files) {
+                auto baseName = fs::path(name).stem().generic_string();
+                /// If the name is right or has the manual load suffix, this is
+                /// a good one.
+                if (baseName == pluginName ||
+                    baseName == pluginName + OSVR_PLUGIN_IGNORE_SUFFIX) {
+                    return (fs::path(dir) / name).generic_string();
+                }
+            }
+        }
+        return std::string();
+    }
+
+    bool PluginManifest::save() {
+        if (!m_impl->dirty || m_impl->file.empty()) {
+            return true;
+        }
+
+        Json::Value root(Json::objectValue);
+        root["version"] = MANIFEST_VERSION;
+        root["extension"] = m_impl->ext;
+        Json::Value &dirs = root["directories"] = Json::arrayValue;
+        for (auto const &dir : m_impl->directories) {
+            Json::Value entry(Json::objectValue);
+            entry["path"] = dir.first;
+            entry["mtime"] = Json::Int64(dir.second.mtime);
+            entry["listed"] = Json::Int64(dir.second.listed);
+            entry["files"] = toJson(dir.second.files);
+            dirs.append(entry);
+        }
+
+        // Write and rename, so another process never reads a partial file.
+        boost::system::error_code ec;
+        fs::path file(m_impl->file);
+        if (file.has_parent_path()) {
+            fs::create_directories(file.parent_path(), ec);
+        }
+        auto temp = file;
+        temp += ".tmp";
+        {
+            std::ofstream os(temp.string());
+            if (!os.good()) {
+                return false;
+            }
+            os << root.toStyledString();
+            if (!os.good()) {
+                return false;
+            }
+        }
+        fs::rename(temp, file, ec);
+        if (ec) {
+            fs::remove(temp, ec);
+            return false;
+        }
+        m_impl->dirty = false;
+        return true;
+    }
+
+    std::size_t PluginManifest::getDirectoriesCached() const {
+        return m_impl->directoriesCached;
+    }
+
+    std::size_t PluginManifest::getDirectoriesScanned() const {
+        return m_impl->directoriesScanned;
+    }
+
+    std::string getPluginManifestPath() {
+        using osvr::util::getEnvironmentVariable;
+        auto configured = getEnvironmentVariable("OSVR_PLUGIN_MANIFEST");
+        if (configured) {
+            return *configured == "0" ? std::string() : *configured;
+        }
+        fs::path dir;
+#if defined(OSVR_LINUX)
+        // $XDG_CACHE_HOME, defaulting to $HOME/.cache, as for the log files.
+        auto xdg_cache_dir = getEnvironmentVariable("XDG_CACHE_HOME");
+        auto home_dir = getEnvironmentVariable("HOME");
+        if (xdg_cache_dir) {
+            dir = fs::path(*xdg_cache_dir) / "osvr";
+        } else if (home_dir) {
+            dir = fs::path(*home_dir) / ".cache" / "osvr";
+        }
+#elif defined(OSVR_MACOSX)
+        auto home_dir = getEnvironmentVariable("HOME");
+        if (home_dir) {
+            dir = fs::path(*home_dir) / "Library" / "Caches" / "OSVR";
+        }
+#elif defined(OSVR_WINDOWS)
+        auto local_app_dir = getEnvironmentVariable("LocalAppData");
+        if (local_app_dir) {
+            dir = fs::path(*local_app_dir) / "OSVR";
+        }
+#endif
+        if (dir.empty()) {
+            return std::string();
+        }
+        return (dir / MANIFEST_FILENAME).string();
+    }
+
+} // namespace pluginhost
+} // namespace osvr
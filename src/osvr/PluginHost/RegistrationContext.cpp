@@ -30,9 +30,13 @@
 // Internal Includes
 #include <osvr/PluginHost/RegistrationContext.h>
 
+#include "HardwareDetectExecutor.h"
+#include "HostThreadWorker.h"
 #include "PluginSpecificRegistrationContextImpl.h"
 #include <osvr/PluginHost/PathConfig.h>
+#include <osvr/PluginHost/PluginManifest.h>
 #include <osvr/PluginHost/SearchPath.h>
+#include <osvr/Util/GetEnvironmentVariable.h>
 #include <osvr/Util/Log.h>
 #include <osvr/Util/Verbosity.h>
 
@@ -46,7 +50,11 @@
 
 // Standard includes
 #include <algorithm>
+#include <chrono>
 #include <iterator>
+#include <mutex>
+#include <set>
+#include <thread>
 
 namespace osvr {
 namespace pluginhost {
@@ -56,18 +64,110 @@ namespace pluginhost {
 #endif
     namespace fs = boost::filesystem;
 
+    /// @brief Minimum time between the starts of background hardware
+    /// detection passes: more frequent requests (for instance, one per client
+    /// ping) are coalesced.
+    static const auto HARDWARE_DETECT_MIN_INTERVAL =
+        std::chrono::milliseconds(1000);
+    /// @brief Upper bound on the threads running detect callbacks at once.
+    static const unsigned MAX_HARDWARE_DETECT_THREADS = 4;
+
+    /// @brief Upper bound on the threads loading plugins at once: beyond a
+    /// few, they mostly wait on the dynamic loader's own lock.
+    static const unsigned MAX_PLUGIN_LOAD_THREADS = 4;
+
+    static inline std::size_t getWorkerThreads(unsigned maxThreads) {
+        auto cores = std::thread::hardware_concurrency();
+        return std::max(1u, std::min(cores, maxThreads));
+    }
+
+    static inline std::size_t getHardwareDetectThreads() {
+        return getWorkerThreads(MAX_HARDWARE_DETECT_THREADS);
+    }
+
+    /// @brief The number of threads to load plugins on: may be set with
+    /// OSVR_PLUGIN_LOAD_THREADS (1 loads them one at a time on the calling
+    /// thread, as before).
+    static inline std::size_t getPluginLoadThreads() {
+        auto configured =
+            util::getEnvironmentVariable("OSVR_PLUGIN_LOAD_THREADS");
+        if (configured) {
+            try {
+                return std::max(std::stoul(*configured), 1ul);
+            } catch (std::exception &) {
+                // Not a number: use the default.
+            }
+        }
+        return getWorkerThreads(MAX_PLUGIN_LOAD_THREADS);
+    }
+
     struct RegistrationContext::Impl : private boost::noncopyable {
         /// constructor - creates and caches the plugin search path
-        Impl() : pluginPaths(pluginhost::getPluginSearchPath()) {}
+        explicit Impl(HardwareDetectExecutor::JobSource const &detectJobs)
+            : pluginPaths(pluginhost::getPluginSearchPath()),
+              detectExecutor(detectJobs, HARDWARE_DETECT_MIN_INTERVAL,
+                             getHardwareDetectThreads()) {}
+
+        /// @brief The manifest, loaded on first use.
+        PluginManifest &getManifest() {
+            if (!manifest) {
+                manifest.reset(new PluginManifest(getPluginManifestPath(),
+                                                  OSVR_PLUGIN_EXTENSION));
+            }
+            return *manifest;
+        }
+
+        /// @brief Locks the host, or just serializes with other plugin
+        /// loading threads if no host lock was set.
+        void lockHost() {
+            if (hostLock) {
+                hostLock();
+            } else {
+                loadMutex.lock();
+            }
+        }
+
+        void unlockHost() {
+            if (hostUnlock) {
+                hostUnlock();
+            } else {
+                loadMutex.unlock();
+            }
+        }
 
         const std::vector<std::string> pluginPaths;
+        HardwareDetectExecutor detectExecutor;
+        std::function<void()> hostLock;
+        std::function<void()> hostUnlock;
+        std::mutex loadMutex;
+        unique_ptr<PluginManifest> manifest;
     };
 
     RegistrationContext::RegistrationContext()
-        : m_impl(new Impl),
+        : m_impl(new Impl([&] {
+              // Runs with the host lock held, so m_regMap is stable.
+              std::vector<HardwareDetectExecutor::Job> jobs;
+              m_logger->info() << "Performing hardware auto-detection.";
+              auto logger = m_logger;
+              for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
+                  jobs.push_back([pluginPtr, logger] {
+                      try {
+                          pluginPtr->triggerHardwareDetectCallbacks();
+                      } catch (std::exception const &e) {
+                          logger->error()
+                              << "Hardware detection in plugin "
+                              << pluginPtr->getName() << " failed: "
+                              << e.what();
+                      }
+                  });
+              }
+              return jobs;
+          })),
           m_logger(util::log::make_logger(PLUGIN_HOST_LOGGER_NAME)) {}
 
     RegistrationContext::~RegistrationContext() {
+        // No detect callbacks may be running once plugins start going away.
+        shutdownHardwareDetect();
         // Reset the plugins in reverse order.
         for (auto &ptr : m_regMap | boost::adaptors::map_values |
                              boost::adaptors::reversed) {
@@ -110,25 +210,26 @@ namespace pluginhost {
         }
     }
 
-    void RegistrationContext::loadPlugin(std::string const &pluginName) {
-        if (isPluginLoaded(m_regMap, pluginName)) {
-            throw std::runtime_error("Already loaded a plugin named " +
-                                     pluginName);
-        }
-
+    /// @brief Loads a plugin into a new plugin-specific context, given the
+    /// path found for it (or an empty path to try loading it by name).
+    ///
+    /// Doesn't touch the parent beyond recording it in the new context, so
+    /// may run on a plugin loading thread.
+    static PluginRegPtr loadPluginContext(RegistrationContext &parent,
+                                          util::log::Logger &log,
+                                          std::string const &pluginName,
+                                          std::string const &pluginPathName) {
         PluginRegPtr pluginReg(
             PluginSpecificRegistrationContext::create(pluginName));
-        pluginReg->setParent(*this);
+        pluginReg->setParent(parent);
 
         bool success = false;
         libfunc::PluginHandle plugin;
         auto ctx = pluginReg->extractOpaquePointer();
-        const std::string pluginPathName =
-            pluginhost::findPlugin(m_impl->pluginPaths, pluginName);
         if (pluginPathName.empty()) {
             // was the plugin pre-loaded or statically linked? Try loading
             // it by name.
-            success = tryLoadingPlugin(*m_logger, plugin, pluginName, ctx);
+            success = tryLoadingPlugin(log, plugin, pluginName, ctx);
             if (!success) {
                 throw std::runtime_error("Could not find plugin named " +
                                          pluginName);
@@ -141,10 +242,9 @@ namespace pluginhost {
                  fs::path(pluginPathName).stem())
                     .generic_string();
 
-            success =
-                tryLoadingPlugin(*m_logger, plugin, pluginPathName, ctx) ||
-                tryLoadingPlugin(*m_logger, plugin, pluginPathNameNoExt, ctx,
-                                 true);
+            success = tryLoadingPlugin(log, plugin, pluginPathName, ctx) ||
+                      tryLoadingPlugin(log, plugin, pluginPathNameNoExt, ctx,
+                                       true);
             if (!success) {
                 throw std::runtime_error(
                     "Unusual error occurred trying to load plugin named " +
@@ -152,15 +252,51 @@ namespace pluginhost {
             }
         }
         pluginReg->takePluginHandle(plugin);
+        return pluginReg;
+    }
+
+    void RegistrationContext::loadPlugin(std::string const &pluginName) {
+        if (isPluginLoaded(m_regMap, pluginName)) {
+            throw std::runtime_error("Already loaded a plugin named " +
+                                     pluginName);
+        }
+
+        auto &manifest = m_impl->getManifest();
+        const std::string pluginPathName =
+            manifest.findPlugin(m_impl->pluginPaths, pluginName);
+        auto pluginReg =
+            loadPluginContext(*this, *m_logger, pluginName, pluginPathName);
         adoptPluginRegistrationContext(pluginReg);
+        manifest.save();
     }
 
+    namespace {
+        /// @brief A plugin found by loadPlugins(), and the outcome of loading
+        /// it.
+        struct PluginLoad {
+            std::string name;
+            std::string path;
+            PluginRegPtr reg;
+            std::string error;
+            double milliseconds = 0;
+        };
+    } // namespace
+
     void RegistrationContext::loadPlugins() {
+        typedef std::chrono::steady_clock clock;
+        typedef std::chrono::duration<double, std::milli> milliseconds;
+        const auto start = clock::now();
+
         // Build a list of all the plugins we can find
-        auto pluginPathNames = pluginhost::getAllFilesWithExt(
-            m_impl->pluginPaths, OSVR_PLUGIN_EXTENSION);
+        auto &manifest = m_impl->getManifest();
+        const auto cachedBefore = manifest.getDirectoriesCached();
+        const auto scannedBefore = manifest.getDirectoriesScanned();
+        auto pluginPathNames = manifest.getPluginFiles(m_impl->pluginPaths);
+        const auto listed = clock::now();
 
-        // Load all of the non-.manualload plugins
+        // Pick out all of the non-.manualload plugins
+        std::vector<PluginLoad> loads;
+        std::set<std::string> names;
         for (const auto &plugin : pluginPathNames) {
             m_logger->debug() << "Examining plugin '" << plugin << "'...";
             const auto pluginBaseName =
@@ -193,18 +329,85 @@ namespace pluginhost {
 #endif // NDEBUG
 #endif // _MSC_VER
 
-            try {
-                loadPlugin(pluginBaseName);
-                m_logger->debug() << "Successfully loaded plugin: "
-                                  << pluginBaseName;
-            } catch (const std::exception &e) {
-                m_logger->warn() << "Failed to load plugin " << pluginBaseName
-                                 << ": " << e.what();
-            } catch (...) {
-                m_logger->warn() << "Failed to load plugin " << pluginBaseName
-                                 << ": Unknown error.";
+            PluginLoad load;
+            load.name = pluginBaseName;
+            load.path = plugin;
+            if (isPluginLoaded(m_regMap, pluginBaseName) ||
+                !names.insert(pluginBaseName).second) {
+                // Same name earlier in the search path: checked up front, as
+                // the two must not load at the same time.
+                load.error = "Already loaded a plugin named " + pluginBaseName;
+            }
+            loads.push_back(std::move(load));
+        }
+
+        // Load them, on several threads if allowed. Plugins creating devices
+        // from their entry points do so in a HostThreadSection, serialized
+        // with each other and with the host.
+        std::vector<std::function<void()> > jobs;
+        auto &log = *m_logger;
+        for (auto &load : loads) {
+            if (!load.error.empty()) {
+                continue;
+            }
+            auto *loadPtr = &load;
+            jobs.push_back([this, &log, loadPtr] {
+                auto &load = *loadPtr;
+                const auto begin = clock::now();
+                try {
+                    load.reg = loadPluginContext(*this, log, load.name,
+                                                 load.path);
+                } catch (const std::exception &e) {
+                    load.error = e.what();
+                } catch (...) {
+                    load.error = "Unknown error.";
+                }
+                load.milliseconds = milliseconds(clock::now() - begin).count();
+            });
+        }
+        const auto numThreads = std::min(getPluginLoadThreads(), jobs.size());
+        if (numThreads > 1) {
+            runOnHostThreadWorkers(jobs, numThreads,
+                                   [&] { m_impl->lockHost(); },
+                                   [&] { m_impl->unlockHost(); });
+        } else {
+            for (auto const &job : jobs) {
+                job();
+            }
+        }
+
+        // Register them in search path order, no matter which finished first.
+        // (With the host locked, as background hardware detection may be
+        // walking the plugins.)
+        std::size_t failures = 0;
+        m_impl->lockHost();
+        for (auto &load : loads) {
+            if (!load.reg) {
+                ++failures;
+                m_logger->warn() << "Failed to load plugin " << load.name
+                                 << ": " << load.error;
+                continue;
             }
+            adoptPluginRegistrationContext(load.reg);
+            m_logger->debug() << "Successfully loaded plugin: " << load.name
+                              << " (" << load.milliseconds << " ms)";
+        }
+        m_impl->unlockHost();
+        if (!manifest.save()) {
+            m_logger->debug() << "Could not write the plugin manifest.";
         }
+
+        m_logger->info()
+            << "Loaded " << (loads.size() - failures) << " plugins ("
+            << failures << " failed) in "
+            << milliseconds(clock::now() - start).count() << " ms on "
+            << std::max(numThreads, std::size_t(1))
+            << " thread(s); finding them took "
+            << milliseconds(listed - start).count() << " ms ("
+            << (manifest.getDirectoriesCached() - cachedBefore)
+            << " directories from the manifest, "
+            << (manifest.getDirectoriesScanned() - scannedBefore)
+            << " scanned).";
     }
 
     void RegistrationContext::adoptPluginRegistrationContext(PluginRegPtr ctx) {
@@ -221,6 +424,25 @@ namespace pluginhost {
         }
     }
 
+    void RegistrationContext::requestHardwareDetect() {
+        m_impl->detectExecutor.request();
+    }
+
+    void RegistrationContext::setHostLock(std::function<void()> const &lock,
+                                          std::function<void()> const &unlock) {
+        m_impl->hostLock = lock;
+        m_impl->hostUnlock = unlock;
+        m_impl->detectExecutor.setHostLock(lock, unlock);
+    }
+
+    void RegistrationContext::waitForHardwareDetect() {
+        m_impl->detectExecutor.waitForIdle();
+    }
+
+    void RegistrationContext::shutdownHardwareDetect() {
+        m_impl->detectExecutor.shutdown();
+    }
+
     void
     RegistrationContext::instantiateDriver(const std::string &pluginName,
                                            const std::string &driverName,
@@ -31,18 +31,46 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/PointerWrapper.h>
 #include "HandleNullContext.h"
+#include "UseSendGuard.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstring>
 
 struct OSVR_AnalogDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::AnalogServerInterface> analog;
 };
 
+/// @brief A single-channel report, as captured for the device token.
+struct AnalogChannelReport {
+    OSVR_AnalogState val;
+    OSVR_ChannelCount chan;
+};
+
+static void sendAnalogValue(void *target, OSVR_TimeValue const &timestamp,
+                            const char *report, size_t) {
+    runReportSender([&] {
+        AnalogChannelReport r;
+        std::memcpy(&r, report, sizeof(r));
+        static_cast<OSVR_AnalogDeviceInterface>(target)->analog->setValue(
+            r.val, r.chan, timestamp);
+    });
+}
+
+static void sendAnalogValues(void *target, OSVR_TimeValue const &timestamp,
+                             const char *report, size_t len) {
+    runReportSender([&] {
+        auto vals = reinterpret_cast<OSVR_AnalogState *>(
+            const_cast<char *>(report));
+        static_cast<OSVR_AnalogDeviceInterface>(target)->analog->setValues(
+            vals, static_cast<OSVR_ChannelCount>(len / sizeof(*vals)),
+            timestamp);
+    });
+}
+
 OSVR_ReturnCode
 osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                           OSVR_OUT_PTR OSVR_AnalogDeviceInterface *iface,
@@ -75,6 +103,11 @@ OSVR_ReturnCode osvrDeviceAnalogSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValueTimestamped",
                                     timestamp);
 
+    if (iface->hasSendQueue()) {
+        AnalogChannelReport report = {val, chan};
+        return sendReportViaToken(iface, &sendAnalogValue, chan, *timestamp,
+                                  &report, sizeof(report));
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         bool sendResult = iface->analog->setValue(val, chan, *timestamp);
@@ -103,10 +136,8 @@ OSVR_ReturnCode osvrDeviceAnalogSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValuesTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->analog->setValues(val, chans, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-    return OSVR_RETURN_FAILURE;
+    // Each report covers channels [0, chans), so one supersedes another
+    // with the same channel count.
+    return sendReportViaToken(iface, &sendAnalogValues, chans, *timestamp, val,
+                              chans * sizeof(*val));
 }
@@ -30,18 +30,46 @@
 #include <osvr/Connection/DeviceInterfaceBase.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
+#include "UseSendGuard.h"
 #include <osvr/Util/PointerWrapper.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstring>
 
 struct OSVR_ButtonDeviceInterfaceObject : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::ButtonServerInterface> button;
 };
 
+/// @brief A single-channel report, as captured for the device token.
+struct ButtonChannelReport {
+    OSVR_ButtonState val;
+    OSVR_ChannelCount chan;
+};
+
+static void sendButtonValue(void *target, OSVR_TimeValue const &timestamp,
+                            const char *report, size_t) {
+    runReportSender([&] {
+        ButtonChannelReport r;
+        std::memcpy(&r, report, sizeof(r));
+        static_cast<OSVR_ButtonDeviceInterface>(target)->button->setValue(
+            r.val, r.chan, timestamp);
+    });
+}
+
+static void sendButtonValues(void *target, OSVR_TimeValue const &timestamp,
+                             const char *report, size_t len) {
+    runReportSender([&] {
+        auto vals = reinterpret_cast<OSVR_ButtonState *>(
+            const_cast<char *>(report));
+        static_cast<OSVR_ButtonDeviceInterface>(target)->button->setValues(
+            vals, static_cast<OSVR_ChannelCount>(len / sizeof(*vals)),
+            timestamp);
+    });
+}
+
 OSVR_ReturnCode
 osvrDeviceButtonConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                           OSVR_OUT_PTR OSVR_ButtonDeviceInterface *iface,
@@ -74,6 +102,11 @@ OSVR_ReturnCode osvrDeviceButtonSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValueTimestamped",
                                     timestamp);
 
+    if (iface->hasSendQueue()) {
+        ButtonChannelReport report = {val, chan};
+        return sendReportViaToken(iface, &sendButtonValue, chan, *timestamp,
+                                  &report, sizeof(report));
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         bool sendResult = iface->button->setValue(val, chan, *timestamp);
@@ -102,10 +135,8 @@ OSVR_ReturnCode osvrDeviceButtonSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValuesTimestamped",
                                     timestamp);
 
-    auto guard = iface->getSendGuard();
-    if (guard->lock()) {
-        iface->button->setValues(val, chans, *timestamp);
-        return OSVR_RETURN_SUCCESS;
-    }
-    return OSVR_RETURN_FAILURE;
+    // Each report covers channels [0, chans), so one supersedes another
+    // with the same channel count.
+    return sendReportViaToken(iface, &sendButtonValues, chans, *timestamp, val,
+                              chans * sizeof(*val));
 }
@@ -28,6 +28,7 @@
 #include <osvr/PluginKit/DeviceInterfaceC.h>
 #include <osvr/PluginKit/PluginRegistration.h>
 #include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/PluginHost/HostThreadSection.h>
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Connection/MessageType.h>
 #include <osvr/Connection/Connection.h>
@@ -81,6 +82,7 @@ OSVR_ReturnCode osvrDeviceSendJsonDescriptor(OSVR_IN_PTR OSVR_DeviceToken dev,
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceSendJsonDescriptor descriptor",
                                     json);
 
+    osvr::pluginhost::HostThreadSection section;
     dev->setDeviceDescriptor(std::string(json, len));
     return OSVR_RETURN_SUCCESS;
 }
@@ -94,6 +96,7 @@ osvrDeviceRegisterMessageType(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                      << name);
 
     // Extract the connection from the overall context
+    osvr::pluginhost::HostThreadSection section;
     osvr::connection::ConnectionPtr conn =
         osvr::connection::Connection::retrieveConnection(
             osvr::pluginhost::PluginSpecificRegistrationContext::get(ctx)
@@ -118,7 +121,9 @@ template <typename FactoryFunction>
 inline static OSVR_ReturnCode
 osvrDeviceGenericInit(OSVR_DeviceInitOptions options, OSVR_DeviceToken *device,
                       FactoryFunction f) {
-
+    // Device creation touches the connection, so if this is hardware
+    // detection on a worker thread, hold off the server loop meanwhile.
+    osvr::pluginhost::HostThreadSection section;
     osvr::connection::DeviceTokenPtr dev = f(*options);
     if (!dev) {
         OSVR_DEV_VERBOSE("Device token factory returned a null "
@@ -186,6 +191,9 @@ osvrDeviceRegisterUpdateCallback(OSVR_IN_PTR OSVR_DeviceToken dev,
     OSVR_DEV_VERBOSE("In osvrDeviceRegisterUpdateCallback");
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(
         "osvrDeviceRegisterUpdateCallback device token", dev);
+    // The device is already on the connection, where the server loop reads
+    // the callback, so this may not race with it from a detection worker.
+    osvr::pluginhost::HostThreadSection section;
     dev->setUpdateCallback(
         [updateCallback, userData] { return updateCallback(userData); });
     return OSVR_RETURN_SUCCESS;
@@ -210,6 +218,31 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceAsyncSetSendQueue(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                            OSVR_IN size_t capacity,
+                            OSVR_IN OSVR_AsyncSendOverflowPolicy policy) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAsyncSetSendQueue", options);
+    using osvr::connection::AsyncSendOverflowPolicy;
+    osvr::connection::AsyncSendQueueConfig config;
+    config.capacity = capacity;
+    switch (policy) {
+    case OSVR_ASYNC_SEND_DROP_OLDEST:
+        config.policy = AsyncSendOverflowPolicy::DropOldest;
+        break;
+    case OSVR_ASYNC_SEND_DROP_NEWEST:
+        config.policy = AsyncSendOverflowPolicy::DropNewest;
+        break;
+    case OSVR_ASYNC_SEND_COALESCE:
+        config.policy = AsyncSendOverflowPolicy::Coalesce;
+        break;
+    default:
+        return OSVR_RETURN_FAILURE;
+    }
+    options->setAsyncSendQueue(config);
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
@@ -31,13 +31,15 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Common/ImagingComponent.h>
 #include "HandleNullContext.h"
+#include "UseSendGuard.h"
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstring>
+#include <vector>
 
 // @todo This is a hack. expect this to be moved to a separate osvrJniBridge
 // library and encapsulated behind a proper API.
@@ -45,8 +47,30 @@
 struct OSVR_ImagingDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
     osvr::common::ImagingComponent *imaging;
+    /// @brief Device thread only: where a frame is assembled for the send
+    /// queue.
+    std::vector<char> queuedFrame;
+};
+
+/// @brief Leads the image data of a frame captured for the send queue.
+struct QueuedFrameHeader {
+    OSVR_ImagingMetadata metadata;
+    OSVR_ChannelCount sensor;
 };
 
+static void sendQueuedFrame(void *target, OSVR_TimeValue const &timestamp,
+                            const char *report, size_t) {
+    runReportSender([&] {
+        QueuedFrameHeader header;
+        std::memcpy(&header, report, sizeof(header));
+        auto imageData = reinterpret_cast<OSVR_ImageBufferElement *>(
+            const_cast<char *>(report) + sizeof(header));
+        static_cast<OSVR_ImagingDeviceInterface>(target)
+            ->imaging->sendImageData(header.metadata, imageData, header.sensor,
+                                     timestamp);
+    });
+}
+
 OSVR_ReturnCode
 osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                            OSVR_OUT_PTR OSVR_ImagingDeviceInterface *iface,
@@ -64,6 +88,42 @@ osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrDeviceImagingSetWireOptions(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_CBool chunking,
+    OSVR_IN OSVR_ImagingWireCompression compression,
+    OSVR_IN uint32_t maxBytesPerSecond) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingSetWireOptions", iface);
+    using osvr::common::ImageWireCompression;
+    ImageWireCompression wireCompression;
+    switch (compression) {
+    case OSVR_IMAGING_WIRE_COMPRESSION_NONE:
+        wireCompression = ImageWireCompression::None;
+        break;
+    case OSVR_IMAGING_WIRE_COMPRESSION_RUN_LENGTH:
+        wireCompression = ImageWireCompression::RunLength;
+        break;
+    default:
+        OSVR_DEV_VERBOSE("osvrDeviceImagingSetWireOptions: unrecognized "
+                         "compression "
+                         << int(compression));
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->imaging->setWireChunkingEnabled(chunking != OSVR_FALSE);
+    iface->imaging->setWireCompression(wireCompression);
+    iface->imaging->setWireMaxBytesPerSecond(maxBytesPerSecond);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingSetSharedMemoryLockFree(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_CBool lockFree) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingSetSharedMemoryLockFree",
+                                    iface);
+    iface->imaging->setSharedMemoryLockFree(lockFree != OSVR_FALSE);
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode
 osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
@@ -71,6 +131,19 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
                              OSVR_IN_PTR OSVR_ImageBufferElement *imageData,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    if (iface->hasSendQueue()) {
+        // The image data must be copied anyway, so queue it along with the
+        // rest of the frame rather than waiting for the server thread.
+        QueuedFrameHeader header = {metadata, sensor};
+        auto bytes = size_t(metadata.height) * metadata.width *
+                     metadata.channels * metadata.depth;
+        auto &frame = iface->queuedFrame;
+        frame.resize(sizeof(header) + bytes);
+        std::memcpy(frame.data(), &header, sizeof(header));
+        std::memcpy(frame.data() + sizeof(header), imageData, bytes);
+        return sendReportViaToken(iface, &sendQueuedFrame, sensor, *timestamp,
+                                  frame.data(), frame.size());
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         iface->imaging->sendImageData(metadata, imageData, sensor, *timestamp);
@@ -79,3 +152,36 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
 
     return OSVR_RETURN_FAILURE;
 }
+
+OSVR_ReturnCode
+osvrDeviceImagingAcquireFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                              OSVR_IN OSVR_ImagingMetadata metadata,
+                              OSVR_IN OSVR_ChannelCount sensor,
+                              OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrame", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrame", buffer);
+    // No send guard needed: this only touches the shared memory, not the
+    // connection.
+    *buffer = iface->imaging->acquireImageBuffer(metadata, sensor);
+    if (nullptr == *buffer) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCommitFrame", iface);
+    auto guard = iface->getSendGuard();
+    if (guard->lock()) {
+        if (iface->imaging->commitImageBuffer(sensor, *timestamp)) {
+            return OSVR_RETURN_SUCCESS;
+        }
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
@@ -26,6 +26,8 @@
 // Internal Includes
 #include <osvr/PluginKit/PluginRegistrationC.h>
 #include "HandleNullContext.h"
+#include <osvr/Common/ThreadScheduling.h>
+#include <osvr/PluginHost/HostThreadSection.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 
@@ -76,6 +78,7 @@ OSVR_ReturnCode osvrPluginRegisterDataWithDeleteCallback(
                                     ctx);
     osvr::pluginhost::PluginSpecificRegistrationContext *context =
         static_cast<osvr::pluginhost::PluginSpecificRegistrationContext *>(ctx);
+    osvr::pluginhost::HostThreadSection section;
     context->registerDataWithDeleteCallback(deleteCallback, pluginData);
     return OSVR_RETURN_SUCCESS;
 }
@@ -94,3 +97,9 @@ void osvrPluginLog(OSVR_INOUT_PTR OSVR_PluginRegContext ctx,
     context->log(s, message);
 }
 
+OSVR_ReturnCode osvrPluginApplyTrackerThreadScheduling() {
+    return osvr::common::applyThreadScheduling(
+               osvr::common::ThreadRole::Tracker)
+               ? OSVR_RETURN_SUCCESS
+               : OSVR_RETURN_FAILURE;
+}
@@ -37,7 +37,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstring>
 
 struct OSVR_TrackerDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
@@ -57,15 +57,82 @@ osvrDeviceTrackerConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+/// @brief A single tracker report, as captured for the device token.
+template <typename StateType> struct TrackerReport {
+    StateType val;
+    OSVR_ChannelCount sensor;
+};
+
+template <typename StateType>
+static inline TrackerReport<StateType> readTrackerReport(const char *report) {
+    TrackerReport<StateType> ret;
+    std::memcpy(&ret, report, sizeof(ret));
+    return ret;
+}
+
+template <typename StateType>
+static void sendTrackerReport(void *target, OSVR_TimeValue const &timestamp,
+                              const char *report, size_t) {
+    runReportSender([&] {
+        auto r = readTrackerReport<StateType>(report);
+        static_cast<OSVR_TrackerDeviceInterface>(target)->tracker->sendReport(
+            r.val, r.sensor, timestamp);
+    });
+}
+
+template <typename StateType>
+static void sendTrackerVelReport(void *target, OSVR_TimeValue const &timestamp,
+                                 const char *report, size_t) {
+    runReportSender([&] {
+        auto r = readTrackerReport<StateType>(report);
+        static_cast<OSVR_TrackerDeviceInterface>(target)
+            ->tracker->sendVelReport(r.val, r.sensor, timestamp);
+    });
+}
+
+template <typename StateType>
+static void sendTrackerAccelReport(void *target,
+                                   OSVR_TimeValue const &timestamp,
+                                   const char *report, size_t) {
+    runReportSender([&] {
+        auto r = readTrackerReport<StateType>(report);
+        static_cast<OSVR_TrackerDeviceInterface>(target)
+            ->tracker->sendAccelReport(r.val, r.sensor, timestamp);
+    });
+}
+
+static void sendTrackerPoseBatch(void *target, OSVR_TimeValue const &,
+                                 const char *report, size_t len) {
+    runReportSender([&] {
+        static_cast<OSVR_TrackerDeviceInterface>(target)
+            ->tracker->sendPoseBatch(
+                reinterpret_cast<OSVR_TrackerPoseBatchEntry const *>(report),
+                static_cast<OSVR_ChannelCount>(
+                    len / sizeof(OSVR_TrackerPoseBatchEntry)));
+    });
+}
+
+template <typename StateType>
+static inline OSVR_ReturnCode
+osvrTrackerSendVia(const char method[], OSVR_TrackerDeviceInterface iface,
+                   osvr::connection::QueuedReportSender sender,
+                   StateType const *val, OSVR_ChannelCount sensor,
+                   OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, val);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
+    TrackerReport<StateType> report = {*val, sensor};
+    return sendReportViaToken(iface, sender, sensor, *timestamp, &report,
+                              sizeof(report));
+}
+
 template <typename StateType>
 static inline OSVR_ReturnCode
 osvrTrackerSend(const char method[], OSVR_DeviceToken,
                 OSVR_TrackerDeviceInterface iface, StateType const *val,
                 OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(
-        iface, [&]() { iface->tracker->sendReport(*val, sensor, *timestamp); });
+    return osvrTrackerSendVia(method, iface, &sendTrackerReport<StateType>,
+                              val, sensor, timestamp);
 }
 
 template <typename StateType>
@@ -73,11 +140,8 @@ static inline OSVR_ReturnCode
 osvrTrackerSendVel(const char method[], OSVR_DeviceToken,
                    OSVR_TrackerDeviceInterface iface, StateType const *val,
                    OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendVelReport(*val, sensor, *timestamp);
-    });
+    return osvrTrackerSendVia(method, iface, &sendTrackerVelReport<StateType>,
+                              val, sensor, timestamp);
 }
 
 template <typename StateType>
@@ -86,12 +150,9 @@ osvrTrackerSendAccel(const char method[], OSVR_DeviceToken,
                      OSVR_TrackerDeviceInterface iface, StateType const *val,
                      OSVR_ChannelCount sensor,
                      OSVR_TimeValue const *timestamp) {
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
-    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendAccelReport(*val, sensor, *timestamp);
-    });
+    return osvrTrackerSendVia(method, iface,
+                              &sendTrackerAccelReport<StateType>, val, sensor,
+                              timestamp);
 }
 
 OSVR_ReturnCode
@@ -114,6 +175,25 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
                            val, sensor, timestamp);
 }
 
+OSVR_ReturnCode osvrDeviceTrackerSendPoseBatch(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_TrackerPoseBatchEntry const *entries,
+    OSVR_IN OSVR_ChannelCount count) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPoseBatch", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPoseBatch", entries);
+    if (count == 0) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    // Entries may cover any set of sensors, so batches are never coalesced.
+    // Their timestamps travel inside the entries.
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    return sendReportViaToken(iface, &sendTrackerPoseBatch,
+                              osvr::connection::NO_COALESCE_KEY, now, entries,
+                              count * sizeof(OSVR_TrackerPoseBatchEntry));
+}
+
 OSVR_ReturnCode
 osvrDeviceTrackerSendPosition(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
@@ -26,6 +26,9 @@
 #define INCLUDED_UseSendGuard_h_GUID_FEAB5647_E86B_4BA2_0A29_CB5665678CCB
 
 // Internal Includes
+#include <osvr/Connection/AsyncSendQueueTypes.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/TimeValueC.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -62,4 +65,41 @@ inline OSVR_ReturnCode useSendGuardVoid(InterfaceType &iface, F &&func) {
         return OSVR_RETURN_SUCCESS;
     });
 }
+
+/// Sends a report through the device token (see
+/// OSVR_DeviceTokenObject::sendReport()): queued, for an async device in
+/// queued mode, otherwise sent right away using the send guard. Returns
+/// success if that completes without exception.
+template <typename InterfaceType>
+inline OSVR_ReturnCode
+sendReportViaToken(InterfaceType &iface,
+                   osvr::connection::QueuedReportSender sender, uint32_t key,
+                   OSVR_TimeValue const &timestamp, void const *report,
+                   size_t len) {
+    try {
+        return iface->sendReport(sender, iface, key, timestamp,
+                                 static_cast<const char *>(report), len)
+                   ? OSVR_RETURN_SUCCESS
+                   : OSVR_RETURN_FAILURE;
+    } catch (std::exception const &e) {
+        OSVR_DEV_VERBOSE("Caught exception: " << e.what());
+    } catch (...) {
+        OSVR_DEV_VERBOSE("Caught non-standard exception!");
+    }
+    return OSVR_RETURN_FAILURE;
+}
+
+/// Runs the body of a QueuedReportSender, which may be called from the
+/// server thread with nobody to report failure to, so exceptions are only
+/// logged.
+template <typename F> inline void runReportSender(F &&func) {
+    try {
+        func();
+    } catch (std::exception const &e) {
+        OSVR_DEV_VERBOSE("Caught exception sending report: " << e.what());
+    } catch (...) {
+        OSVR_DEV_VERBOSE("Caught non-standard exception sending report!");
+    }
+}
+
 #endif // INCLUDED_UseSendGuard_h_GUID_FEAB5647_E86B_4BA2_0A29_CB5665678CCB
@@ -26,6 +26,8 @@
 #include <osvr/Server/ConfigureServer.h>
 #include <osvr/Server/Server.h>
 #include <osvr/Connection/Connection.h>
+#include <osvr/Common/LowLatency.h>
+#include <osvr/Common/ThreadScheduling.h>
 #include <osvr/PluginHost/SearchPath.h>
 #include <osvr/Util/Verbosity.h>
 #include "JSONResolvePossibleRef.h"
@@ -104,6 +106,69 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char EVENT_DRIVEN_KEY[] = "eventDriven";
+    static const char REALTIME_KEY[] = "realtime";
+    static const char LOCK_MEMORY_KEY[] = "lockMemory";
+    static const char MAIN_LOOP_KEY[] = "mainLoop";
+    static const char ASYNC_DEVICES_KEY[] = "asyncDevices";
+    static const char TRACKERS_KEY[] = "trackers";
+
+    /// @brief Parses an object like `{"policy": "fifo", "priority": 50,
+    /// "cpus": [2, 3]}`, all members optional.
+    static common::ThreadSchedulingConfig
+    parseThreadScheduling(Json::Value const &json, const char *name) {
+        common::ThreadSchedulingConfig ret;
+        if (json.isNull()) {
+            return ret;
+        }
+        if (!json.isObject()) {
+            throw std::runtime_error(std::string("Invalid ") + name +
+                                     " thread scheduling: must be an object");
+        }
+        Json::Value const &policy = json["policy"];
+        if (!policy.isNull() &&
+            !(policy.isString() &&
+              common::parseSchedulingPolicy(policy.asString(), ret.policy))) {
+            throw std::runtime_error(std::string("Invalid ") + name +
+                                     " scheduling policy: must be one of "
+                                     "\"default\", \"fifo\", or \"rr\"");
+        }
+        Json::Value const &priority = json["priority"];
+        if (priority.isInt()) {
+            ret.priority = priority.asInt();
+        }
+        for (auto const &cpu : json["cpus"]) {
+            if (!cpu.isInt() || cpu.asInt() < 0) {
+                throw std::runtime_error(std::string("Invalid ") + name +
+                                         " CPU list: must contain only "
+                                         "non-negative integers");
+            }
+            ret.cpus.push_back(cpu.asInt());
+        }
+        return ret;
+    }
+
+    /// @brief Parses the optional real-time section of the server config,
+    /// which must be applied before any of the threads it configures start.
+    static void parseRealtimeConfig(Json::Value const &jsonRealtime) {
+        if (jsonRealtime.isNull()) {
+            return;
+        }
+        Json::Value const &jsonLockMemory = jsonRealtime[LOCK_MEMORY_KEY];
+        if (jsonLockMemory.isBool()) {
+            common::setLowLatencyMemoryLocking(jsonLockMemory.asBool());
+        }
+        common::setThreadSchedulingConfig(
+            common::ThreadRole::ServerMainLoop,
+            parseThreadScheduling(jsonRealtime[MAIN_LOOP_KEY], "main loop"));
+        common::setThreadSchedulingConfig(
+            common::ThreadRole::AsyncDevice,
+            parseThreadScheduling(jsonRealtime[ASYNC_DEVICES_KEY],
+                                  "async device"));
+        common::setThreadSchedulingConfig(
+            common::ThreadRole::Tracker,
+            parseThreadScheduling(jsonRealtime[TRACKERS_KEY], "tracker"));
+    }
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -115,6 +180,7 @@ namespace server {
 #else
         int sleepTime = 1000; // microseconds
 #endif
+        bool eventDriven = false;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -146,6 +212,13 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            Json::Value jsonEventDriven = jsonServer[EVENT_DRIVEN_KEY];
+            if (jsonEventDriven.isBool()) {
+                eventDriven = jsonEventDriven.asBool();
+            }
+
+            parseRealtimeConfig(jsonServer[REALTIME_KEY]);
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -166,6 +239,10 @@ namespace server {
             m_server->setSleepTime(sleepTime);
         }
 
+        if (eventDriven) {
+            m_server->setEventDriven(true);
+        }
+
         m_server->setHardwareDetectOnConnection();
 
         return m_server;
@@ -35,6 +35,7 @@
 // - none
 
 // Standard includes
+#include <chrono>
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -48,6 +49,19 @@ namespace server {
         auto log =
             ::osvr::util::log::make_logger(::osvr::util::log::OSVR_SERVER_LOG);
 
+        // Time spent in each startup phase, for the breakdown logged at the
+        // end.
+        typedef std::chrono::steady_clock clock;
+        typedef std::chrono::duration<double, std::milli> milliseconds;
+        const auto start = clock::now();
+        auto lapStart = start;
+        auto lap = [&] {
+            auto now = clock::now();
+            auto elapsed = milliseconds(now - lapStart).count();
+            lapStart = now;
+            return elapsed;
+        };
+
         ServerPtr ret;
         osvr::server::ConfigureServer srvConfig;
         log->info() << "Constructing server as configured...";
@@ -61,11 +75,13 @@ namespace server {
                 << e.what();
             return nullptr;
         }
+        const auto constructMs = lap();
 
         {
             log->info() << "Loading auto-loadable plugins...";
             srvConfig.loadAutoPlugins();
         }
+        const auto autoPluginsMs = lap();
 
         {
             log->info() << "Loading plugins...";
@@ -84,6 +100,7 @@ namespace server {
                 }
             }
         }
+        const auto pluginsMs = lap();
 
         {
             log->info() << "Instantiating configured drivers...";
@@ -103,6 +120,7 @@ namespace server {
                 }
             }
         }
+        const auto driversMs = lap();
 
         if (srvConfig.processExternalDevices()) {
             log->info()
@@ -131,7 +149,18 @@ namespace server {
             log->info() << "RenderManager config found and parsed from the "
                            "config file.";
         }
-
+        const auto configMs = lap();
+
+        log->info() << "Server configured in "
+                    << milliseconds(clock::now() - start).count()
+                    << " ms: construction " << constructMs
+                    << " ms, auto-loaded plugins " << autoPluginsMs
+                    << " ms, configured plugins " << pluginsMs
+                    << " ms, drivers " << driversMs
+                    << " ms, remaining config " << configMs << " ms.";
+
+        // Detection only gets queued here and runs in the background, so it
+        // has no place in the breakdown above.
         log->info() << "Triggering automatic hardware detection...";
         ret->triggerHardwareDetect();
 
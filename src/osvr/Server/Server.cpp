@@ -70,7 +70,11 @@ namespace server {
         return ret;
     }
 
-    void Server::update() { m_impl->update(); }
+    void Server::update() { m_impl->update(MainloopMethod()); }
+
+    void Server::update(MainloopMethod const &andThen) {
+        m_impl->update(andThen);
+    }
 
     void Server::start() { m_impl->start(); }
 
@@ -100,6 +104,8 @@ namespace server {
 
     void Server::triggerHardwareDetect() { m_impl->triggerHardwareDetect(); }
 
+    void Server::waitForHardwareDetect() { m_impl->waitForHardwareDetect(); }
+
     void Server::registerMainloopMethod(MainloopMethod f) {
         m_impl->registerMainloopMethod(f);
     }
@@ -136,6 +142,12 @@ namespace server {
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
 
+    void Server::setEventDriven(bool eventDriven) {
+        m_impl->setEventDriven(eventDriven);
+    }
+
+    void Server::signalWakeup() { m_impl->signalWakeup(); }
+
     Server::Server(connection::ConnectionPtr const &conn,
                    boost::optional<std::string> const &host,
                    boost::optional<int> const &port,
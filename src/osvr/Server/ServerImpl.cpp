@@ -28,8 +28,10 @@
 #include <osvr/Common/AliasProcessor.h>
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathTreeSerialization.h>
 #include <osvr/Common/ProcessDeviceDescriptor.h>
 #include <osvr/Common/SystemComponent.h>
+#include <osvr/Common/ThreadScheduling.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/Connection/ConnectionDevice.h>
@@ -70,6 +72,7 @@ namespace server {
                            boost::optional<std::string> const &host,
                            boost::optional<int> const &port)
         : m_conn(conn), m_ctx(make_shared<pluginhost::RegistrationContext>()),
+          m_wakeup(make_shared<WakeupEvent>()),
           m_host(host.get_value_or("localhost")),
           m_port(port.get_value_or(util::UseDefaultPort)),
           m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {
@@ -78,6 +81,14 @@ namespace server {
                 "Can't pass a null ConnectionPtr into Server constructor!");
         }
         osvr::connection::Connection::storeConnection(*m_ctx, m_conn);
+        // Hardware detection runs on worker threads, which create devices
+        // while holding the mutex the main loop runs under, then wake the
+        // loop to act on them (for instance, to send the updated path tree).
+        m_ctx->setHostLock([&] { m_mainThreadMutex.lock(); },
+                           [&] {
+                               m_mainThreadMutex.unlock();
+                               m_wakeup->signal();
+                           });
 
         // Get the underlying VRPN connection, and make sure it's OK.
         auto vrpnConn = getVRPNConnection(m_conn);
@@ -94,6 +105,8 @@ namespace server {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
+        m_systemComponent->registerTreeDeltaSupportHandler(
+            [&](uint32_t query) { m_handleTreeDeltaSupport(query); });
 
         // Things to do when we get a new incoming connection
         // No longer doing hardware detect unconditionally here - see
@@ -118,6 +131,15 @@ namespace server {
         vrpnConn->register_handler(
             vrpnConn->register_message_type(vrpn_dropped_last_connection),
             &ServerImpl::m_enterIdle, this);
+
+        // Track how many clients there are, so we know whether they've all
+        // said they can take tree deltas.
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleGotConnection, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_dropped_connection),
+            &ServerImpl::m_handleDroppedConnection, this);
     }
 
     ServerImpl::~ServerImpl() {
@@ -140,6 +162,7 @@ namespace server {
         m_thread = boost::thread([&] {
             bool keepRunning = true;
             m_mainThreadId = m_thread.get_id();
+            common::applyThreadScheduling(common::ThreadRole::ServerMainLoop);
             ::util::LoopGuard guard(m_run);
             do {
                 keepRunning = this->m_loop();
@@ -196,19 +219,40 @@ namespace server {
         m_callControlled([&] { m_triggeredDetect = true; });
     }
 
+    void ServerImpl::waitForHardwareDetect() {
+        // Hand over a trigger the loop hasn't picked up yet, so there's
+        // something to wait for.
+        m_callControlled([&] {
+            if (m_triggeredDetect) {
+                m_ctx->requestHardwareDetect();
+                m_triggeredDetect = false;
+            }
+        });
+        m_ctx->waitForHardwareDetect();
+    }
+
     void ServerImpl::registerMainloopMethod(MainloopMethod f) {
         if (f) {
             m_callControlled([&] { m_mainloopMethods.push_back(f); });
         }
     }
 
-    void ServerImpl::update() {
+    void ServerImpl::update(MainloopMethod const &andThen) {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_everStarted) {
             throw std::logic_error("Can't call update() if you've ever started "
                                    "the server in its own thread!");
         }
+        // Serializes with device creation by hardware detection workers.
+        // Devices found by a detection pass this requests are picked up by
+        // later calls, rather than waiting for the pass here.
+        boost::unique_lock<boost::mutex> mainLock(m_mainThreadMutex);
         m_update();
+        // Let andThen call back into the server without deadlocking.
+        lock.unlock();
+        if (andThen) {
+            andThen();
+        }
     }
     void ServerImpl::m_update() {
         osvr::common::tracing::ServerUpdate trace;
@@ -218,9 +262,10 @@ namespace server {
             f();
         }
         if (m_triggeredDetect) {
-            m_log->info() << "Performing hardware auto-detection.";
+            // Runs off-thread, so it doesn't stall report forwarding.
+            m_log->debug() << "Requesting hardware auto-detection.";
             common::tracing::markHardwareDetect();
-            m_ctx->triggerHardwareDetect();
+            m_ctx->requestHardwareDetect();
             m_triggeredDetect = false;
         }
         if (m_treeDirty) {
@@ -240,10 +285,20 @@ namespace server {
             shouldContinue = m_run.shouldContinue();
         }
 
-        if (m_currentSleepTime > 0) {
+        m_waitForWork();
+        return shouldContinue;
+    }
+
+    void ServerImpl::m_waitForWork() {
+        if (m_eventDriven) {
+            // With a client connected, the sleep time still bounds how long
+            // network traffic and sync devices wait to be serviced, but
+            // anything signaling the wakeup event is serviced right away.
+            m_wakeup->wait(m_lowLatency ? m_currentSleepTime
+                                        : EVENT_IDLE_WAIT_TIME);
+        } else if (m_currentSleepTime > 0) {
             osvr::util::time::microsleep(m_currentSleepTime);
         }
-        return shouldContinue;
     }
 
     bool ServerImpl::addRoute(std::string const &routingDirective) {
@@ -315,6 +370,10 @@ namespace server {
     }
 
     void ServerImpl::m_orderedDestruction() {
+        if (m_ctx) {
+            // Its workers use our mutex, so stop them before anything goes.
+            m_ctx->shutdownHardwareDetect();
+        }
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -359,13 +418,71 @@ namespace server {
         return change;
     }
     void ServerImpl::m_queueTreeSend() {
-        m_callControlled([&] { m_treeDirty += true; });
+        m_callControlled([&] {
+            m_treeDirty += true;
+            m_fullTreeRequested = true;
+        });
     }
     void ServerImpl::m_sendTree() {
 
         common::tracing::markPathTreeBroadcast();
-        m_systemComponent->sendReplacementTree(m_tree);
-        m_log->info() << "Sent path tree to clients.";
+        auto nodes = common::pathTreeToJson(m_tree);
+        /// Clients that never answered a delta support query (older ones, or
+        /// ones whose answer is still on the way) only understand full trees.
+        bool allClientsTakeDeltas =
+            m_treeDeltaSupportReplies >= m_connectedClients;
+        if (m_fullTreeRequested || m_lastSentTree.isNull() ||
+            !allClientsTakeDeltas) {
+            /// A client may have just connected: everyone gets the full tree
+            /// (clients diff it against their own), followed by an empty
+            /// delta carrying the version that later deltas build on.
+            m_systemComponent->sendReplacementTree(nodes);
+            ++m_treeVersion;
+            Json::Value marker(Json::objectValue);
+            marker["version"] = m_treeVersion;
+            marker["set"] = Json::Value(Json::arrayValue);
+            marker["remove"] = Json::Value(Json::arrayValue);
+            m_systemComponent->sendTreeDelta(marker);
+            m_fullTreeRequested = false;
+            m_log->info() << "Sent path tree to clients.";
+        } else {
+            auto delta = common::pathTreeDelta(m_lastSentTree, nodes);
+            if (!common::isEmptyPathTreeDelta(delta)) {
+                delta["baseVersion"] = m_treeVersion;
+                ++m_treeVersion;
+                delta["version"] = m_treeVersion;
+                m_systemComponent->sendTreeDelta(delta);
+                m_log->info() << "Sent path tree changes to clients ("
+                              << delta["set"].size() << " set, "
+                              << delta["remove"].size() << " removed).";
+            }
+        }
+        m_lastSentTree = nodes;
+    }
+
+    void ServerImpl::m_queryTreeDeltaSupport() {
+        ++m_treeDeltaSupportQuery;
+        m_treeDeltaSupportReplies = 0;
+        /// VRPN delivers messages to handlers on this connection itself while
+        /// packing them, so in-process client contexts (analysis plugins, joint
+        /// clients) answer before this call returns. Remote answers can only
+        /// arrive later, from the connection's mainloop.
+        m_queryingTreeDeltaSupport = true;
+        m_systemComponent->sendTreeDeltaSupportQuery(m_treeDeltaSupportQuery);
+        m_queryingTreeDeltaSupport = false;
+    }
+
+    void ServerImpl::m_handleTreeDeltaSupport(uint32_t query) {
+        if (m_queryingTreeDeltaSupport) {
+            /// Delivered locally: in-process contexts aren't counted in
+            /// m_connectedClients, so their answers mustn't be either.
+            return;
+        }
+        /// Replies to an older query may come from clients that have since
+        /// disconnected, so they don't count.
+        if (query == m_treeDeltaSupportQuery) {
+            ++m_treeDeltaSupportReplies;
+        }
     }
 
     void ServerImpl::setSleepTime(int microseconds) {
@@ -374,6 +491,23 @@ namespace server {
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
+
+    void ServerImpl::setEventDriven(bool eventDriven) {
+        if (eventDriven && !m_wakeup->isAvailable()) {
+            m_log->warn() << "Event-driven server loop not available on this "
+                             "platform, using a fixed sleep time instead.";
+            eventDriven = false;
+        }
+        m_eventDriven = eventDriven;
+        if (m_eventDriven) {
+            auto wakeup = m_wakeup;
+            m_conn->setWakeupHandler([wakeup] { wakeup->signal(); });
+        } else {
+            m_conn->setWakeupHandler(std::function<void()>());
+        }
+    }
+
+    void ServerImpl::signalWakeup() { m_wakeup->signal(); }
     void ServerImpl::m_handleDeviceDescriptors() {
         for (auto const &dev : m_conn->getDevices()) {
             auto const &descriptor = dev->getDeviceDescriptor();
@@ -402,6 +536,24 @@ namespace server {
         return 0;
     }
 
+    int ServerImpl::m_handleGotConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        ++self->m_connectedClients;
+        self->m_queryTreeDeltaSupport();
+        return 0;
+    }
+
+    int ServerImpl::m_handleDroppedConnection(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        if (self->m_connectedClients > 0) {
+            --self->m_connectedClients;
+        }
+        /// We can't tell which client left, so ask everyone again.
+        self->m_queryTreeDeltaSupport();
+        return 0;
+    }
+
     int ServerImpl::m_enterIdle(void *userdata, vrpn_HANDLERPARAM) {
         auto self = static_cast<ServerImpl *>(userdata);
 
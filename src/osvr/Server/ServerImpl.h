@@ -39,7 +39,9 @@
 #include <osvr/Util/Flag.h>
 #include <osvr/Util/Log.h>
 #include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/StdInt.h>
 #include <osvr/Util/UniquePtr.h>
+#include "WakeupEvent.h"
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -96,6 +98,9 @@ namespace server {
         /// @copydoc Server::triggerHardwareDetect()
         void triggerHardwareDetect();
 
+        /// @copydoc Server::waitForHardwareDetect()
+        void waitForHardwareDetect();
+
         /// @copydoc Server::registerMainloopMethod()
         void registerMainloopMethod(MainloopMethod f);
 
@@ -121,6 +126,12 @@ namespace server {
 
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setEventDriven()
+        void setEventDriven(bool eventDriven);
+
+        /// @copydoc Server::signalWakeup()
+        void signalWakeup();
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -131,7 +142,8 @@ namespace server {
                                std::string const &params);
 
         /// @brief The method to just do the update stuff, not in a thread.
-        void update();
+        /// @copydetails Server::update(MainloopMethod const &)
+        void update(MainloopMethod const &andThen);
 
       private:
         /// @brief The method called from the server thread repeatedly.
@@ -141,6 +153,10 @@ namespace server {
         /// @brief The actual guts of the update
         void m_update();
 
+        /// @brief Sleep (or in event-driven mode, wait for a wakeup signal)
+        /// between loop iterations.
+        void m_waitForWork();
+
         /// @brief Internal function to call a callable if the thread isn't
         /// running, or to queue up the callable if it is running.
         template <typename Callable> void m_callControlled(Callable f);
@@ -155,9 +171,18 @@ namespace server {
         /// @brief Queues up a tree transmission for next time around
         void m_queueTreeSend();
 
-        /// @brief sends full path tree contents
+        /// @brief sends full path tree contents if a client asked for them or
+        /// not every client can apply deltas, otherwise just the nodes changed
+        /// since the last send.
         void m_sendTree();
 
+        /// @brief Asks all connected clients whether they can apply tree
+        /// deltas, forgetting any earlier answers.
+        void m_queryTreeDeltaSupport();
+
+        /// @brief Counts a client's answer to a delta support query.
+        void m_handleTreeDeltaSupport(uint32_t query);
+
         /// @brief handles updated route message from client
         static int VRPN_CALLBACK m_handleUpdatedRoute(void *userdata,
                                                       vrpn_HANDLERPARAM p);
@@ -190,6 +215,13 @@ namespace server {
         /// @brief Callback on dropping last connection, to enter idle state.
         static int VRPN_CALLBACK m_enterIdle(void *userdata, vrpn_HANDLERPARAM);
 
+        /// @brief Callback on any new client connection.
+        static int VRPN_CALLBACK m_handleGotConnection(void *userdata,
+                                                       vrpn_HANDLERPARAM);
+        /// @brief Callback on any dropped client connection.
+        static int VRPN_CALLBACK m_handleDroppedConnection(void *userdata,
+                                                           vrpn_HANDLERPARAM);
+
         /// @brief Connection ownership.
         connection::ConnectionPtr m_conn;
 
@@ -216,6 +248,27 @@ namespace server {
         common::PathTree m_tree;
         util::Flag m_treeDirty;
 
+        /// @name Path tree transmission state
+        /// @{
+        /// @brief Serialized tree as of the last send, to diff against.
+        Json::Value m_lastSentTree;
+        /// @brief Version number of the last tree or delta sent.
+        uint32_t m_treeVersion = 0;
+        /// @brief Whether a client has pinged since the last send, so needs
+        /// the full tree.
+        bool m_fullTreeRequested = true;
+        /// @brief Number of clients currently connected.
+        std::size_t m_connectedClients = 0;
+        /// @brief Number of the latest delta support query sent to clients.
+        uint32_t m_treeDeltaSupportQuery = 0;
+        /// @brief Remote clients that answered the latest query: deltas are
+        /// only sent once this covers every connected client.
+        std::size_t m_treeDeltaSupportReplies = 0;
+        /// @brief Set while sending a query, to recognize (and ignore) answers
+        /// delivered locally from in-process client contexts.
+        bool m_queryingTreeDeltaSupport = false;
+        /// @}
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
@@ -248,6 +301,19 @@ namespace server {
         /// right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
 
+        /// @brief Whether the loop waits on m_wakeup instead of sleeping.
+        bool m_eventDriven = false;
+
+        /// @brief Maximum number of microseconds to wait for a wakeup in
+        /// event-driven mode when no clients are connected: only incoming
+        /// network connections and sync devices need polling then.
+        static const int EVENT_IDLE_WAIT_TIME = 100000;
+
+        /// @brief Signaled by async devices, mainloop methods, and
+        /// m_callControlled requests in event-driven mode. Shared with the
+        /// connection's wakeup handler, which may outlive us.
+        shared_ptr<WakeupEvent> m_wakeup;
+
         /// The host/interface we're listening on, if any.
         std::string m_host;
 
@@ -288,6 +354,10 @@ namespace server {
             boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
             TemporaryThreadIDChanger changer(m_mainThreadId);
             f();
+            if (m_eventDriven) {
+                // Let the loop act promptly on anything f() changed.
+                m_wakeup->signal();
+            }
         } else {
             f();
         }
@@ -0,0 +1,121 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "WakeupEvent.h"
+#include <osvr/Util/Microsleep.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#if defined(OSVR_LINUX)
+#include <cerrno>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace osvr {
+namespace server {
+#if defined(OSVR_LINUX)
+    WakeupEvent::WakeupEvent()
+        : m_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+          m_signaled(false) {}
+
+    WakeupEvent::~WakeupEvent() {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    bool WakeupEvent::isAvailable() const { return m_fd >= 0; }
+
+    void WakeupEvent::signal() {
+        if (m_fd < 0 || m_signaled.exchange(true)) {
+            return;
+        }
+        uint64_t one = 1;
+        // If the counter is somehow saturated, the write fails with EAGAIN -
+        // but then the waiter is already going to wake, so ignore it.
+        auto ret = ::write(m_fd, &one, sizeof(one));
+        (void)ret;
+    }
+
+    bool WakeupEvent::wait(int timeoutMicroseconds) {
+        if (m_fd < 0) {
+            if (timeoutMicroseconds > 0) {
+                util::time::microsleep(timeoutMicroseconds);
+            }
+            return false;
+        }
+        pollfd pfd;
+        pfd.fd = m_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        timespec timeout;
+        timeout.tv_sec = timeoutMicroseconds / 1000000;
+        timeout.tv_nsec = (timeoutMicroseconds % 1000000) * 1000;
+        int ret;
+        do {
+            ret = ::ppoll(&pfd, 1, &timeout, nullptr);
+        } while (ret < 0 && errno == EINTR);
+        if (ret <= 0) {
+            // Nothing should be pending, but don't let a stale flag suppress
+            // future signals.
+            m_signaled.store(false);
+            return false;
+        }
+        // Reading resets the counter, consuming all signals so far.
+        uint64_t count;
+        auto readRet = ::read(m_fd, &count, sizeof(count));
+        (void)readRet;
+        // Only clear the flag once the counter is drained: a signal racing
+        // with us then either saw the flag still set (so its work happened
+        // before we return, and the caller's processing will pick it up) or
+        // writes again, making our next wait return immediately.
+        m_signaled.store(false);
+        return true;
+    }
+#else
+    WakeupEvent::WakeupEvent() : m_fd(-1), m_signaled(false) {}
+
+    WakeupEvent::~WakeupEvent() {}
+
+    bool WakeupEvent::isAvailable() const { return false; }
+
+    void WakeupEvent::signal() {}
+
+    bool WakeupEvent::wait(int timeoutMicroseconds) {
+        if (timeoutMicroseconds > 0) {
+            util::time::microsleep(timeoutMicroseconds);
+        }
+        return false;
+    }
+#endif
+} // namespace server
+} // namespace osvr
@@ -0,0 +1,71 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_WakeupEvent_h_GUID_56D4D031_D91F_4D29_9672_64F004CDEB11
+#define INCLUDED_WakeupEvent_h_GUID_56D4D031_D91F_4D29_9672_64F004CDEB11
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+
+namespace osvr {
+namespace server {
+    /// @brief A signal that other threads can raise to wake the server loop
+    /// out of a timed wait early.
+    ///
+    /// Backed by an eventfd on Linux; elsewhere, isAvailable() returns false
+    /// and wait() simply sleeps for the timeout.
+    class WakeupEvent : boost::noncopyable {
+      public:
+        WakeupEvent();
+        ~WakeupEvent();
+
+        /// @brief Whether waits can actually be interrupted by signal() on
+        /// this platform.
+        bool isAvailable() const;
+
+        /// @brief Wake the waiting thread (or make its next wait return
+        /// immediately). Callable from any thread; never blocks.
+        void signal();
+
+        /// @brief Wait until signaled or the timeout (in microseconds) has
+        /// elapsed, whichever comes first, consuming any pending signals.
+        /// @returns true if woken by a signal.
+        bool wait(int timeoutMicroseconds);
+
+      private:
+        int m_fd;
+        /// @brief Set when a signal is outstanding, so repeated signals
+        /// between waits cost only an atomic exchange rather than a syscall.
+        std::atomic<bool> m_signaled;
+    };
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_WakeupEvent_h_GUID_56D4D031_D91F_4D29_9672_64F004CDEB11
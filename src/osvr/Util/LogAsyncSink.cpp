@@ -0,0 +1,192 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LogAsyncSink.h"
+
+// Library/third-party includes
+#include <spdlog/details/log_msg.h>
+
+// Standard includes
+#include <chrono>
+#include <utility> // for std::move
+
+namespace osvr {
+namespace util {
+    namespace log {
+        /// Backstop for a wakeup missed because producers notify without
+        /// taking the mutex.
+        static const auto MAX_WRITER_SLEEP = std::chrono::milliseconds(50);
+
+        async_sink::async_sink(std::vector<spdlog::sink_ptr> sinks,
+                               std::size_t queue_size)
+            : sinks_(std::move(sinks)), queue_(queue_size),
+              written_unqueued_(0), running_(true), flush_requests_(0) {
+            thread_ = std::thread([&] { run(); });
+        }
+
+        async_sink::~async_sink() { shutdown(); }
+
+        void async_sink::log(const spdlog::details::log_msg &msg) {
+            if (!running_.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(sink_mutex_);
+                write(msg);
+                return;
+            }
+            auto pushed = queue_.tryPush([&](QueuedLogMessage &queued) {
+                queued.level = static_cast<int>(msg.level);
+                queued.time = msg.time;
+                queued.threadId = msg.thread_id;
+                queued.loggerName = msg.logger_name;
+                queued.raw.assign(msg.raw.data(), msg.raw.size());
+                queued.formatted.assign(msg.formatted.data(),
+                                        msg.formatted.size());
+            });
+            if (pushed) {
+                wakeup_.notify_one();
+            } else if (msg.level >= spdlog::level::warn) {
+                // Too important to drop: write it here instead.
+                std::lock_guard<std::mutex> lock(sink_mutex_);
+                write(msg);
+                written_unqueued_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::uint64_t async_sink::dropped() const {
+            return queue_.dropped() -
+                   written_unqueued_.load(std::memory_order_relaxed);
+        }
+
+        void async_sink::flush() {
+            if (!running_.load(std::memory_order_acquire)) {
+                flush_sinks();
+                return;
+            }
+            flush_requests_.fetch_add(1);
+            wakeup_.notify_one();
+        }
+
+        void async_sink::flush_and_wait() {
+            if (!running_.load(std::memory_order_acquire)) {
+                flush_sinks();
+                return;
+            }
+            auto ticket = flush_requests_.fetch_add(1) + 1;
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.notify_one();
+            flushed_.wait_for(lock, std::chrono::seconds(5), [&] {
+                return flushes_done_ >= ticket ||
+                       !running_.load(std::memory_order_acquire);
+            });
+        }
+
+        void async_sink::shutdown() {
+            if (!running_.exchange(false)) {
+                return;
+            }
+            wakeup_.notify_one();
+            if (thread_.joinable()) {
+                thread_.join();
+            }
+            // Catch anything queued while the thread was exiting.
+            drain();
+            flush_sinks();
+        }
+
+        void async_sink::run() {
+            for (;;) {
+                // Load before draining, so a flush requested after a message
+                // was queued is only acknowledged once it's been written.
+                auto requests = flush_requests_.load();
+                auto stopping = !running_.load(std::memory_order_acquire);
+                auto wroteAny = drain();
+                bool flushNeeded;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    flushNeeded = requests != flushes_done_;
+                }
+                if (flushNeeded) {
+                    flush_sinks();
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        flushes_done_ = requests;
+                    }
+                    flushed_.notify_all();
+                }
+                if (stopping) {
+                    break;
+                }
+                if (!wroteAny && !flushNeeded) {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    wakeup_.wait_for(lock, MAX_WRITER_SLEEP);
+                }
+            }
+            flushed_.notify_all();
+        }
+
+        bool async_sink::drain() {
+            std::lock_guard<std::mutex> lock(sink_mutex_);
+            bool wroteAny = false;
+            while (queue_.tryPop([&](QueuedLogMessage &msg) { write(msg); })) {
+                wroteAny = true;
+            }
+            return wroteAny;
+        }
+
+        void async_sink::write(QueuedLogMessage const &queued) {
+            spdlog::details::log_msg msg;
+            msg.logger_name = queued.loggerName;
+            msg.level = static_cast<spdlog::level::level_enum>(queued.level);
+            msg.time = queued.time;
+            msg.thread_id = queued.threadId;
+            msg.raw << queued.raw;
+            msg.formatted << queued.formatted;
+            write(msg);
+        }
+
+        void async_sink::write(const spdlog::details::log_msg &msg) {
+            for (auto &sink : sinks_) {
+                try {
+                    sink->log(msg);
+                } catch (...) {
+                    // Nowhere to report this: carry on with the other sinks.
+                }
+            }
+        }
+
+        void async_sink::flush_sinks() {
+            std::lock_guard<std::mutex> lock(sink_mutex_);
+            for (auto &sink : sinks_) {
+                try {
+                    sink->flush();
+                } catch (...) {
+                    // fail silently
+                }
+            }
+        }
+
+    } // end namespace log
+} // end namespace util
+} // end namespace osvr
@@ -0,0 +1,120 @@
+/** @file
+    @brief Header declaring a sink decorator that writes to its wrapped sinks
+    from a background thread.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LogAsyncSink_h_GUID_BDCADEC9_8456_4959_93F1_3EDB42E52494
+#define INCLUDED_LogAsyncSink_h_GUID_BDCADEC9_8456_4959_93F1_3EDB42E52494
+
+// Internal Includes
+#include "LogMessageQueue.h"
+
+// Library/third-party includes
+#include <spdlog/common.h>
+#include <spdlog/sinks/sink.h>
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace util {
+    namespace log {
+
+        /// A decorator around other sinks that queues each already-formatted
+        /// message in a bounded lock-free queue, for a background thread to
+        /// pass on to the wrapped sinks. Logging threads thus normally never
+        /// wait on console or file I/O (or on each other). If the writer falls
+        /// behind far enough to fill the queue, messages below warning level
+        /// are dropped and counted, while warnings and above are written
+        /// synchronously instead (possibly ahead of older queued messages).
+        ///
+        /// Unlike spdlog's global async mode, this applies per sink, so it
+        /// covers the console as well as the file sink.
+        class async_sink : public ::spdlog::sinks::sink {
+          public:
+            async_sink(std::vector<spdlog::sink_ptr> sinks,
+                       std::size_t queue_size);
+
+            /// Writes out anything still queued, then stops the thread.
+            virtual ~async_sink();
+
+            /// Called from any logging thread: queues the message.
+            void log(const spdlog::details::log_msg &msg) override;
+
+            /// Asks the writer thread to flush the wrapped sinks once it has
+            /// written everything queued so far, without waiting for it.
+            void flush() override;
+
+            /// Waits until everything queued before the call has been written
+            /// and the wrapped sinks flushed.
+            void flush_and_wait();
+
+            /// Writes out anything still queued and stops the writer thread:
+            /// any later messages are written synchronously.
+            void shutdown();
+
+            LogMessageQueue const &queue() const { return queue_; }
+
+            /// Number of messages discarded because the queue was full.
+            std::uint64_t dropped() const;
+
+          private:
+            void run();
+            /// @return true if any messages were written.
+            bool drain();
+            /// Requires sink_mutex_.
+            void write(QueuedLogMessage const &msg);
+            /// Requires sink_mutex_.
+            void write(const spdlog::details::log_msg &msg);
+            void flush_sinks();
+
+            std::vector<spdlog::sink_ptr> sinks_;
+            LogMessageQueue queue_;
+            /// Serializes calls into the wrapped sinks: the writer thread's
+            /// draining, and synchronous writes from logging threads (after
+            /// shutdown, or of warnings that didn't fit in the queue).
+            std::mutex sink_mutex_;
+            /// Messages that didn't fit in the queue but were written anyway.
+            std::atomic<std::uint64_t> written_unqueued_;
+
+            std::mutex mutex_;
+            std::condition_variable wakeup_;
+            std::condition_variable flushed_;
+            std::atomic<bool> running_;
+            std::atomic<std::uint64_t> flush_requests_;
+            /// Protected by mutex_.
+            std::uint64_t flushes_done_ = 0;
+            std::thread thread_;
+        };
+
+    } // end namespace log
+} // end namespace util
+} // end namespace osvr
+
+#endif // INCLUDED_LogAsyncSink_h_GUID_BDCADEC9_8456_4959_93F1_3EDB42E52494
@@ -0,0 +1,192 @@
+/** @file
+    @brief Header containing the bounded lock-free queue used to hand
+    formatted log messages from logging threads to the log writer thread.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LogMessageQueue_h_GUID_8745C13F_9A3E_4887_9190_A5C7C8FFEC35
+#define INCLUDED_LogMessageQueue_h_GUID_8745C13F_9A3E_4887_9190_A5C7C8FFEC35
+
+// Internal Includes
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace util {
+    namespace log {
+        /// @brief A log message as carried across the queue: the fields of
+        /// spdlog's log_msg, with the level stored as its integer value.
+        struct QueuedLogMessage {
+            int level = 0;
+            std::chrono::system_clock::time_point time;
+            std::size_t threadId = 0;
+            std::string loggerName;
+            std::string raw;
+            std::string formatted;
+        };
+
+        /// @brief A bounded, lock-free queue of log messages with any number
+        /// of producers (logging threads) and a single consumer (the writer
+        /// thread).
+        ///
+        /// Each slot carries a sequence number, after Vyukov's bounded
+        /// queue. Messages are assigned into the strings of the slots, which
+        /// keep their capacity, so once the slots have seen a typical message
+        /// length, queueing a message does not allocate. A full queue drops
+        /// the new message (counted) rather than block the logging thread.
+        class LogMessageQueue : boost::noncopyable {
+          public:
+            explicit LogMessageQueue(std::size_t capacity)
+                : m_capacity(roundUpToPowerOfTwo(capacity)),
+                  m_mask(m_capacity - 1), m_slots(new Slot[m_capacity]),
+                  m_enqueuePos(0), m_dequeuePos(0), m_highWaterMark(0),
+                  m_enqueued(0), m_dropped(0) {
+                for (std::size_t i = 0; i < m_capacity; ++i) {
+                    m_slots[i].seq.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            /// @brief Called from any thread: claims a slot and passes its
+            /// message to the given function, with signature `void
+            /// (QueuedLogMessage &)`, to fill in.
+            ///
+            /// @returns false (and counts a drop) if the queue was full.
+            template <typename F> bool tryPush(F &&fill) {
+                auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+                Slot *slot;
+                for (;;) {
+                    slot = &m_slots[pos & m_mask];
+                    auto seq = slot->seq.load(std::memory_order_acquire);
+                    if (seq == pos) {
+                        if (m_enqueuePos.compare_exchange_weak(
+                                pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                        // pos was updated by the failed CAS: try again.
+                    } else if (seq < pos) {
+                        // Full.
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    } else {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+                fill(slot->msg);
+                slot->seq.store(pos + 1, std::memory_order_release);
+                m_enqueued.fetch_add(1, std::memory_order_relaxed);
+                auto depth = size();
+                auto highWater =
+                    m_highWaterMark.load(std::memory_order_relaxed);
+                while (depth > highWater &&
+                       !m_highWaterMark.compare_exchange_weak(
+                           highWater, depth, std::memory_order_relaxed)) {
+                }
+                return true;
+            }
+
+            /// @brief Called only from the consumer thread: passes the oldest
+            /// message, if any, to the given function, with signature `void
+            /// (QueuedLogMessage &)`.
+            ///
+            /// @returns false if the queue was empty.
+            template <typename F> bool tryPop(F &&consume) {
+                auto pos = m_dequeuePos.load(std::memory_order_relaxed);
+                Slot &slot = m_slots[pos & m_mask];
+                if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+                    // Empty, or the next message is still being written.
+                    return false;
+                }
+                consume(slot.msg);
+                slot.seq.store(pos + m_capacity, std::memory_order_release);
+                m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /// @brief Number of messages currently queued (approximate if
+            /// called concurrently with push/pop).
+            std::size_t size() const {
+                auto enq = m_enqueuePos.load(std::memory_order_relaxed);
+                auto deq = m_dequeuePos.load(std::memory_order_relaxed);
+                return enq > deq ? enq - deq : 0;
+            }
+
+            std::size_t capacity() const { return m_capacity; }
+
+            /// @brief Largest number of messages ever queued at once.
+            std::size_t highWaterMark() const {
+                return m_highWaterMark.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Number of messages successfully queued.
+            std::uint64_t enqueued() const {
+                return m_enqueued.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Number of messages discarded because the queue was
+            /// full.
+            std::uint64_t dropped() const {
+                return m_dropped.load(std::memory_order_relaxed);
+            }
+
+          private:
+            struct Slot {
+                std::atomic<std::size_t> seq;
+                QueuedLogMessage msg;
+            };
+
+            static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+                std::size_t ret = 2;
+                while (ret < n) {
+                    ret <<= 1;
+                }
+                return ret;
+            }
+
+            const std::size_t m_capacity;
+            const std::size_t m_mask;
+            unique_ptr<Slot[]> m_slots;
+
+            std::atomic<std::size_t> m_enqueuePos;
+            std::atomic<std::size_t> m_dequeuePos;
+
+            /// @name Metrics
+            /// @{
+            std::atomic<std::size_t> m_highWaterMark;
+            std::atomic<std::uint64_t> m_enqueued;
+            std::atomic<std::uint64_t> m_dropped;
+            /// @}
+        };
+    } // namespace log
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_LogMessageQueue_h_GUID_8745C13F_9A3E_4887_9190_A5C7C8FFEC35
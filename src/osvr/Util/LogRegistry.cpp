@@ -27,6 +27,7 @@
 #include <osvr/Util/LogRegistry.h>
 #include <osvr/Util/GetEnvironmentVariable.h>
 
+#include "LogAsyncSink.h"
 #include "LogDefaults.h"
 #include "LogLevelTranslate.h"
 #include "LogSinks.h"
@@ -45,6 +46,7 @@
 #include <spdlog/spdlog.h>
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -56,6 +58,21 @@ namespace util {
 
         static const auto LOG_FILE_EXTENSION = "log";
 
+        /// Number of messages that may be waiting for the writer thread
+        /// before further ones are dropped (or, for warnings and above,
+        /// written synchronously).
+        static const std::size_t ASYNC_QUEUE_SIZE = 1024;
+
+        /// Asynchronous logging is opt-in, since it means a writer thread in
+        /// every process (joined when the registry is destroyed at exit or
+        /// library unload).
+        static inline bool shouldLogAsync() {
+            using osvr::util::getEnvironmentVariable;
+            auto asyncLogging = getEnvironmentVariable("OSVR_LOG_ASYNC");
+            return asyncLogging && !asyncLogging->empty() &&
+                   *asyncLogging != "0";
+        }
+
         /// Tries to compute a sanitized version of the executable's
         /// basename/stem, falling back to the hardcoded one above if it
         /// encounters difficulties.
@@ -90,10 +107,11 @@ namespace util {
                 // Bummer, it didn't exist. We'll create one from scratch.
                 try {
                     spd_logger = spdlog::details::registry::instance().create(
-                        logger_name, begin(sinks_), end(sinks_));
+                        logger_name, begin(logger_sinks_), end(logger_sinks_));
                     spd_logger->set_pattern(DEFAULT_PATTERN);
                     /// @todo should this level be different than other levels?
-                    spd_logger->set_level(convertToLevelEnum(minLevel_));
+                    spd_logger->set_level(
+                        convertToLevelEnum(getEffectiveLevel()));
                     spd_logger->flush_on(
                         convertToLevelEnum(DEFAULT_FLUSH_LEVEL));
                 } catch (const std::exception &e) {
@@ -121,6 +139,9 @@ namespace util {
         void LogRegistry::dropAll() { spdlog::drop_all(); }
 
         void LogRegistry::flush() {
+            if (async_sink_) {
+                async_sink_->flush_and_wait();
+            }
             for (auto &sink : sinks_) {
                 try {
                     sink->flush();
@@ -181,6 +202,17 @@ namespace util {
 
             createFileSink();
 
+            if (shouldLogAsync()) {
+                async_sink_ =
+                    std::make_shared<async_sink>(sinks_, ASYNC_QUEUE_SIZE);
+                logger_sinks_.push_back(async_sink_);
+            } else {
+                logger_sinks_ = sinks_;
+            }
+            // Now that we know which sinks we have, we know the lowest level
+            // any of them will write.
+            setLevelImpl(minLevel_);
+
             auto binLoc = getBinaryLocation();
             if (!binLoc.empty()) {
                 generalPurposeLog_->notice("Logging for ") << binLoc;
@@ -188,13 +220,48 @@ namespace util {
         }
 
         LogRegistry::~LogRegistry() {
-            // do nothing but flush
+            // do nothing but flush (and stop the writer thread)
             flush();
+            if (async_sink_) {
+                async_sink_->shutdown();
+                auto dropped = async_sink_->dropped();
+                if (dropped > 0) {
+                    std::cerr << "[OSVR] " << dropped
+                              << " log messages were dropped because the "
+                                 "log queue was full."
+                              << std::endl;
+                }
+            }
+        }
+
+        LogQueueStats LogRegistry::getAsyncQueueStats() const {
+            LogQueueStats ret;
+            if (async_sink_) {
+                auto const &queue = async_sink_->queue();
+                ret.depth = queue.size();
+                ret.highWaterMark = queue.highWaterMark();
+                ret.capacity = queue.capacity();
+                ret.enqueued = queue.enqueued();
+                ret.dropped = async_sink_->dropped();
+            }
+            return ret;
+        }
+
+        LogLevel LogRegistry::getEffectiveLevel() const {
+#if defined(OSVR_ANDROID)
+            return minLevel_;
+#else
+            // Without a file sink, anything below the console level would be
+            // formatted only to be filtered out: have the loggers reject it
+            // up front instead.
+            return couldOpenLogFile() ? minLevel_
+                                      : std::max(minLevel_, consoleLevel_);
+#endif
         }
 
         void LogRegistry::setLevelImpl(LogLevel severity) {
-            spdlog::set_level(convertToLevelEnum(severity));
             minLevel_ = severity;
+            spdlog::set_level(convertToLevelEnum(getEffectiveLevel()));
         }
 
         void LogRegistry::setConsoleLevelImpl(LogLevel severity) {
@@ -202,6 +269,7 @@ namespace util {
             if (console_filter_) {
                 console_filter_->set_level(convertToLevelEnum(severity));
             }
+            spdlog::set_level(convertToLevelEnum(getEffectiveLevel()));
         }
 
         static inline bool shouldLogToFile() {
@@ -225,8 +293,6 @@ namespace util {
             // File sink - rotates daily
             std::string logDir;
             try {
-                size_t q_size = 64; // queue size must be power of 2
-                spdlog::set_async_mode(q_size);
                 namespace fs = boost::filesystem;
                 auto base_name = fs::path(getLoggingDirectory(true));
                 if (!base_name.empty()) {
@@ -28,6 +28,7 @@
 #include <osvr/Connection/ConnectionDevice.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/PluginHost/HostThreadSection.h>
 
 // Library/third-party includes
 // - none
@@ -57,7 +58,18 @@ namespace vrpnserver {
             return ret;
         }
 
+        /// @brief Called when the plugin asks for the connection to build a
+        /// VRPN device on: from then until the device is registered, the
+        /// connection is being modified, so during hardware detection on a
+        /// worker thread, hold off the server loop for that long.
+        void beginConnectionUse() {
+            if (!m_section) {
+                m_section.reset(new pluginhost::HostThreadSection);
+            }
+        }
+
         void registerDevice(OSVR_DeviceUpdateCallback cb, void *dev) {
+            beginConnectionUse();
             osvr::connection::ConnectionPtr conn =
                 osvr::connection::Connection::retrieveConnection(
                     m_ctx.getParent());
@@ -68,9 +80,11 @@ namespace vrpnserver {
                     "Your VRPN device has to register at least one name!");
             }
             m_connDev = conn->registerAdvancedDevice(names, cb, dev);
+            m_section.reset();
         }
 
         void setDeviceDescriptor(std::string const &jsonString) {
+            pluginhost::HostThreadSection section;
             m_connDev->setDeviceDescriptor(jsonString);
             osvr::connection::Connection::retrieveConnection(m_ctx.getParent())
                 ->triggerDescriptorHandlers();
@@ -81,6 +95,9 @@ namespace vrpnserver {
         }
 
       private:
+        /// @brief Held from beginConnectionUse() until the device is
+        /// registered.
+        unique_ptr<pluginhost::HostThreadSection> m_section;
         pluginhost::PluginSpecificRegistrationContext &m_ctx;
         connection::ConnectionDevice::NameList m_names;
         connection::ConnectionDevicePtr m_connDev;
@@ -102,6 +119,7 @@ namespace vrpnserver {
         return m_impl->useDecoratedName(name);
     }
     vrpn_Connection *VRPNDeviceRegistration::getVRPNConnection() {
+        m_impl->beginConnectionUse();
         return ::osvr::vrpnserver::getVRPNConnection(m_ctx);
     }
 
@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::IPCRingBufferPtr;
+
+namespace {
+static const uint32_t ENTRY_SIZE = 4096;
+
+IPCRingBuffer::Options makeOptions(std::string const &name, bool lockFree) {
+    IPCRingBuffer::Options opts(name);
+    opts.setEntries(4).setEntrySize(ENTRY_SIZE).setLockFree(lockFree);
+    return opts;
+}
+
+void fill(IPCRingBuffer &buf, uint8_t val) {
+    auto proxy = buf.put();
+    for (uint32_t i = 0; i < ENTRY_SIZE; ++i) {
+        proxy.get()[i] = val;
+    }
+}
+} // namespace
+
+class IPCRingBufferModes : public ::testing::TestWithParam<bool> {};
+
+TEST_P(IPCRingBufferModes, CreateAndFind) {
+    auto opts = makeOptions("osvr_test_ringbuf_find", GetParam());
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    ASSERT_EQ(GetParam(), server->isLockFree());
+
+    auto client =
+        IPCRingBuffer::find(IPCRingBuffer::Options("osvr_test_ringbuf_find"));
+    ASSERT_TRUE(bool(client));
+    ASSERT_EQ(GetParam(), client->isLockFree());
+    ASSERT_EQ(server->getEntrySize(), client->getEntrySize());
+    ASSERT_EQ(server->getEntries(), client->getEntries());
+}
+
+TEST_P(IPCRingBufferModes, PutAndGet) {
+    auto buf = IPCRingBuffer::create(
+        makeOptions("osvr_test_ringbuf_putget", GetParam()));
+    ASSERT_TRUE(bool(buf));
+    ASSERT_FALSE(bool(buf->getLatest()));
+
+    fill(*buf, 1);
+    fill(*buf, 2);
+    {
+        auto latest = buf->getLatest();
+        ASSERT_TRUE(bool(latest));
+        ASSERT_EQ(1, latest.getSequenceNumber());
+        ASSERT_EQ(2, latest.get()[ENTRY_SIZE - 1]);
+    }
+    {
+        auto first = buf->get(0);
+        ASSERT_TRUE(bool(first));
+        ASSERT_EQ(1, first.get()[0]);
+    }
+    ASSERT_FALSE(bool(buf->get(5)));
+}
+
+TEST_P(IPCRingBufferModes, OverwrittenEntriesUnavailable) {
+    auto buf = IPCRingBuffer::create(
+        makeOptions("osvr_test_ringbuf_overwrite", GetParam()));
+    ASSERT_TRUE(bool(buf));
+    for (uint8_t i = 0; i < 6; ++i) {
+        fill(*buf, i);
+    }
+    ASSERT_FALSE(bool(buf->get(0)));
+    ASSERT_FALSE(bool(buf->get(1)));
+    auto newest = buf->get(5);
+    ASSERT_TRUE(bool(newest));
+    ASSERT_EQ(5, newest.get()[0]);
+}
+
+TEST_P(IPCRingBufferModes, UnwrittenEntriesUnavailable) {
+    auto buf = IPCRingBuffer::create(
+        makeOptions("osvr_test_ringbuf_unwritten", GetParam()));
+    ASSERT_TRUE(bool(buf));
+    ASSERT_FALSE(bool(buf->get(0)));
+    ASSERT_FALSE(bool(buf->get(1)));
+    fill(*buf, 7);
+    ASSERT_TRUE(bool(buf->get(0)));
+    ASSERT_FALSE(bool(buf->get(1)));
+}
+
+INSTANTIATE_TEST_CASE_P(LockedAndLockFree, IPCRingBufferModes,
+                        ::testing::Bool());
+
+TEST(IPCRingBufferLockFree, AbandonedEntryNotPublished) {
+    auto buf = IPCRingBuffer::create(
+        makeOptions("osvr_test_ringbuf_abandon", true));
+    ASSERT_TRUE(bool(buf));
+    fill(*buf, 3);
+    {
+        auto proxy = buf->put();
+        proxy.get()[0] = 4;
+        proxy.abandon();
+        ASSERT_EQ(nullptr, proxy.get());
+    }
+    {
+        auto latest = buf->getLatest();
+        ASSERT_TRUE(bool(latest));
+        ASSERT_EQ(0, latest.getSequenceNumber());
+        ASSERT_EQ(3, latest.get()[0]);
+    }
+    fill(*buf, 5);
+    auto latest = buf->getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(2, latest.getSequenceNumber());
+    ASSERT_EQ(5, latest.get()[0]);
+}
@@ -0,0 +1,190 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Common/ImageChunkAssembly.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <vector>
+
+using osvr::common::ImageChunkAssembler;
+using osvr::common::ImageWireCompression;
+using osvr::common::forEachImageChunk;
+using osvr::common::messages::ImageChunkHeader;
+typedef std::vector<uint8_t> ByteVec;
+
+namespace {
+/// @brief A received chunk, as deserialized from a message.
+struct Chunk {
+    ImageChunkHeader header;
+    ByteVec payload;
+};
+
+/// @brief A dark 8-bit image large enough to take several chunks, with a
+/// few bright spots.
+OSVR_ImagingMetadata makeMetadata() {
+    OSVR_ImagingMetadata metadata;
+    metadata.height = 480;
+    metadata.width = 640;
+    metadata.channels = 1;
+    metadata.depth = 1;
+    metadata.type = OSVR_IVT_UNSIGNED_INT;
+    return metadata;
+}
+
+ByteVec makeImage(OSVR_ImagingMetadata const &metadata) {
+    ByteVec image(osvr::common::getBufferSize(metadata), 0);
+    for (size_t i = 17; i < image.size(); i += 7919) {
+        image[i] = static_cast<uint8_t>(i);
+    }
+    return image;
+}
+
+std::vector<Chunk> split(OSVR_ImagingMetadata const &metadata,
+                         ByteVec const &image, uint32_t frame,
+                         ImageWireCompression compression) {
+    std::vector<Chunk> ret;
+    forEachImageChunk(metadata, image.data(), 0, frame, compression,
+                      [&](ImageChunkHeader const &header,
+                          uint8_t const *payload, uint32_t payloadLen) {
+                          ret.push_back(
+                              Chunk{header, ByteVec(payload,
+                                                    payload + payloadLen)});
+                      });
+    return ret;
+}
+
+bool add(ImageChunkAssembler &assembler, Chunk const &chunk) {
+    return assembler.addChunk(chunk.header, chunk.payload.data(),
+                              static_cast<uint32_t>(chunk.payload.size()));
+}
+
+ByteVec assembled(ImageChunkAssembler const &assembler) {
+    auto const &image = assembler.getImage();
+    auto data = image.buffer.get();
+    return ByteVec(data, data + osvr::common::getBufferSize(image.metadata));
+}
+} // namespace
+
+class ImageChunkRoundTrip
+    : public ::testing::TestWithParam<ImageWireCompression> {};
+
+TEST_P(ImageChunkRoundTrip, InOrder) {
+    auto metadata = makeMetadata();
+    auto image = makeImage(metadata);
+    auto chunks = split(metadata, image, 0, GetParam());
+    ASSERT_EQ(6, chunks.size());
+
+    ImageChunkAssembler assembler;
+    for (size_t i = 0; i < chunks.size() - 1; ++i) {
+        ASSERT_FALSE(add(assembler, chunks[i]));
+    }
+    ASSERT_TRUE(add(assembler, chunks.back()));
+    ASSERT_EQ(image, assembled(assembler));
+    ASSERT_EQ(0, assembler.getImage().sensor);
+    ASSERT_EQ(metadata.width, assembler.getImage().metadata.width);
+}
+
+TEST_P(ImageChunkRoundTrip, OutOfOrderWithDuplicates) {
+    auto metadata = makeMetadata();
+    auto image = makeImage(metadata);
+    auto chunks = split(metadata, image, 3, GetParam());
+    std::reverse(chunks.begin(), chunks.end());
+
+    ImageChunkAssembler assembler;
+    ASSERT_FALSE(add(assembler, chunks[0]));
+    ASSERT_FALSE(add(assembler, chunks[0]));
+    for (size_t i = 1; i < chunks.size() - 1; ++i) {
+        ASSERT_FALSE(add(assembler, chunks[i]));
+    }
+    ASSERT_TRUE(add(assembler, chunks.back()));
+    ASSERT_EQ(image, assembled(assembler));
+}
+
+TEST_P(ImageChunkRoundTrip, NewFrameDropsIncompleteFrame) {
+    auto metadata = makeMetadata();
+    auto first = makeImage(metadata);
+    auto second = first;
+    second[0] = 42;
+    auto firstChunks = split(metadata, first, 0, GetParam());
+    auto secondChunks = split(metadata, second, 1, GetParam());
+
+    ImageChunkAssembler assembler;
+    for (size_t i = 0; i < firstChunks.size() - 1; ++i) {
+        ASSERT_FALSE(add(assembler, firstChunks[i]));
+    }
+    for (size_t i = 0; i < secondChunks.size() - 1; ++i) {
+        ASSERT_FALSE(add(assembler, secondChunks[i]));
+    }
+    ASSERT_TRUE(add(assembler, secondChunks.back()));
+    ASSERT_EQ(second, assembled(assembler));
+
+    // The rest of the first frame arrives too late to complete it.
+    ASSERT_FALSE(add(assembler, firstChunks.back()));
+}
+
+INSTANTIATE_TEST_CASE_P(Compression, ImageChunkRoundTrip,
+                        ::testing::Values(ImageWireCompression::None,
+                                          ImageWireCompression::RunLength));
+
+TEST(ImageChunkAssembly, RunLengthShrinksDarkChunks) {
+    auto metadata = makeMetadata();
+    auto chunks =
+        split(metadata, makeImage(metadata), 0, ImageWireCompression::RunLength);
+    for (auto const &chunk : chunks) {
+        ASSERT_EQ(ImageWireCompression::RunLength, chunk.header.encoding);
+        ASSERT_LT(chunk.payload.size(), chunk.header.rawLength / 10);
+    }
+}
+
+TEST(ImageChunkAssembly, MalformedChunksIgnored) {
+    auto metadata = makeMetadata();
+    auto image = makeImage(metadata);
+    auto chunks = split(metadata, image, 0, ImageWireCompression::None);
+    ImageChunkAssembler assembler;
+
+    auto badOffset = chunks[1];
+    badOffset.header.rawOffset += 1;
+    ASSERT_FALSE(add(assembler, badOffset));
+
+    auto badCount = chunks[1];
+    badCount.header.chunkCount += 1;
+    ASSERT_FALSE(add(assembler, badCount));
+
+    auto shortPayload = chunks[1];
+    shortPayload.payload.pop_back();
+    ASSERT_FALSE(add(assembler, shortPayload));
+
+    // A short payload drops the frame, so it must be started over.
+    for (size_t i = 0; i < chunks.size() - 1; ++i) {
+        ASSERT_FALSE(add(assembler, chunks[i]));
+    }
+    ASSERT_TRUE(add(assembler, chunks.back()));
+    ASSERT_EQ(image, assembled(assembler));
+}
@@ -0,0 +1,98 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Common/ImageWireCodec.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using namespace osvr::common::image_codec;
+typedef std::vector<uint8_t> ByteVec;
+
+namespace {
+ByteVec roundTrip(ByteVec const &input) {
+    ByteVec encoded;
+    rleEncode(input.data(), input.size(), encoded);
+    EXPECT_LE(encoded.size(), rleMaxEncodedSize(input.size()));
+    ByteVec decoded(input.size());
+    EXPECT_TRUE(
+        rleDecode(encoded.data(), encoded.size(), decoded.data(), input.size()));
+    return decoded;
+}
+} // namespace
+
+TEST(ImageWireCodec, Empty) {
+    ByteVec input;
+    ASSERT_EQ(input, roundTrip(input));
+}
+
+TEST(ImageWireCodec, DarkFrameCompresses) {
+    ByteVec input(60000, 0);
+    input[1000] = 255;
+    input[1001] = 250;
+    ByteVec encoded;
+    rleEncode(input.data(), input.size(), encoded);
+    ASSERT_LT(encoded.size(), input.size() / 50);
+    ASSERT_EQ(input, roundTrip(input));
+}
+
+TEST(ImageWireCodec, IncompressibleBounded) {
+    ByteVec input(1000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint8_t>(i * 7 + (i >> 3));
+    }
+    ASSERT_EQ(input, roundTrip(input));
+}
+
+TEST(ImageWireCodec, MixedRunsAndLiterals) {
+    ByteVec input;
+    for (int block = 0; block < 50; ++block) {
+        input.insert(input.end(), block % 5 + 1, static_cast<uint8_t>(block));
+        input.insert(input.end(), 200, static_cast<uint8_t>(block + 1));
+    }
+    ASSERT_EQ(input, roundTrip(input));
+}
+
+TEST(ImageWireCodec, RejectsTruncatedInput) {
+    ByteVec input(500, 3);
+    ByteVec encoded;
+    rleEncode(input.data(), input.size(), encoded);
+    encoded.pop_back();
+    ByteVec decoded(input.size());
+    ASSERT_FALSE(rleDecode(encoded.data(), encoded.size(), decoded.data(),
+                           decoded.size()));
+}
+
+TEST(ImageWireCodec, RejectsOverlongOutput) {
+    ByteVec input(500, 3);
+    ByteVec encoded;
+    rleEncode(input.data(), input.size(), encoded);
+    ByteVec decoded(input.size() - 1);
+    ASSERT_FALSE(rleDecode(encoded.data(), encoded.size(), decoded.data(),
+                           decoded.size()));
+}
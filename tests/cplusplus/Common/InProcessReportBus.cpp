@@ -0,0 +1,139 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportBus.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using namespace osvr::common;
+using osvr::util::time::TimeValue;
+
+namespace {
+struct PoseLog {
+    std::vector<OSVR_ChannelCount> sensors;
+    std::vector<double> xs;
+    InProcessReportChannel *channel = nullptr;
+    bool unsubscribeWhenCalled = false;
+};
+
+void recordPose(void *userdata, OSVR_PoseState const &pose,
+                OSVR_ChannelCount sensor, TimeValue const &) {
+    auto &log = *static_cast<PoseLog *>(userdata);
+    log.sensors.push_back(sensor);
+    log.xs.push_back(pose.translation.data[0]);
+    if (log.unsubscribeWhenCalled) {
+        log.channel->unsubscribe<OSVR_PoseState>(&recordPose, userdata);
+    }
+}
+
+void recordVelocity(void *userdata, OSVR_VelocityState const &,
+                    OSVR_ChannelCount sensor, TimeValue const &) {
+    static_cast<PoseLog *>(userdata)->sensors.push_back(sensor);
+}
+
+OSVR_PoseState makePose(double x) {
+    OSVR_PoseState pose = {{{x, 0, 0}}, {{1, 0, 0, 0}}};
+    return pose;
+}
+
+/// Never dereferenced: only the addresses matter.
+vrpn_Connection *fakeConnection(int &storage) {
+    return reinterpret_cast<vrpn_Connection *>(&storage);
+}
+} // namespace
+
+TEST(InProcessReportBus, DeliversByStateType) {
+    InProcessReportChannel channel;
+    PoseLog poses;
+    PoseLog velocities;
+    ASSERT_FALSE(channel.hasSubscribers<OSVR_PoseState>());
+    channel.subscribe<OSVR_PoseState>(&recordPose, &poses);
+    channel.subscribe<OSVR_VelocityState>(&recordVelocity, &velocities);
+    ASSERT_TRUE(channel.hasSubscribers<OSVR_PoseState>());
+    ASSERT_FALSE(channel.hasSubscribers<OSVR_AccelerationState>());
+
+    TimeValue now = {0, 0};
+    channel.publish(makePose(1.5), 2, now);
+    ASSERT_EQ(1u, poses.sensors.size());
+    ASSERT_EQ(2u, poses.sensors[0]);
+    ASSERT_EQ(1.5, poses.xs[0]);
+    ASSERT_TRUE(velocities.sensors.empty());
+
+    channel.unsubscribe<OSVR_PoseState>(&recordPose, &poses);
+    channel.publish(makePose(2.5), 0, now);
+    ASSERT_EQ(1u, poses.sensors.size());
+    ASSERT_FALSE(channel.hasSubscribers<OSVR_PoseState>());
+}
+
+TEST(InProcessReportBus, UnsubscribeFromCallback) {
+    InProcessReportChannel channel;
+    PoseLog first;
+    PoseLog second;
+    first.channel = &channel;
+    first.unsubscribeWhenCalled = true;
+    channel.subscribe<OSVR_PoseState>(&recordPose, &first);
+    channel.subscribe<OSVR_PoseState>(&recordPose, &second);
+
+    TimeValue now = {0, 0};
+    channel.publish(makePose(1), 0, now);
+    channel.publish(makePose(2), 0, now);
+    ASSERT_EQ(1u, first.xs.size());
+    ASSERT_EQ(2u, second.xs.size());
+    ASSERT_TRUE(channel.hasSubscribers<OSVR_PoseState>());
+
+    channel.unsubscribe<OSVR_PoseState>(&recordPose, &second);
+    ASSERT_FALSE(channel.hasSubscribers<OSVR_PoseState>());
+}
+
+TEST(InProcessReportBus, RegistryKeyedOnConnectionAndDevice) {
+    int connA;
+    int connB;
+    auto channel =
+        advertiseInProcessReports(fakeConnection(connA), "org_test/Tracker");
+    ASSERT_EQ(channel,
+              findInProcessReports(fakeConnection(connA), "org_test/Tracker"));
+    ASSERT_FALSE(
+        findInProcessReports(fakeConnection(connB), "org_test/Tracker"));
+    ASSERT_FALSE(
+        findInProcessReports(fakeConnection(connA), "org_test/Other"));
+
+    // A replacement device takes over the name; the old one withdrawing
+    // late doesn't remove it.
+    auto replacement =
+        advertiseInProcessReports(fakeConnection(connA), "org_test/Tracker");
+    withdrawInProcessReports(fakeConnection(connA), "org_test/Tracker",
+                             channel);
+    ASSERT_EQ(replacement,
+              findInProcessReports(fakeConnection(connA), "org_test/Tracker"));
+    withdrawInProcessReports(fakeConnection(connA), "org_test/Tracker",
+                             replacement);
+    ASSERT_FALSE(
+        findInProcessReports(fakeConnection(connA), "org_test/Tracker"));
+}
@@ -0,0 +1,85 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InterfaceCallbacks.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::InterfaceCallbacks;
+
+static void countAnalog(void *userdata, const OSVR_TimeValue *,
+                        const OSVR_AnalogReport *report) {
+    *static_cast<double *>(userdata) += report->state;
+}
+
+TEST(InterfaceCallbacks, CCallbacks) {
+    InterfaceCallbacks callbacks;
+    OSVR_AnalogReport report = {};
+    ASSERT_EQ(0u, callbacks.getNumCallbacksFor(report));
+
+    double first = 0;
+    double second = 0;
+    callbacks.addCallback(&countAnalog, &first);
+    callbacks.addCallback(&countAnalog, &second);
+    ASSERT_EQ(2u, callbacks.getNumCallbacksFor(report));
+    OSVR_ButtonReport buttonReport = {};
+    ASSERT_EQ(0u, callbacks.getNumCallbacksFor(buttonReport));
+
+    OSVR_TimeValue timestamp = {0, 0};
+    report.state = 1.5;
+    callbacks.triggerCallbacks(timestamp, report);
+    ASSERT_EQ(1.5, first);
+    ASSERT_EQ(1.5, second);
+    callbacks.triggerCallbacks(timestamp, buttonReport);
+    ASSERT_EQ(1.5, first);
+}
+
+TEST(InterfaceCallbacks, Callables) {
+    InterfaceCallbacks callbacks;
+    int calls = 0;
+    OSVR_TimeValue const *seenTimestamp = nullptr;
+    callbacks.addCallable<OSVR_AnalogReport>(
+        [&](const OSVR_TimeValue *timestamp, const OSVR_AnalogReport *) {
+            ++calls;
+            seenTimestamp = timestamp;
+        });
+    double sum = 0;
+    callbacks.addCallback(&countAnalog, &sum);
+
+    OSVR_AnalogReport report = {};
+    ASSERT_EQ(2u, callbacks.getNumCallbacksFor(report));
+    OSVR_TimeValue timestamp = {0, 0};
+    report.state = 2;
+    callbacks.triggerCallbacks(timestamp, report);
+    callbacks.triggerCallbacks(timestamp, report);
+    ASSERT_EQ(2, calls);
+    ASSERT_EQ(&timestamp, seenTimestamp);
+    ASSERT_EQ(4, sum);
+}
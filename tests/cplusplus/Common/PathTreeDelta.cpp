@@ -0,0 +1,136 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathElementTools.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using namespace osvr::common::elements;
+
+TEST(PathTreeDelta, IdenticalTreesGiveEmptyDelta) {
+    PathTree tree;
+    dummy::setupDummyTree(tree);
+    auto json = common::pathTreeToJson(tree);
+    auto delta = common::pathTreeDelta(json, json);
+    ASSERT_TRUE(common::isEmptyPathTreeDelta(delta));
+}
+
+TEST(PathTreeDelta, AddChangeRemoveRoundtrip) {
+    PathTree oldTree;
+    dummy::setupDummyTree(oldTree);
+    oldTree.getNodeByPath("/me/head", AliasElement("/some/source"));
+    auto oldJson = common::pathTreeToJson(oldTree);
+
+    PathTree newTree;
+    dummy::setupDummyDevice(newTree);
+    newTree.getNodeByPath(dummy::getAlias(), AliasElement("/another/source"));
+    newTree.getNodeByPath("/me/hands/right", AliasElement("/right/source"));
+    auto newJson = common::pathTreeToJson(newTree);
+
+    auto delta = common::pathTreeDelta(oldJson, newJson);
+    ASSERT_FALSE(common::isEmptyPathTreeDelta(delta));
+    ASSERT_EQ(2u, delta["set"].size());
+    ASSERT_EQ(1u, delta["remove"].size());
+    ASSERT_EQ("/me/head", delta["remove"][0].asString());
+
+    common::applyPathTreeDelta(oldTree, delta);
+    ASSERT_EQ(newJson, common::pathTreeToJson(oldTree));
+    ASSERT_THROW(static_cast<PathTree const &>(oldTree).getNodeByPath(
+                     "/me/head"),
+                 osvr::util::tree::NoSuchChild)
+        << "Removed nodes should be pruned, not left as nulls";
+}
+
+TEST(PathTreeDelta, RemovePrunesEmptyAncestors) {
+    PathTree oldTree;
+    oldTree.getNodeByPath("/me/head", AliasElement("/some/source"));
+    oldTree.getNodeByPath("/me/hands/left", AliasElement("/left/source"));
+    oldTree.getNodeByPath("/me/hands/right", AliasElement("/right/source"));
+
+    PathTree newTree;
+    newTree.getNodeByPath("/me/head/child", AliasElement("/child/source"));
+    newTree.getNodeByPath("/me/hands/left", AliasElement("/left/source"));
+
+    common::applyPathTreeDelta(
+        oldTree, common::pathTreeDelta(common::pathTreeToJson(oldTree),
+                                       common::pathTreeToJson(newTree)));
+    PathTree const &tree = oldTree;
+    ASSERT_THROW(tree.getNodeByPath("/me/hands/right"),
+                 osvr::util::tree::NoSuchChild);
+    ASSERT_TRUE(isNull(tree.getNodeByPath("/me/head").value()))
+        << "Removed node with a new child should stay as a null";
+    ASSERT_NO_THROW(tree.getNodeByPath("/me/head/child"));
+
+    common::applyPathTreeDelta(
+        oldTree,
+        common::pathTreeDelta(common::pathTreeToJson(oldTree),
+                              Json::Value(Json::arrayValue)));
+    ASSERT_THROW(tree.getNodeByPath("/me"), osvr::util::tree::NoSuchChild)
+        << "Ancestors left null and childless should be pruned";
+}
+
+TEST(PathTreeDelta, OwnerChecksVersions) {
+    PathTree tree;
+    dummy::setupDummyTree(tree);
+    common::PathTreeOwner owner;
+
+    Json::Value delta(Json::objectValue);
+    delta["version"] = 1;
+    delta["set"] = Json::Value(Json::arrayValue);
+    delta["remove"] = Json::Value(Json::arrayValue);
+    ASSERT_FALSE(owner.applyTreeDelta(delta))
+        << "Can't apply a delta before we have a tree";
+
+    owner.replaceTree(common::pathTreeToJson(tree));
+    ASSERT_TRUE(owner.applyTreeDelta(delta));
+    ASSERT_EQ(1u, *owner.getVersion());
+
+    PathTree newTree;
+    dummy::setupDummyTree(newTree);
+    newTree.getNodeByPath("/me/head", AliasElement("/some/source"));
+    auto change = common::pathTreeDelta(common::pathTreeToJson(tree),
+                                        common::pathTreeToJson(newTree));
+    change["baseVersion"] = 5;
+    change["version"] = 6;
+    ASSERT_FALSE(owner.applyTreeDelta(change)) << "Version mismatch";
+    ASSERT_EQ(1u, *owner.getVersion());
+
+    change["baseVersion"] = 1;
+    change["version"] = 2;
+    ASSERT_TRUE(owner.applyTreeDelta(change));
+    ASSERT_EQ(2u, *owner.getVersion());
+    ASSERT_EQ(common::pathTreeToJson(newTree),
+              common::pathTreeToJson(owner.get()));
+}
@@ -91,4 +91,36 @@ TEST_F(PathTreeResolution, BackCompatRoute) {
 
     setAlias(val.toStyledString());
     checkResolution();
-}
\ No newline at end of file
+}
+TEST_F(PathTreeResolution, Cached) {
+    Json::Value transform(Json::objectValue);
+    transform["rotate"]["axis"] = "x";
+    transform["rotate"]["degrees"] = 90;
+    transform["child"] = dummy::getFullSourcePath();
+    setAlias(transform.toStyledString());
+    tree.getNodeByPath("/me/chained",
+                       common::elements::AliasElement(dummy::getAlias()));
+
+    common::TreeResolutionCache cache;
+    auto direct = common::resolveTreeNode(tree, "/me/chained");
+    auto first = common::resolveTreeNode(tree, "/me/chained", cache);
+    auto second = common::resolveTreeNode(tree, "/me/chained", cache);
+    ASSERT_TRUE(direct.is_initialized());
+    ASSERT_TRUE(first.is_initialized());
+    ASSERT_TRUE(second.is_initialized());
+    ASSERT_EQ(direct->getTransformJson(), first->getTransformJson());
+    ASSERT_EQ(first->getTransformJson(), second->getTransformJson());
+    ASSERT_EQ(first->getSensor(), second->getSensor());
+
+    ASSERT_FALSE(common::resolveTreeNode(tree, "/me/nowhere", cache)
+                     .is_initialized());
+    tree.getNodeByPath("/me/nowhere",
+                       common::elements::AliasElement(dummy::getAlias()));
+    ASSERT_FALSE(common::resolveTreeNode(tree, "/me/nowhere", cache)
+                     .is_initialized())
+        << "Results are stale until the cache is invalidated";
+    cache.invalidate();
+    ASSERT_EQ(1u, cache.getGeneration());
+    ASSERT_TRUE(common::resolveTreeNode(tree, "/me/nowhere", cache)
+                    .is_initialized());
+}
@@ -0,0 +1,133 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PoseAtTime.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::common::InterfaceState;
+using osvr::common::StateHistory;
+using osvr::util::time::TimeValue;
+
+static TimeValue makeTime(int64_t seconds, int32_t microseconds) {
+    TimeValue ret = {seconds, microseconds};
+    return ret;
+}
+
+static OSVR_PoseReport makePoseReport(double x) {
+    OSVR_PoseReport report;
+    report.sensor = 0;
+    osvrPose3SetIdentity(&report.pose);
+    report.pose.translation.data[0] = x;
+    return report;
+}
+
+TEST(StateHistory, Ring) {
+    StateHistory<int> history(3);
+    ASSERT_TRUE(history.empty());
+    for (int i = 0; i < 5; ++i) {
+        history.push(makeTime(i, 0), i);
+    }
+    ASSERT_EQ(3u, history.size());
+    ASSERT_EQ(4, history.newest().state);
+    ASSERT_EQ(3, history[1].state);
+    ASSERT_EQ(2, history.oldest().state);
+
+    StateHistory<int>::Entry const *before = nullptr;
+    StateHistory<int>::Entry const *after = nullptr;
+    ASSERT_TRUE(history.findBracket(makeTime(3, 500000), before, after));
+    ASSERT_EQ(3, before->state);
+    ASSERT_EQ(4, after->state);
+    ASSERT_FALSE(history.findBracket(makeTime(1, 0), before, after));
+    ASSERT_FALSE(history.findBracket(makeTime(5, 0), before, after));
+
+    ASSERT_THROW(StateHistory<int>(0), std::invalid_argument);
+}
+
+TEST(PoseAtTime, NoState) {
+    InterfaceState state;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(osvr::common::getPoseAtTime(state, makeTime(0, 0), pose));
+}
+
+TEST(PoseAtTime, Interpolate) {
+    InterfaceState state;
+    state.enableHistory<OSVR_PoseReport>(4);
+    state.setStateFromReport(makeTime(1, 0), makePoseReport(0));
+    state.setStateFromReport(makeTime(2, 0), makePoseReport(1));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(
+        osvr::common::getPoseAtTime(state, makeTime(1, 250000), pose));
+    ASSERT_DOUBLE_EQ(0.25, pose.translation.data[0]);
+    ASSERT_DOUBLE_EQ(1, osvrQuatGetW(&pose.rotation));
+
+    ASSERT_TRUE(osvr::common::getPoseAtTime(state, makeTime(0, 0), pose));
+    ASSERT_DOUBLE_EQ(0, pose.translation.data[0]) << "Clamped to oldest";
+}
+
+TEST(PoseAtTime, Extrapolate) {
+    InterfaceState state;
+    state.setStateFromReport(makeTime(1, 0), makePoseReport(0));
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(
+        osvr::common::getPoseAtTime(state, makeTime(1, 50000), pose));
+    ASSERT_DOUBLE_EQ(0, pose.translation.data[0])
+        << "No velocity, so no extrapolation";
+
+    OSVR_VelocityReport vel;
+    vel.sensor = 0;
+    vel.state.linearVelocityValid = true;
+    vel.state.linearVelocity.data[0] = 2;
+    vel.state.linearVelocity.data[1] = 0;
+    vel.state.linearVelocity.data[2] = 0;
+    vel.state.angularVelocityValid = true;
+    vel.state.angularVelocity.dt = 0.5;
+    // A quarter turn about y every half second.
+    Eigen::Quaterniond quarterTurn(
+        Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitY()));
+    osvr::util::toQuat(quarterTurn,
+                       vel.state.angularVelocity.incrementalRotation);
+    state.setStateFromReport(makeTime(1, 0), vel);
+
+    ASSERT_TRUE(
+        osvr::common::getPoseAtTime(state, makeTime(1, 50000), pose));
+    ASSERT_NEAR(0.1, pose.translation.data[0], 1e-9);
+    Eigen::AngleAxisd rotation(osvr::util::fromQuat(pose.rotation));
+    ASSERT_NEAR(M_PI / 20, rotation.angle(), 1e-9);
+    ASSERT_NEAR(1, rotation.axis().y(), 1e-9);
+
+    ASSERT_TRUE(osvr::common::getPoseAtTime(state, makeTime(10, 0), pose));
+    ASSERT_NEAR(osvr::common::MAX_POSE_EXTRAPOLATION * 2,
+                pose.translation.data[0], 1e-9)
+        << "Extrapolation is limited";
+}
@@ -0,0 +1,80 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ThreadScheduling.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+
+using namespace osvr::common;
+
+TEST(ThreadScheduling, parsePolicy) {
+    SchedulingPolicy policy = SchedulingPolicy::Default;
+    ASSERT_TRUE(parseSchedulingPolicy("fifo", policy));
+    ASSERT_EQ(SchedulingPolicy::Fifo, policy);
+    ASSERT_TRUE(parseSchedulingPolicy("rr", policy));
+    ASSERT_EQ(SchedulingPolicy::RoundRobin, policy);
+    ASSERT_TRUE(parseSchedulingPolicy("default", policy));
+    ASSERT_EQ(SchedulingPolicy::Default, policy);
+    ASSERT_FALSE(parseSchedulingPolicy("SCHED_FIFO", policy));
+    ASSERT_EQ(SchedulingPolicy::Default, policy) << "Unchanged on failure";
+}
+
+TEST(ThreadScheduling, roleConfigRoundTrip) {
+    ASSERT_TRUE(getThreadSchedulingConfig(ThreadRole::Tracker).isDefault());
+    ThreadSchedulingConfig config;
+    config.policy = SchedulingPolicy::RoundRobin;
+    config.priority = 42;
+    config.cpus = {1, 3};
+    setThreadSchedulingConfig(ThreadRole::Tracker, config);
+    auto result = getThreadSchedulingConfig(ThreadRole::Tracker);
+    ASSERT_EQ(SchedulingPolicy::RoundRobin, result.policy);
+    ASSERT_EQ(42, result.priority);
+    ASSERT_EQ(config.cpus, result.cpus);
+    ASSERT_TRUE(getThreadSchedulingConfig(ThreadRole::AsyncDevice).isDefault())
+        << "Roles are configured independently";
+
+    setThreadSchedulingConfig(ThreadRole::Tracker, ThreadSchedulingConfig{});
+    ASSERT_TRUE(getThreadSchedulingConfig(ThreadRole::Tracker).isDefault());
+}
+
+TEST(ThreadScheduling, defaultIsNoOp) {
+    std::string error;
+    ASSERT_TRUE(applyThreadScheduling(ThreadSchedulingConfig{}, error));
+    ASSERT_TRUE(error.empty());
+    ASSERT_TRUE(applyThreadScheduling(ThreadRole::ServerMainLoop));
+}
+
+TEST(ThreadScheduling, invalidCpuFails) {
+    ThreadSchedulingConfig config;
+    config.cpus = {-1};
+    std::string error;
+    ASSERT_FALSE(applyThreadScheduling(config, error));
+    ASSERT_FALSE(error.empty());
+}
@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Common/TraceEventBuffer.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osvr::common::tracing;
+
+TEST(TraceEventBuffer, emptySnapshot) {
+    TraceEventBuffer buf(4, 0);
+    std::vector<TraceEvent> events;
+    buf.snapshot(events);
+    ASSERT_TRUE(events.empty());
+    ASSERT_EQ(0u, buf.totalRecorded());
+}
+
+TEST(TraceEventBuffer, recordsInOrder) {
+    TraceEventBuffer buf(4, 0);
+    buf.record(TraceEventCategory::Main, "a", 10, 5);
+    buf.record(TraceEventCategory::Worker, "b", 20, TraceEvent::INSTANT);
+    std::vector<TraceEvent> events;
+    buf.snapshot(events);
+    ASSERT_EQ(2u, events.size());
+    ASSERT_STREQ("a", events[0].text);
+    ASSERT_EQ(10, events[0].timestamp);
+    ASSERT_EQ(5, events[0].duration);
+    ASSERT_EQ(TraceEventCategory::Main, events[0].category);
+    ASSERT_STREQ("b", events[1].text);
+    ASSERT_EQ(std::int64_t(TraceEvent::INSTANT), events[1].duration);
+    ASSERT_EQ(TraceEventCategory::Worker, events[1].category);
+}
+
+TEST(TraceEventBuffer, keepsNewestWhenFull) {
+    TraceEventBuffer buf(3, 0);
+    for (int i = 0; i < 10; ++i) {
+        buf.record(TraceEventCategory::Main, "x", i, 0);
+    }
+    ASSERT_EQ(10u, buf.totalRecorded());
+    std::vector<TraceEvent> events;
+    buf.snapshot(events);
+    ASSERT_EQ(3u, events.size());
+    ASSERT_EQ(7, events[0].timestamp);
+    ASSERT_EQ(8, events[1].timestamp);
+    ASSERT_EQ(9, events[2].timestamp);
+}
+
+TEST(TraceEventBuffer, snapshotWhileRecording) {
+    TraceEventBuffer buf(8, 0);
+    std::atomic<bool> done(false);
+    std::thread writer([&] {
+        for (int i = 0; i < 100000; ++i) {
+            buf.record(TraceEventCategory::Main, std::to_string(i).c_str(), i,
+                       0);
+        }
+        done = true;
+    });
+    std::vector<TraceEvent> events;
+    do {
+        events.clear();
+        buf.snapshot(events);
+        ASSERT_LE(events.size(), buf.capacity());
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(std::to_string(events[i].timestamp),
+                      std::string(events[i].text));
+            if (i > 0) {
+                ASSERT_LT(events[i - 1].timestamp, events[i].timestamp);
+            }
+        }
+    } while (!done);
+    writer.join();
+    events.clear();
+    buf.snapshot(events);
+    ASSERT_EQ(buf.capacity(), events.size());
+    ASSERT_EQ(99999, events.back().timestamp);
+}
+
+TEST(TraceEventBuffer, truncatesLongText) {
+    TraceEventBuffer buf(1, 0);
+    std::string longText(TraceEvent::MAX_TEXT_LENGTH * 2, 'z');
+    buf.record(TraceEventCategory::Main, longText.c_str(), 0, 0);
+    std::vector<TraceEvent> events;
+    buf.snapshot(events);
+    ASSERT_EQ(1u, events.size());
+    ASSERT_EQ(longText.substr(0, TraceEvent::MAX_TEXT_LENGTH),
+              std::string(events[0].text));
+}
+
+TEST(TraceEventBuffer, chromeTraceOutput) {
+    TraceEventBuffer main(4, 0);
+    TraceEventBuffer worker(4, 1);
+    main.record(TraceEventCategory::Main, "Server \"update\"", 1234567, 2005);
+    worker.record(TraceEventCategory::Worker, "tick", 42, TraceEvent::INSTANT);
+    std::ostringstream os;
+    writeChromeTrace(os, 99, {&main, &worker});
+    auto json = os.str();
+    ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+    ASSERT_NE(std::string::npos,
+              json.find("{\"name\":\"Server \\\"update\\\"\",\"cat\":\"main\","
+                        "\"pid\":99,\"tid\":0,\"ts\":1234.567,\"ph\":\"X\","
+                        "\"dur\":2.005}"));
+    ASSERT_NE(std::string::npos,
+              json.find("{\"name\":\"tick\",\"cat\":\"worker\",\"pid\":99,"
+                        "\"tid\":1,\"ts\":0.042,\"ph\":\"i\",\"s\":\"t\"}"));
+}
+
+TEST(TraceEventBuffer, escapesControlCharacters) {
+    std::ostringstream os;
+    detail::writeJsonString(os, "a\nb\\");
+    ASSERT_EQ("\"a\\u000ab\\\\\"", os.str());
+}
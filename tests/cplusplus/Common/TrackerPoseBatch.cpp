@@ -0,0 +1,111 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::Buffer;
+using osvr::common::messages::TrackerPoseBatch;
+
+static std::vector<OSVR_TrackerPoseBatchEntry> makeEntries(std::size_t n) {
+    std::vector<OSVR_TrackerPoseBatchEntry> ret(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &entry = ret[i];
+        entry.sensor = OSVR_ChannelCount(i * 3 + 1);
+        for (int j = 0; j < 3; ++j) {
+            entry.pose.translation.data[j] = double(i) + 0.1 * j;
+        }
+        for (int j = 0; j < 4; ++j) {
+            entry.pose.rotation.data[j] = -double(i) - 0.01 * j;
+        }
+        entry.timestamp.seconds = 1400000000 + OSVR_TimeValue_Seconds(i);
+        entry.timestamp.microseconds = OSVR_TimeValue_Microseconds(i * 1000);
+    }
+    return ret;
+}
+
+TEST(TrackerPoseBatch, RoundTrip) {
+    auto entries = makeEntries(12);
+    Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization out(
+        entries.data(), OSVR_ChannelCount(entries.size()));
+    osvr::common::serialize(buf, out);
+
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size());
+    TrackerPoseBatch::MessageSerialization in;
+    osvr::common::deserialize(reader, in);
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+
+    auto const &result = in.getEntries();
+    ASSERT_EQ(result.size(), entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        ASSERT_EQ(result[i].sensor, entries[i].sensor);
+        ASSERT_EQ(result[i].timestamp.seconds, entries[i].timestamp.seconds);
+        ASSERT_EQ(result[i].timestamp.microseconds,
+                  entries[i].timestamp.microseconds);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQ(result[i].pose.translation.data[j],
+                      entries[i].pose.translation.data[j]);
+        }
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_EQ(result[i].pose.rotation.data[j],
+                      entries[i].pose.rotation.data[j]);
+        }
+    }
+}
+
+TEST(TrackerPoseBatch, Empty) {
+    Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization out(nullptr, 0);
+    osvr::common::serialize(buf, out);
+    ASSERT_EQ(buf.size(), sizeof(uint32_t));
+
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size());
+    TrackerPoseBatch::MessageSerialization in;
+    osvr::common::deserialize(reader, in);
+    ASSERT_TRUE(in.getEntries().empty());
+}
+
+TEST(TrackerPoseBatch, Compact) {
+    /// Count, padding to the 8-byte alignment of the doubles, then 7 doubles,
+    /// the timestamp and the sensor per entry: no padding between entries.
+    static const std::size_t ENTRY_BYTES = 7 * 8 + 8 + 4 + 4;
+    auto entries = makeEntries(TrackerPoseBatch::MAX_ENTRIES_PER_MESSAGE);
+    Buffer<> buf;
+    TrackerPoseBatch::MessageSerialization out(
+        entries.data(), OSVR_ChannelCount(entries.size()));
+    osvr::common::serialize(buf, out);
+    ASSERT_EQ(buf.size(), 8 + ENTRY_BYTES * entries.size());
+    /// Must fit in a single datagram, with room for VRPN's own header.
+    ASSERT_LT(buf.size(), 1400u);
+}
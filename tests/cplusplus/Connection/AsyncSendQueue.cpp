@@ -0,0 +1,227 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncSendQueue.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace osvr::connection;
+using osvr::util::time::TimeValue;
+
+/// @brief The queue only stores and compares message type pointers, so any
+/// distinct addresses will do.
+static char typeStorage[2];
+static MessageType *const typeA =
+    reinterpret_cast<MessageType *>(&typeStorage[0]);
+static MessageType *const typeB =
+    reinterpret_cast<MessageType *>(&typeStorage[1]);
+
+struct Received {
+    MessageType *type;
+    std::string data;
+};
+
+class Collector {
+  public:
+    void operator()(TimeValue const &, MessageType *type, const char *buf,
+                    std::size_t len) {
+        received.push_back(Received{type, std::string(buf, len)});
+    }
+    std::vector<Received> received;
+};
+
+inline bool pushString(AsyncSendQueue &queue, MessageType *type,
+                       std::string const &s) {
+    TimeValue tv = {0, 0};
+    return queue.push(tv, type, s.data(), s.size());
+}
+
+inline AsyncSendQueueConfig makeConfig(std::size_t capacity,
+                                       AsyncSendOverflowPolicy policy) {
+    AsyncSendQueueConfig ret;
+    ret.capacity = capacity;
+    ret.policy = policy;
+    return ret;
+}
+
+TEST(AsyncSendQueue, capacityRoundsUp) {
+    AsyncSendQueue queue(makeConfig(5, AsyncSendOverflowPolicy::DropOldest));
+    ASSERT_EQ(8u, queue.capacity());
+}
+
+TEST(AsyncSendQueue, fifo) {
+    AsyncSendQueue queue(makeConfig(4, AsyncSendOverflowPolicy::DropOldest));
+    Collector c;
+    ASSERT_EQ(0u, queue.drain(std::ref(c)));
+    ASSERT_TRUE(pushString(queue, typeA, "one"));
+    ASSERT_TRUE(pushString(queue, typeA, "two"));
+    ASSERT_TRUE(pushString(queue, typeB, "three"));
+    ASSERT_EQ(3u, queue.size());
+    ASSERT_EQ(3u, queue.drain(std::ref(c)));
+    ASSERT_EQ(0u, queue.size());
+    ASSERT_EQ(3u, c.received.size());
+    ASSERT_EQ("one", c.received[0].data);
+    ASSERT_EQ("two", c.received[1].data);
+    ASSERT_EQ("three", c.received[2].data);
+    ASSERT_EQ(typeB, c.received[2].type);
+
+    auto stats = queue.getStats();
+    ASSERT_EQ(3u, stats.enqueued);
+    ASSERT_EQ(3u, stats.sent);
+    ASSERT_EQ(0u, stats.dropped);
+    ASSERT_EQ(3u, stats.highWaterMark);
+}
+
+TEST(AsyncSendQueue, dropNewest) {
+    AsyncSendQueue queue(makeConfig(2, AsyncSendOverflowPolicy::DropNewest));
+    ASSERT_TRUE(pushString(queue, typeA, "1"));
+    ASSERT_TRUE(pushString(queue, typeA, "2"));
+    ASSERT_FALSE(pushString(queue, typeA, "3"));
+    Collector c;
+    ASSERT_EQ(2u, queue.drain(std::ref(c)));
+    ASSERT_EQ("1", c.received[0].data);
+    ASSERT_EQ("2", c.received[1].data);
+    ASSERT_EQ(1u, queue.getStats().dropped);
+}
+
+TEST(AsyncSendQueue, dropOldest) {
+    AsyncSendQueue queue(makeConfig(2, AsyncSendOverflowPolicy::DropOldest));
+    ASSERT_TRUE(pushString(queue, typeA, "1"));
+    ASSERT_TRUE(pushString(queue, typeA, "2"));
+    ASSERT_TRUE(pushString(queue, typeA, "3"));
+    ASSERT_EQ(2u, queue.size());
+    Collector c;
+    ASSERT_EQ(2u, queue.drain(std::ref(c)));
+    ASSERT_EQ("2", c.received[0].data);
+    ASSERT_EQ("3", c.received[1].data);
+    ASSERT_EQ(1u, queue.getStats().dropped);
+}
+
+TEST(AsyncSendQueue, coalesceNeverMergesRawMessages) {
+    AsyncSendQueue queue(makeConfig(8, AsyncSendOverflowPolicy::Coalesce));
+    ASSERT_TRUE(pushString(queue, typeA, "a1"));
+    ASSERT_TRUE(pushString(queue, typeA, "a2"));
+    ASSERT_TRUE(pushString(queue, typeB, "b1"));
+    ASSERT_TRUE(pushString(queue, typeA, "a3"));
+    Collector c;
+    ASSERT_EQ(4u, queue.drain(std::ref(c)));
+    ASSERT_EQ(4u, c.received.size());
+    ASSERT_EQ("a1", c.received[0].data);
+    ASSERT_EQ("a2", c.received[1].data);
+    ASSERT_EQ("b1", c.received[2].data);
+    ASSERT_EQ("a3", c.received[3].data);
+    auto stats = queue.getStats();
+    ASSERT_EQ(0u, stats.coalesced);
+    ASSERT_EQ(4u, stats.sent);
+}
+
+struct ReportCollector {
+    static void send(void *target, TimeValue const &, const char *report,
+                     std::size_t len) {
+        static_cast<ReportCollector *>(target)->received.push_back(
+            std::string(report, len));
+    }
+    std::vector<std::string> received;
+};
+
+inline bool pushReport(AsyncSendQueue &queue, ReportCollector &target,
+                       uint32_t key, std::string const &s) {
+    TimeValue tv = {0, 0};
+    return queue.pushReport(&ReportCollector::send, &target, key, tv,
+                            s.data(), s.size());
+}
+
+TEST(AsyncSendQueue, coalesceReportsPerSensor) {
+    AsyncSendQueue queue(makeConfig(16, AsyncSendOverflowPolicy::Coalesce));
+    ReportCollector reports;
+    ASSERT_TRUE(pushReport(queue, reports, 0, "s0-1"));
+    ASSERT_TRUE(pushReport(queue, reports, 1, "s1-1"));
+    ASSERT_TRUE(pushString(queue, typeA, "raw"));
+    ASSERT_TRUE(pushReport(queue, reports, 0, "s0-2"));
+    ASSERT_TRUE(pushReport(queue, reports, 1, "s1-2"));
+    ASSERT_TRUE(pushReport(queue, reports, NO_COALESCE_KEY, "batch-1"));
+    ASSERT_TRUE(pushReport(queue, reports, NO_COALESCE_KEY, "batch-2"));
+    Collector c;
+    ASSERT_EQ(5u, queue.drain(std::ref(c)));
+    ASSERT_EQ(1u, c.received.size());
+    ASSERT_EQ("raw", c.received[0].data);
+    ASSERT_EQ(4u, reports.received.size());
+    ASSERT_EQ("s0-2", reports.received[0]);
+    ASSERT_EQ("s1-2", reports.received[1]);
+    ASSERT_EQ("batch-1", reports.received[2]);
+    ASSERT_EQ("batch-2", reports.received[3]);
+    ASSERT_EQ(2u, queue.getStats().coalesced);
+}
+
+TEST(AsyncSendQueue, threadedAccounting) {
+    static const std::size_t NUM_MESSAGES = 100000;
+    AsyncSendQueue queue(makeConfig(16, AsyncSendOverflowPolicy::DropOldest));
+    uint32_t lastSeen = 0;
+    bool inOrder = true;
+    std::size_t received = 0;
+    auto check = [&](TimeValue const &, MessageType *, const char *buf,
+                     std::size_t len) {
+        uint32_t val;
+        ASSERT_EQ(sizeof(val), len);
+        std::memcpy(&val, buf, sizeof(val));
+        if (received > 0 && val <= lastSeen) {
+            inOrder = false;
+        }
+        lastSeen = val;
+        ++received;
+    };
+    std::atomic<bool> done(false);
+    boost::thread producer([&] {
+        TimeValue tv = {0, 0};
+        for (uint32_t i = 0; i < NUM_MESSAGES; ++i) {
+            queue.push(tv, typeA, reinterpret_cast<const char *>(&i),
+                       sizeof(i));
+        }
+        done = true;
+    });
+    while (!done) {
+        queue.drain(check);
+    }
+    producer.join();
+    queue.drain(check);
+
+    ASSERT_TRUE(inOrder) << "Messages should arrive in the order sent";
+    ASSERT_EQ(NUM_MESSAGES - 1, lastSeen) << "Newest message never dropped";
+    auto stats = queue.getStats();
+    ASSERT_EQ(NUM_MESSAGES, stats.enqueued);
+    ASSERT_EQ(received, stats.sent);
+    ASSERT_EQ(NUM_MESSAGES, stats.sent + stats.dropped);
+    ASSERT_EQ(0u, stats.depth);
+    ASSERT_LE(stats.highWaterMark, queue.capacity());
+}
@@ -0,0 +1,179 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/PluginHost/HostThreadSection.h>
+#include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
+#include <osvr/PluginHost/RegistrationContext.h>
+#include "../../../src/osvr/PluginHost/PluginSpecificRegistrationContextImpl.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using osvr::pluginhost::HostThreadSection;
+using osvr::pluginhost::PluginSpecificRegistrationContext;
+using osvr::pluginhost::RegistrationContext;
+
+namespace {
+/// Shared by the detect callbacks of all the dummy plugins in a test.
+struct DetectState {
+    std::chrono::milliseconds delay{0};
+    std::thread::id hostThread = std::this_thread::get_id();
+    std::atomic<int> calls{0};
+    std::atomic<int> callsOnHostThread{0};
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    /// Set by the host lock functions, if installed.
+    std::atomic<bool> hostLocked{false};
+    std::atomic<int> sectionsWithoutLock{0};
+    std::atomic<int> sectionsEntered{0};
+    bool useSection = false;
+};
+
+OSVR_ReturnCode detect(OSVR_PluginRegContext, void *userData) {
+    auto &state = *static_cast<DetectState *>(userData);
+    state.calls++;
+    if (std::this_thread::get_id() == state.hostThread) {
+        state.callsOnHostThread++;
+    }
+    auto now = ++state.running;
+    auto max = state.maxRunning.load();
+    while (now > max && !state.maxRunning.compare_exchange_weak(max, now)) {
+    }
+    // Stands in for enumerating hardware.
+    std::this_thread::sleep_for(state.delay);
+    if (state.useSection) {
+        HostThreadSection section;
+        state.sectionsEntered++;
+        if (!state.hostLocked) {
+            state.sectionsWithoutLock++;
+        }
+    }
+    state.running--;
+    return OSVR_RETURN_SUCCESS;
+}
+
+void addPlugins(RegistrationContext &ctx, DetectState &state, int count) {
+    for (int i = 0; i < count; ++i) {
+        auto plugin = PluginSpecificRegistrationContext::create(
+            "org_osvr_test_detect" + std::to_string(i));
+        // Through the base class, as a plugin would.
+        PluginSpecificRegistrationContext &pluginCtx = *plugin;
+        pluginCtx.registerHardwareDetectCallback(&detect, &state);
+        ctx.adoptPluginRegistrationContext(plugin);
+    }
+}
+} // namespace
+
+TEST(HardwareDetect, SynchronousTriggerRunsInCallingThread) {
+    DetectState state;
+    RegistrationContext ctx;
+    addPlugins(ctx, state, 3);
+    ctx.triggerHardwareDetect();
+    ASSERT_EQ(3, state.calls);
+    ASSERT_EQ(3, state.callsOnHostThread);
+}
+
+TEST(HardwareDetect, RequestRunsOffThreadWithoutBlocking) {
+    DetectState state;
+    state.delay = std::chrono::milliseconds(200);
+    RegistrationContext ctx;
+    addPlugins(ctx, state, 4);
+    auto begin = std::chrono::steady_clock::now();
+    ctx.requestHardwareDetect();
+    ASSERT_LT(std::chrono::steady_clock::now() - begin, state.delay)
+        << "Requesting detection should not wait for it";
+    ctx.waitForHardwareDetect();
+    ASSERT_EQ(4, state.calls);
+    ASSERT_EQ(0, state.callsOnHostThread);
+    if (std::thread::hardware_concurrency() > 1) {
+        ASSERT_GT(state.maxRunning, 1)
+            << "Plugins' callbacks should run concurrently";
+    }
+}
+
+TEST(HardwareDetect, RepeatedRequestsCoalesce) {
+    DetectState state;
+    state.delay = std::chrono::milliseconds(50);
+    RegistrationContext ctx;
+    addPlugins(ctx, state, 2);
+    for (int i = 0; i < 20; ++i) {
+        ctx.requestHardwareDetect();
+    }
+    ctx.waitForHardwareDetect();
+    // The first pass, plus at most one covering all requests made during it.
+    ASSERT_GE(state.calls, 2);
+    ASSERT_LE(state.calls, 4);
+}
+
+TEST(HardwareDetect, SectionsHoldHostLockOnWorkers) {
+    DetectState state;
+    state.useSection = true;
+    std::mutex hostMutex;
+    RegistrationContext ctx;
+    ctx.setHostLock(
+        [&] {
+            hostMutex.lock();
+            state.hostLocked = true;
+        },
+        [&] {
+            state.hostLocked = false;
+            hostMutex.unlock();
+        });
+    addPlugins(ctx, state, 3);
+    {
+        // Like the server holding its loop mutex: detection can start, but
+        // can't create devices until we let go.
+        std::unique_lock<std::mutex> lock(hostMutex);
+        ctx.requestHardwareDetect();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_EQ(0, state.sectionsEntered);
+    }
+    ctx.waitForHardwareDetect();
+    ASSERT_EQ(3, state.sectionsEntered);
+    ASSERT_EQ(0, state.sectionsWithoutLock);
+    ASSERT_FALSE(state.hostLocked);
+
+    // Outside of detection workers, sections don't touch the lock.
+    HostThreadSection section;
+    ASSERT_FALSE(state.hostLocked);
+}
+
+TEST(HardwareDetect, ShutdownIgnoresLaterRequests) {
+    DetectState state;
+    RegistrationContext ctx;
+    addPlugins(ctx, state, 2);
+    ctx.shutdownHardwareDetect();
+    ctx.requestHardwareDetect();
+    ctx.waitForHardwareDetect();
+    ASSERT_EQ(0, state.calls);
+}
@@ -0,0 +1,132 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/PluginHost/PluginManifest.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+
+// Standard includes
+#include <ctime>
+#include <fstream>
+#include <string>
+
+using osvr::pluginhost::PluginManifest;
+using osvr::pluginhost::FileList;
+using osvr::pluginhost::SearchPath;
+namespace fs = boost::filesystem;
+
+namespace {
+static const char EXT[] = ".testplugin";
+
+class PluginManifestTest : public ::testing::Test {
+  public:
+    PluginManifestTest()
+        : dir(fs::temp_directory_path() / fs::unique_path()),
+          pluginDir(dir / "plugins"), manifestFile(dir / "manifest.json") {
+        fs::create_directories(pluginDir);
+        searchPath.push_back(pluginDir.generic_string());
+    }
+    ~PluginManifestTest() {
+        boost::system::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    std::string addFile(std::string const &name,
+                        std::string const &contents = "plugin") {
+        auto path = pluginDir / name;
+        std::ofstream(path.string()) << contents;
+        return path.generic_string();
+    }
+
+    /// Makes the plugin directory look long unmodified, so its listing can
+    /// be trusted.
+    void settle() {
+        fs::last_write_time(pluginDir, std::time(nullptr) - 60);
+    }
+
+    fs::path dir;
+    fs::path pluginDir;
+    fs::path manifestFile;
+    SearchPath searchPath;
+};
+} // namespace
+
+TEST_F(PluginManifestTest, ListsSortedPluginFiles) {
+    auto b = addFile(std::string("b") + EXT);
+    auto a = addFile(std::string("a") + EXT);
+    addFile("readme.txt");
+    PluginManifest manifest("", EXT);
+    FileList files = manifest.getPluginFiles(searchPath);
+    ASSERT_EQ(2u, files.size());
+    ASSERT_EQ(a, files[0]);
+    ASSERT_EQ(b, files[1]);
+    ASSERT_EQ(1u, manifest.getDirectoriesScanned());
+}
+
+TEST_F(PluginManifestTest, ReusesSettledListing) {
+    addFile(std::string("a") + EXT);
+    settle();
+    {
+        PluginManifest manifest(manifestFile.string(), EXT);
+        ASSERT_EQ(1u, manifest.getPluginFiles(searchPath).size());
+        ASSERT_TRUE(manifest.save());
+    }
+    PluginManifest manifest(manifestFile.string(), EXT);
+    ASSERT_EQ(1u, manifest.getPluginFiles(searchPath).size());
+    ASSERT_EQ(1u, manifest.getDirectoriesCached());
+    ASSERT_EQ(0u, manifest.getDirectoriesScanned());
+}
+
+TEST_F(PluginManifestTest, RescansChangedDirectory) {
+    addFile(std::string("a") + EXT);
+    settle();
+    {
+        PluginManifest manifest(manifestFile.string(), EXT);
+        manifest.getPluginFiles(searchPath);
+        ASSERT_TRUE(manifest.save());
+    }
+    addFile(std::string("b") + EXT);
+    PluginManifest manifest(manifestFile.string(), EXT);
+    ASSERT_EQ(2u, manifest.getPluginFiles(searchPath).size());
+    ASSERT_EQ(1u, manifest.getDirectoriesScanned());
+}
+
+TEST_F(PluginManifestTest, FindsPluginByName) {
+    auto plain = addFile(std::string("org_osvr_plain") + EXT);
+    PluginManifest manifest("", EXT);
+    ASSERT_EQ(plain, manifest.findPlugin(searchPath, "org_osvr_plain"));
+    ASSERT_TRUE(manifest.findPlugin(searchPath, "org_osvr_none").empty());
+}
+
+TEST_F(PluginManifestTest, IgnoresCorruptManifest) {
+    std::ofstream(manifestFile.string()) << "{ not json";
+    addFile(std::string("a") + EXT);
+    PluginManifest manifest(manifestFile.string(), EXT);
+    ASSERT_EQ(1u, manifest.getPluginFiles(searchPath).size());
+    ASSERT_TRUE(manifest.save());
+}
@@ -0,0 +1,129 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Util/LogMessageQueue.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::util::log::LogMessageQueue;
+using osvr::util::log::QueuedLogMessage;
+
+inline bool pushString(LogMessageQueue &queue, std::string const &s) {
+    return queue.tryPush(
+        [&](QueuedLogMessage &msg) { msg.formatted.assign(s); });
+}
+
+inline bool popString(LogMessageQueue &queue, std::string &s) {
+    return queue.tryPop([&](QueuedLogMessage &msg) { s = msg.formatted; });
+}
+
+TEST(LogMessageQueue, capacityRoundsUp) {
+    LogMessageQueue queue(5);
+    ASSERT_EQ(8u, queue.capacity());
+}
+
+TEST(LogMessageQueue, fifo) {
+    LogMessageQueue queue(4);
+    std::string s;
+    ASSERT_FALSE(popString(queue, s));
+    ASSERT_TRUE(pushString(queue, "one"));
+    ASSERT_TRUE(pushString(queue, "two"));
+    ASSERT_EQ(2u, queue.size());
+    ASSERT_TRUE(popString(queue, s));
+    ASSERT_EQ("one", s);
+    ASSERT_TRUE(popString(queue, s));
+    ASSERT_EQ("two", s);
+    ASSERT_FALSE(popString(queue, s));
+    ASSERT_EQ(2u, queue.enqueued());
+    ASSERT_EQ(2u, queue.highWaterMark());
+}
+
+TEST(LogMessageQueue, dropsNewestWhenFull) {
+    LogMessageQueue queue(2);
+    ASSERT_TRUE(pushString(queue, "1"));
+    ASSERT_TRUE(pushString(queue, "2"));
+    ASSERT_FALSE(pushString(queue, "3"));
+    ASSERT_EQ(1u, queue.dropped());
+    std::string s;
+    ASSERT_TRUE(popString(queue, s));
+    ASSERT_EQ("1", s);
+    ASSERT_TRUE(pushString(queue, "4"));
+    ASSERT_TRUE(popString(queue, s));
+    ASSERT_EQ("2", s);
+    ASSERT_TRUE(popString(queue, s));
+    ASSERT_EQ("4", s);
+}
+
+TEST(LogMessageQueue, threadedAccounting) {
+    static const std::size_t NUM_THREADS = 4;
+    static const std::size_t MESSAGES_PER_THREAD = 50000;
+    LogMessageQueue queue(64);
+    std::atomic<std::size_t> producersDone(0);
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < NUM_THREADS; ++t) {
+        producers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < MESSAGES_PER_THREAD; ++i) {
+                queue.tryPush([&](QueuedLogMessage &msg) {
+                    msg.threadId = t;
+                    msg.level = static_cast<int>(i);
+                });
+            }
+            ++producersDone;
+        });
+    }
+    std::vector<int> lastSeen(NUM_THREADS, -1);
+    bool inOrder = true;
+    std::size_t received = 0;
+    auto check = [&](QueuedLogMessage &msg) {
+        if (msg.level <= lastSeen[msg.threadId]) {
+            inOrder = false;
+        }
+        lastSeen[msg.threadId] = msg.level;
+        ++received;
+    };
+    while (producersDone < NUM_THREADS) {
+        queue.tryPop(check);
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    while (queue.tryPop(check)) {
+    }
+
+    ASSERT_TRUE(inOrder) << "Each thread's messages should stay in order";
+    ASSERT_EQ(received, queue.enqueued());
+    ASSERT_EQ(NUM_THREADS * MESSAGES_PER_THREAD,
+              queue.enqueued() + queue.dropped());
+    ASSERT_EQ(0u, queue.size());
+    ASSERT_LE(queue.highWaterMark(), queue.capacity());
+}
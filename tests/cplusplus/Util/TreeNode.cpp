@@ -314,3 +314,47 @@ TEST(TreeNode, ParentPointers) {
     ParentCheckerVisitor visitor;
     visitor(*tree);
 }
+
+TEST(TreeNode, ManyChildren) {
+    // Enough children that lookups go through the hash index.
+    static const int NUM_CHILDREN = 100;
+    IntTreePtr tree(IntTree::createRoot());
+    for (int i = 0; i < NUM_CHILDREN; ++i) {
+        IntTree::create(*tree, std::to_string(i), i);
+    }
+    ASSERT_EQ(tree->numChildren(), NUM_CHILDREN);
+    ASSERT_THROW((IntTree::create(*tree, "42")), std::logic_error)
+        << "Can't create a duplicate-named child";
+    for (int i = 0; i < NUM_CHILDREN; ++i) {
+        IntTree const &constTree = *tree;
+        ASSERT_EQ(constTree.getChildByName(std::to_string(i)).value(), i);
+    }
+    ASSERT_THROW(static_cast<IntTree const &>(*tree).getChildByName("100"),
+                 osvr::util::tree::NoSuchChild);
+    tree->getOrCreateChildByName("new").value() = -1;
+    ASSERT_EQ(tree->numChildren(), NUM_CHILDREN + 1);
+    ASSERT_EQ(tree->getOrCreateChildByName("new").value(), -1);
+    ASSERT_EQ(tree->numChildren(), NUM_CHILDREN + 1);
+}
+
+TEST(TreeNode, RemoveChildByName) {
+    for (int numChildren : {3, 20}) {
+        // Small and large enough to go through the hash index.
+        IntTreePtr tree(IntTree::createRoot());
+        for (int i = 0; i < numChildren; ++i) {
+            IntTree::create(*tree, std::to_string(i), i);
+        }
+        IntTree::create(tree->getOrCreateChildByName("1"), "grandchild", 100);
+        ASSERT_TRUE(tree->removeChildByName("1"));
+        ASSERT_FALSE(tree->removeChildByName("1"));
+        ASSERT_FALSE(tree->removeChildByName("missing"));
+        ASSERT_EQ(tree->numChildren(), numChildren - 1);
+        IntTree const &constTree = *tree;
+        ASSERT_THROW(constTree.getChildByName("1"),
+                     osvr::util::tree::NoSuchChild);
+        ASSERT_EQ(constTree.getChildByName("2").value(), 2);
+        ASSERT_EQ(tree->getOrCreateChildByName("1").value(), 0)
+            << "Recreated child should be fresh";
+        ASSERT_EQ(tree->getOrCreateChildByName("1").numChildren(), 0);
+    }
+}